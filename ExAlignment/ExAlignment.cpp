@@ -0,0 +1,321 @@
+/*
+ * File: ExAlignment.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 13:20 2026
+ *
+ * Fast pairwise alignment.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <chrono> /* for timings below the second. */
+#include <random> /* to simulate long sequences. */
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/SiteContainerTools.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+#include <Bpp/Seq/AlphabetIndex/DefaultNucleotideScore.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * And the alignment tools, in this directory:
+ */
+#include "GlobalAlignmentTools.h"
+#include "Instrumentation.h" /* from ExBenchmark */
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * Alignments are read from an aligned file, so we need to remove the gaps first:
+ */
+Sequence* ungap(const Sequence& seq)
+{
+  vector<int> content;
+  for (size_t i = 0; i < seq.size(); i++)
+    if (!seq.getAlphabet()->isGap(seq[i]))
+      content.push_back(seq[i]);
+  return new BasicSequence(seq.getName(), content, seq.getAlphabet());
+}
+
+/*
+ * To compare the alignment modes on long sequences, we simulate a sequence and a mutated copy of it,
+ * with 5% substitutions and 1% insertions or deletions:
+ */
+void simulate(size_t length, vector<int>& seq1, vector<int>& seq2)
+{
+  mt19937 rng(42);
+  uniform_int_distribution<int> nucleotide(0, 3);
+  uniform_real_distribution<double> event(0., 1.);
+  seq1.resize(length);
+  for (size_t i = 0; i < length; i++)
+    seq1[i] = nucleotide(rng);
+  seq2.clear();
+  for (size_t i = 0; i < length; i++)
+  {
+    double e = event(rng);
+    if (e < 0.05)
+      seq2.push_back(nucleotide(rng));
+    else if (e < 0.055)
+      continue;
+    else if (e < 0.06)
+    {
+      seq2.push_back(seq1[i]);
+      seq2.push_back(nucleotide(rng));
+    }
+    else
+      seq2.push_back(seq1[i]);
+  }
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * We start with the example from ExContainer:
+     */
+    BasicSequence seq1("Sequence 1", "GATTACTGATTACATGGT", &AlphabetTools::DNA_ALPHABET);
+    BasicSequence seq2("Sequence 2", "GATCACAATGTTACGCT", &AlphabetTools::DNA_ALPHABET);
+    DefaultNucleotideScore scores(&AlphabetTools::DNA_ALPHABET);
+
+    SiteContainer* alignedSeq = SiteContainerTools::alignNW(seq1, seq2, scores, -5);
+    cout << alignedSeq->getSequence(0).toString() << endl;
+    cout << alignedSeq->getSequence(1).toString() << endl;
+    cout << "Score: " << GlobalAlignmentTools::getAlignmentScore(alignedSeq->getSequence(0), alignedSeq->getSequence(1), scores, -5) << endl;
+
+    /*
+     * GlobalAlignmentTools::alignNW takes the same arguments, and returns the same kind of object.
+     * When several alignments have the same score, the two methods may return different ones,
+     * but the score is always the same:
+     */
+    SiteContainer* fastAlignedSeq = GlobalAlignmentTools::alignNW(seq1, seq2, scores, -5);
+    cout << fastAlignedSeq->getSequence(0).toString() << endl;
+    cout << fastAlignedSeq->getSequence(1).toString() << endl;
+    cout << "Score: " << GlobalAlignmentTools::getAlignmentScore(fastAlignedSeq->getSequence(0), fastAlignedSeq->getSequence(1), scores, -5) << endl;
+    delete alignedSeq;
+    delete fastAlignedSeq;
+
+    /*
+     * Internally, the scores are first copied into an integer matrix, a ScoringProfile.
+     * When many alignments are computed, the profile should be created only once:
+     */
+    ScoringProfile profile(scores);
+    cout << "The profile has " << profile.getNumberOfStates() << " states. Score of A/G: " << profile.getScore(0, 2) << endl;
+
+    /*
+     * The dynamic programming matrix is then filled using vector instructions,
+     * if the processor supports them:
+     */
+    cout << "Best instruction set available: " << SimdSupport::getName(SimdSupport::getBestLevel()) << endl;
+
+    /*
+     * Let's now check on real data that we always get the same score, and compare the speed.
+     * We align the first sequence from the ExContainer alignment with a few others:
+     */
+    Fasta fasReader;
+    OrderedSequenceContainer* alignment = fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    VectorSequenceContainer sequences(&AlphabetTools::DNA_ALPHABET);
+    for (size_t i = 0; i < alignment->getNumberOfSequences(); i++)
+    {
+      Sequence* seq = ungap(alignment->getSequence(i));
+      sequences.addSequence(*seq, false);
+      delete seq;
+    }
+    delete alignment;
+
+    unsigned int npairs = 20; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
+    vector<double> reference(npairs);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (unsigned int k = 0; k < npairs; k++)
+    {
+      SiteContainer* aln = SiteContainerTools::alignNW(sequences.getSequence(0), sequences.getSequence(k + 1), scores, -5);
+      reference[k] = GlobalAlignmentTools::getAlignmentScore(aln->getSequence(0), aln->getSequence(1), scores, -5);
+      delete aln;
+    }
+    double referenceTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ApplicationTools::displayResult("SiteContainerTools::alignNW", TextTools::toString(referenceTime * 1000., 4) + " ms");
+
+    for (int level = SIMD_SCALAR; level <= SimdSupport::getBestLevel(); level++)
+    {
+      bool identical = true;
+      start = chrono::steady_clock::now();
+      for (unsigned int k = 0; k < npairs; k++)
+      {
+        SiteContainer* aln = GlobalAlignmentTools::alignNW(sequences.getSequence(0), sequences.getSequence(k + 1), profile, -5, static_cast<SimdLevel>(level));
+        double score = GlobalAlignmentTools::getAlignmentScore(aln->getSequence(0), aln->getSequence(1), scores, -5);
+        identical = identical && (score == reference[k]);
+        delete aln;
+      }
+      double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      ApplicationTools::displayResult("GlobalAlignmentTools::alignNW (" + SimdSupport::getName(static_cast<SimdLevel>(level)) + ")",
+          TextTools::toString(t * 1000., 4) + " ms, speedup x" + TextTools::toString(referenceTime / t, 3) + ", same scores: " + (identical ? "yes" : "no"));
+    }
+
+    /*
+     * If only the score is needed, getNWScore is even faster, as there is no traceback:
+     */
+    for (int level = SIMD_SCALAR; level <= SimdSupport::getBestLevel(); level++)
+    {
+      bool identical = true;
+      start = chrono::steady_clock::now();
+      for (unsigned int k = 0; k < npairs; k++)
+      {
+        int score = GlobalAlignmentTools::getNWScore(sequences.getSequence(0), sequences.getSequence(k + 1), profile, -5, static_cast<SimdLevel>(level));
+        identical = identical && (score == reference[k]);
+      }
+      double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      ApplicationTools::displayResult("GlobalAlignmentTools::getNWScore (" + SimdSupport::getName(static_cast<SimdLevel>(level)) + ")",
+          TextTools::toString(t * 1000., 4) + " ms, speedup x" + TextTools::toString(referenceTime / t, 3) + ", same scores: " + (identical ? "yes" : "no"));
+    }
+
+    /*
+     * A linear gap penalty is not very realistic: a single long gap is more likely than several short ones.
+     * With affine gap penalties, the first position of a gap is scored 'opening',
+     * and each following one 'extending':
+     */
+    SiteContainer* affineSeq = GlobalAlignmentTools::alignNW(seq1, seq2, scores, -10, -1);
+    cout << affineSeq->getSequence(0).toString() << endl;
+    cout << affineSeq->getSequence(1).toString() << endl;
+    cout << "Score: " << GlobalAlignmentTools::getAlignmentScore(affineSeq->getSequence(0), affineSeq->getSequence(1), scores, -10, -1) << endl;
+    delete affineSeq;
+
+    /*
+     * Affine gaps need more computations per cell, but the same vector instructions are used.
+     * With opening = extending, we get the same scores as with a linear penalty:
+     */
+    for (int level = SIMD_SCALAR; level <= SimdSupport::getBestLevel(); level++)
+    {
+      bool identical = true;
+      start = chrono::steady_clock::now();
+      for (unsigned int k = 0; k < npairs; k++)
+        identical = identical && (GlobalAlignmentTools::getNWScore(sequences.getSequence(0), sequences.getSequence(k + 1), profile, -5, static_cast<SimdLevel>(level)) == reference[k]);
+      double linearTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      start = chrono::steady_clock::now();
+      for (unsigned int k = 0; k < npairs; k++)
+        identical = identical && (GlobalAlignmentTools::getNWScore(sequences.getSequence(0), sequences.getSequence(k + 1), profile, -5, -5, static_cast<SimdLevel>(level)) == reference[k]);
+      double affineTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      ApplicationTools::displayResult("Affine getNWScore (" + SimdSupport::getName(static_cast<SimdLevel>(level)) + ")",
+          TextTools::toString(affineTime * 1000., 4) + " ms, x" + TextTools::toString(affineTime / linearTime, 3) + " linear time, same scores: " + (identical ? "yes" : "no"));
+    }
+    for (int level = SIMD_SCALAR; level <= SimdSupport::getBestLevel(); level++)
+    {
+      start = chrono::steady_clock::now();
+      for (unsigned int k = 0; k < npairs; k++)
+      {
+        SiteContainer* aln = GlobalAlignmentTools::alignNW(sequences.getSequence(0), sequences.getSequence(k + 1), profile, -5, static_cast<SimdLevel>(level));
+        delete aln;
+      }
+      double linearTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      start = chrono::steady_clock::now();
+      for (unsigned int k = 0; k < npairs; k++)
+      {
+        SiteContainer* aln = GlobalAlignmentTools::alignNW(sequences.getSequence(0), sequences.getSequence(k + 1), profile, -10, -1, static_cast<SimdLevel>(level));
+        delete aln;
+      }
+      double affineTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      ApplicationTools::displayResult("Affine alignNW (" + SimdSupport::getName(static_cast<SimdLevel>(level)) + ")",
+          TextTools::toString(affineTime * 1000., 4) + " ms, x" + TextTools::toString(affineTime / linearTime, 3) + " linear time");
+    }
+
+    /*
+     * The traceback matrix takes one byte per pair of positions, so that aligning two 100 kb sequences
+     * would need 10 GB. Two other strategies are available with the same alignNW call,
+     * by adding an AlignmentMode argument:
+     * - ALIGNMENT_LINEAR_MEMORY uses Hirschberg's algorithm, with memory linear in the sequence lengths,
+     * - ALIGNMENT_BANDED only computes cells close to the diagonal, which is enough for similar sequences.
+     */
+    SiteContainer* bandedSeq = GlobalAlignmentTools::alignNW(sequences.getSequence(0), sequences.getSequence(1), profile, -5, ALIGNMENT_BANDED);
+    double bandedScore = GlobalAlignmentTools::getAlignmentScore(bandedSeq->getSequence(0), bandedSeq->getSequence(1), scores, -5);
+    ApplicationTools::displayResult("Banded alignment of the first two sequences, same score", bandedScore == reference[0] ? "yes" : "no");
+    delete bandedSeq;
+
+    /*
+     * The low-level methods work on encoded sequences, and tell how much memory was used through the workspace.
+     * Let's compare the three modes on simulated sequences of increasing lengths:
+     */
+    size_t lengths[] = { 1000, 5000, 20000 }; /* WATCHOUT!!! the full matrix for the last length takes 400 MB! */
+    AlignmentMode modes[] = { ALIGNMENT_FULL, ALIGNMENT_LINEAR_MEMORY, ALIGNMENT_BANDED };
+    string modeNames[] = { "full", "linear memory", "banded" };
+    for (size_t l = 0; l < 3; l++)
+    {
+      vector<int> a, b, r1, r2;
+      simulate(lengths[l], a, b);
+      int fullScore = 0;
+      for (size_t k = 0; k < 3; k++)
+      {
+        AlignmentWorkspace workspace;
+        start = chrono::steady_clock::now();
+        int score = GlobalAlignmentTools::alignNW(a, b, profile, -5, AlphabetTools::DNA_ALPHABET.getGapCharacterCode(),
+            modes[k], 0, SimdSupport::getBestLevel(), workspace, r1, r2);
+        double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (k == 0)
+          fullScore = score;
+        ApplicationTools::displayResult(TextTools::toString(lengths[l]) + " bp, " + modeNames[k],
+            TextTools::toString(t * 1000., 4) + " ms, " + TextTools::toString(static_cast<double>(workspace.getMemoryUsage()) / 1048576., 3)
+            + " MB, same score: " + (score == fullScore ? "yes" : "no"));
+      }
+    }
+
+    /*
+     * All alignments of this example can be summed up: if it was built with 'make INSTRUMENTATION=1',
+     * the report gives the number of matrix cells computed, the total time and the memory allocated.
+     */
+    Instrumentation::display();
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
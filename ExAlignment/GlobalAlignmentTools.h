@@ -0,0 +1,1035 @@
+/*
+ * File: GlobalAlignmentTools.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 13:20 2026
+ *
+ * Vectorized global (Needleman-Wunsch) pairwise alignment.
+ */
+
+#ifndef _GLOBALALIGNMENTTOOLS_H_
+#define _GLOBALALIGNMENTTOOLS_H_
+
+#include "ScoringProfile.h"
+#include "SimdSupport.h"
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/SequenceExceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/AlphabetIndex/AlphabetIndex2.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief The dynamic programming strategies available for global alignments.
+   *
+   * - ALIGNMENT_FULL: the whole traceback matrix is kept, that is one byte per pair of positions.
+   * - ALIGNMENT_LINEAR_MEMORY: Hirschberg's divide and conquer algorithm. Memory is linear in the
+   *   length of the sequences, but about twice as many cells are computed.
+   * - ALIGNMENT_BANDED: only cells close to the main diagonal are computed. This is much faster
+   *   for similar sequences, and returns an optimal alignment when the band width is estimated
+   *   automatically.
+   */
+  enum AlignmentMode { ALIGNMENT_FULL, ALIGNMENT_LINEAR_MEMORY, ALIGNMENT_BANDED };
+
+  /**
+   * @brief Buffers used by the alignment algorithms.
+   *
+   * A workspace can be reused for successive alignments, so that memory is only allocated
+   * when a larger alignment than all previous ones is computed. A workspace must not be
+   * used by two threads at the same time.
+   */
+  class AlignmentWorkspace
+  {
+  public:
+    std::vector<int> matrix;
+    std::vector<int> rowIndex;
+    std::vector<int> reversed;
+    std::vector<int> h0, h1, h2;
+    std::vector<uint8_t> dirs;
+    std::vector<size_t> bases;
+    std::vector<int> forward, backward;
+    std::vector<int> reversedA, reversedB;
+    std::vector<int> e0, e1, f0, f1;
+
+  public:
+    AlignmentWorkspace() :
+      matrix(), rowIndex(), reversed(), h0(), h1(), h2(), dirs(), bases(),
+      forward(), backward(), reversedA(), reversedB(), e0(), e1(), f0(), f1()
+    {}
+
+  public:
+    /**
+     * @return The number of bytes currently allocated by the workspace.
+     */
+    size_t getMemoryUsage() const
+    {
+      return (matrix.capacity() + rowIndex.capacity() + reversed.capacity() + h0.capacity() + h1.capacity() + h2.capacity()
+          + forward.capacity() + backward.capacity() + reversedA.capacity() + reversedB.capacity()
+          + e0.capacity() + e1.capacity() + f0.capacity() + f1.capacity()) * sizeof(int)
+          + dirs.capacity() + bases.capacity() * sizeof(size_t);
+    }
+  };
+
+  /**
+   * @brief Global pairwise alignment with a linear gap penalty, vectorized along anti-diagonals.
+   *
+   * This computes the same alignment score as SiteContainerTools::alignNW, but:
+   * - substitution scores are read from a ScoringProfile (a flat integer matrix) instead of
+   *   virtual calls to an AlphabetIndex2,
+   * - the dynamic programming matrix is filled one anti-diagonal at a time: all cells of an
+   *   anti-diagonal are independent, so that they are computed 8 (AVX2) or 4 (SSE4.1) at a time,
+   * - only three anti-diagonals of scores are kept in memory, plus one byte per cell for the
+   *   traceback. Score-only computations use memory linear in the sequence lengths.
+   *
+   * For long sequences, alignments can also be computed in linear memory, or restricted to a band
+   * around the main diagonal (see AlignmentMode).
+   *
+   * Affine gap penalties are supported with Gotoh's algorithm, vectorized in the same way: a gap of
+   * length k scores opening + (k - 1) * extending. Two more anti-diagonals are kept for the scores of
+   * alignments ending with a gap, and the traceback byte also records whether gaps are extended.
+   *
+   * The instruction set is detected at runtime (see SimdSupport), and can also be forced.
+   * When several alignments have the same optimal score, ties are broken in the order
+   * match/mismatch, gap in the second sequence, gap in the first sequence.
+   */
+  class GlobalAlignmentTools
+  {
+  private:
+    enum Direction { DIAGONAL = 0, UP = 1, LEFT = 2 };
+    //In affine mode, the traceback byte also tells whether a gap in the first (E) or second (F) sequence is extended:
+    enum { DIRECTION_MASK = 3, E_EXTENDED = 4, F_EXTENDED = 8 };
+    //Sub-problems of Hirschberg's algorithm smaller than this are aligned with a full matrix (1 MB):
+    enum { HIRSCHBERG_LEAF_CELLS = 1 << 20 };
+    //Initial band width, when it is estimated:
+    enum { DEFAULT_BAND_WIDTH = 32 };
+
+  public:
+    /**
+     * @brief Align two sequences.
+     *
+     * @param seq1    The first sequence.
+     * @param seq2    The second sequence.
+     * @param profile The substitution scores.
+     * @param gap     The (usually negative) score of a gap position.
+     * @param level   The instruction set to use. The best available one is used by default.
+     * @return A new alignment of the two sequences.
+     * @throw AlphabetMismatchException If the sequences and profile do not share the same alphabet.
+     * @throw BadIntException If a sequence contains states not supported by the profile, for instance gaps.
+     */
+    static AlignedSequenceContainer* alignNW(
+        const Sequence& seq1,
+        const Sequence& seq2,
+        const ScoringProfile& profile,
+        int gap,
+        SimdLevel level = SimdSupport::getBestLevel())
+    {
+      return alignNW(seq1, seq2, profile, gap, ALIGNMENT_FULL, 0, level);
+    }
+
+    /**
+     * @brief Align two sequences, with a given strategy.
+     *
+     * @param seq1      The first sequence.
+     * @param seq2      The second sequence.
+     * @param profile   The substitution scores.
+     * @param gap       The (usually negative) score of a gap position.
+     * @param mode      The dynamic programming strategy, see AlignmentMode.
+     * @param bandWidth In banded mode, the number of diagonals kept on each side of the band
+     *                  joining the two corners of the matrix. 0 means that the width is
+     *                  estimated, and increased until the alignment is proven optimal.
+     *                  With a given width, the alignment is the best one within the band only.
+     * @param level     The instruction set to use. The best available one is used by default.
+     * @return A new alignment of the two sequences.
+     * @throw AlphabetMismatchException If the sequences and profile do not share the same alphabet.
+     * @throw BadIntException If a sequence contains states not supported by the profile, for instance gaps.
+     */
+    static AlignedSequenceContainer* alignNW(
+        const Sequence& seq1,
+        const Sequence& seq2,
+        const ScoringProfile& profile,
+        int gap,
+        AlignmentMode mode,
+        size_t bandWidth = 0,
+        SimdLevel level = SimdSupport::getBestLevel())
+    {
+      std::vector<int> a, b;
+      encode_(seq1, seq2, profile, a, b);
+      AlignmentWorkspace workspace;
+      std::vector<int> r1, r2;
+      alignNW(a, b, profile, gap, seq1.getAlphabet()->getGapCharacterCode(), mode, bandWidth, level, workspace, r1, r2);
+      const Alphabet* alphabet = seq1.getAlphabet();
+      AlignedSequenceContainer* asc = new AlignedSequenceContainer(alphabet);
+      asc->addSequence(BasicSequence(seq1.getName(), r1, alphabet), false);
+      asc->addSequence(BasicSequence(seq2.getName(), r2, alphabet), false);
+      return asc;
+    }
+
+    /**
+     * @brief Align two sequences, with the same arguments as SiteContainerTools::alignNW.
+     *
+     * The scoring index is converted to a ScoringProfile: its scores and the gap penalty must be integers.
+     * When aligning many sequences, build the profile once and use the other alignNW methods.
+     */
+    static AlignedSequenceContainer* alignNW(const Sequence& seq1, const Sequence& seq2, const AlphabetIndex2& s, double gap,
+        AlignmentMode mode = ALIGNMENT_FULL, size_t bandWidth = 0)
+    {
+      ScoringProfile profile(s);
+      return alignNW(seq1, seq2, profile, toIntegerGap_(gap), mode, bandWidth);
+    }
+
+    /**
+     * @brief Align two sequences with affine gap penalties.
+     *
+     * @param seq1      The first sequence.
+     * @param seq2      The second sequence.
+     * @param profile   The substitution scores.
+     * @param opening   The score of the first position of a gap.
+     * @param extending The score of each other position of a gap. It should not be lower than opening,
+     *                  otherwise two adjacent gaps could score better than a single longer one.
+     * @param level     The instruction set to use. The best available one is used by default.
+     * @return A new alignment of the two sequences.
+     * @throw AlphabetMismatchException If the sequences and profile do not share the same alphabet.
+     * @throw BadIntException If a sequence contains states not supported by the profile, for instance gaps.
+     */
+    static AlignedSequenceContainer* alignNW(
+        const Sequence& seq1,
+        const Sequence& seq2,
+        const ScoringProfile& profile,
+        int opening,
+        int extending,
+        SimdLevel level = SimdSupport::getBestLevel())
+    {
+      std::vector<int> a, b;
+      encode_(seq1, seq2, profile, a, b);
+      AlignmentWorkspace workspace;
+      std::vector<int> r1, r2;
+      alignNW(a, b, profile, opening, extending, seq1.getAlphabet()->getGapCharacterCode(), level, workspace, r1, r2);
+      const Alphabet* alphabet = seq1.getAlphabet();
+      AlignedSequenceContainer* asc = new AlignedSequenceContainer(alphabet);
+      asc->addSequence(BasicSequence(seq1.getName(), r1, alphabet), false);
+      asc->addSequence(BasicSequence(seq2.getName(), r2, alphabet), false);
+      return asc;
+    }
+
+    /**
+     * @brief Align two sequences with affine gap penalties, with the same arguments as SiteContainerTools::alignNW.
+     *
+     * The scoring index is converted to a ScoringProfile: its scores and the gap penalties must be integers.
+     */
+    static AlignedSequenceContainer* alignNW(const Sequence& seq1, const Sequence& seq2, const AlphabetIndex2& s, double opening, double extending)
+    {
+      ScoringProfile profile(s);
+      return alignNW(seq1, seq2, profile, toIntegerGap_(opening), toIntegerGap_(extending));
+    }
+
+    /**
+     * @brief Compute the score of the optimal alignment only, in linear memory.
+     *
+     * @see alignNW for the arguments.
+     * @return The score of the optimal global alignment, in profile units.
+     */
+    static int getNWScore(
+        const Sequence& seq1,
+        const Sequence& seq2,
+        const ScoringProfile& profile,
+        int gap,
+        SimdLevel level = SimdSupport::getBestLevel())
+    {
+      std::vector<int> a, b;
+      encode_(seq1, seq2, profile, a, b);
+      AlignmentWorkspace workspace;
+      return getNWScore(a, b, profile, gap, level, workspace);
+    }
+
+    /**
+     * @brief Compute the score of the optimal alignment with affine gap penalties only, in linear memory.
+     *
+     * @see alignNW for the arguments.
+     * @return The score of the optimal global alignment, in profile units.
+     */
+    static int getNWScore(
+        const Sequence& seq1,
+        const Sequence& seq2,
+        const ScoringProfile& profile,
+        int opening,
+        int extending,
+        SimdLevel level = SimdSupport::getBestLevel())
+    {
+      std::vector<int> a, b;
+      encode_(seq1, seq2, profile, a, b);
+      AlignmentWorkspace workspace;
+      return getNWScore(a, b, profile, opening, extending, level, workspace);
+    }
+
+    /**
+     * @name Low-level methods, working on encoded sequences.
+     *
+     * Sequences are given as vectors of states supported by the profile (see ScoringProfile::encode),
+     * and buffers are taken from a workspace, so that no memory is allocated when aligning many sequences.
+     *
+     * @{
+     */
+
+    /**
+     * @brief Align two encoded sequences.
+     *
+     * @param a         The first sequence.
+     * @param b         The second sequence.
+     * @param profile   The substitution scores.
+     * @param gap       The score of a gap position.
+     * @param gapCode   The code of the gap state, used in the output.
+     * @param level     The instruction set to use.
+     * @param workspace The buffers to use.
+     * @param r1        [out] The first aligned sequence.
+     * @param r2        [out] The second aligned sequence.
+     * @return The alignment score.
+     */
+    static int alignNW(const std::vector<int>& a, const std::vector<int>& b, const ScoringProfile& profile, int gap,
+        int gapCode, SimdLevel level, AlignmentWorkspace& workspace, std::vector<int>& r1, std::vector<int>& r2)
+    {
+      return alignNW(a, b, profile, gap, gapCode, ALIGNMENT_FULL, 0, level, workspace, r1, r2);
+    }
+
+    /**
+     * @brief Align two encoded sequences, with a given strategy.
+     *
+     * @see The method above, and the method on sequences for the mode and band width.
+     */
+    static int alignNW(const std::vector<int>& a, const std::vector<int>& b, const ScoringProfile& profile, int gap,
+        int gapCode, AlignmentMode mode, size_t bandWidth, SimdLevel level, AlignmentWorkspace& workspace,
+        std::vector<int>& r1, std::vector<int>& r2)
+    {
+      //Cells are counted by fill_, as their number depends on the mode:
+      BPP_INSTRUMENT_SCOPE(ALIGN);
+      r1.clear();
+      r2.clear();
+      r1.reserve(a.size() + b.size());
+      r2.reserve(a.size() + b.size());
+      if (mode == ALIGNMENT_LINEAR_MEMORY)
+      {
+        workspace.reversedA.assign(a.rbegin(), a.rend());
+        workspace.reversedB.assign(b.rbegin(), b.rend());
+        return hirschberg_(a.data(), a.size(), b.data(), b.size(), workspace.reversedA.data(), workspace.reversedB.data(),
+            profile, gap, gapCode, SimdSupport::getSupportedLevel(level), workspace, r1, r2);
+      }
+      if (mode == ALIGNMENT_BANDED)
+        return banded_(a.data(), a.size(), b.data(), b.size(), profile, gap, gapCode, bandWidth, level, workspace, r1, r2);
+      long n = static_cast<long>(a.size()), m = static_cast<long>(b.size());
+      int score = fill_(a.data(), a.size(), b.data(), b.size(), profile, gap, level, true, workspace, -n, m);
+      traceback_(a.data(), a.size(), b.data(), b.size(), gapCode, m, workspace, r1, r2);
+      return score;
+    }
+
+    /**
+     * @brief Compute the score of the optimal alignment of two encoded sequences, in linear memory.
+     */
+    static int getNWScore(const std::vector<int>& a, const std::vector<int>& b, const ScoringProfile& profile, int gap,
+        SimdLevel level, AlignmentWorkspace& workspace)
+    {
+      BPP_INSTRUMENT_SCOPE(ALIGN);
+      return fill_(a.data(), a.size(), b.data(), b.size(), profile, gap, level, false, workspace,
+          -static_cast<long>(a.size()), static_cast<long>(b.size()));
+    }
+
+    /**
+     * @brief Align two encoded sequences with affine gap penalties.
+     */
+    static int alignNW(const std::vector<int>& a, const std::vector<int>& b, const ScoringProfile& profile, int opening, int extending,
+        int gapCode, SimdLevel level, AlignmentWorkspace& workspace, std::vector<int>& r1, std::vector<int>& r2)
+    {
+      BPP_INSTRUMENT_SCOPE(ALIGN);
+      BPP_INSTRUMENT_COUNT(ALIGN, a.size() * b.size());
+      r1.clear();
+      r2.clear();
+      r1.reserve(a.size() + b.size());
+      r2.reserve(a.size() + b.size());
+      int score = affineFill_(a.data(), a.size(), b.data(), b.size(), profile, opening, extending, level, true, workspace);
+      affineTraceback_(a.data(), a.size(), b.data(), b.size(), gapCode, workspace, r1, r2);
+      return score;
+    }
+
+    /**
+     * @brief Compute the score of the optimal alignment of two encoded sequences with affine gap penalties, in linear memory.
+     */
+    static int getNWScore(const std::vector<int>& a, const std::vector<int>& b, const ScoringProfile& profile, int opening, int extending,
+        SimdLevel level, AlignmentWorkspace& workspace)
+    {
+      BPP_INSTRUMENT_SCOPE(ALIGN);
+      BPP_INSTRUMENT_COUNT(ALIGN, a.size() * b.size());
+      return affineFill_(a.data(), a.size(), b.data(), b.size(), profile, opening, extending, level, false, workspace);
+    }
+
+    /** @} */
+
+    /**
+     * @brief Compute the score of an existing pairwise alignment.
+     *
+     * Pairs of residues are scored with the index, positions with a gap in one sequence
+     * score 'gap', and positions with a gap in both sequences are ignored.
+     *
+     * @param seq1 The first aligned sequence.
+     * @param seq2 The second aligned sequence.
+     * @param s    The scoring index.
+     * @param gap  The gap score.
+     * @throw SequenceNotAlignedException If the sequences do not have the same length.
+     */
+    static double getAlignmentScore(const Sequence& seq1, const Sequence& seq2, const AlphabetIndex2& s, double gap)
+    {
+      if (seq1.size() != seq2.size())
+        throw SequenceNotAlignedException("GlobalAlignmentTools::getAlignmentScore. Sequences must have the same length.", &seq2);
+      const Alphabet* alphabet = seq1.getAlphabet();
+      double score = 0;
+      for (size_t k = 0; k < seq1.size(); ++k)
+      {
+        bool gap1 = alphabet->isGap(seq1[k]);
+        bool gap2 = alphabet->isGap(seq2[k]);
+        if (gap1 && gap2)
+          continue;
+        score += (gap1 || gap2) ? gap : s.getIndex(seq1[k], seq2[k]);
+      }
+      return score;
+    }
+
+    /**
+     * @brief Compute the score of an existing pairwise alignment, with affine gap penalties.
+     *
+     * Positions with a gap in both sequences are ignored, and do not interrupt gaps.
+     *
+     * @param seq1      The first aligned sequence.
+     * @param seq2      The second aligned sequence.
+     * @param s         The scoring index.
+     * @param opening   The score of the first position of a gap.
+     * @param extending The score of each other position of a gap.
+     * @throw SequenceNotAlignedException If the sequences do not have the same length.
+     */
+    static double getAlignmentScore(const Sequence& seq1, const Sequence& seq2, const AlphabetIndex2& s, double opening, double extending)
+    {
+      if (seq1.size() != seq2.size())
+        throw SequenceNotAlignedException("GlobalAlignmentTools::getAlignmentScore. Sequences must have the same length.", &seq2);
+      const Alphabet* alphabet = seq1.getAlphabet();
+      double score = 0;
+      bool inGap1 = false, inGap2 = false;
+      for (size_t k = 0; k < seq1.size(); ++k)
+      {
+        bool gap1 = alphabet->isGap(seq1[k]);
+        bool gap2 = alphabet->isGap(seq2[k]);
+        if (gap1 && gap2)
+          continue;
+        if (gap1)
+          score += inGap1 ? extending : opening;
+        else if (gap2)
+          score += inGap2 ? extending : opening;
+        else
+          score += s.getIndex(seq1[k], seq2[k]);
+        inGap1 = gap1;
+        inGap2 = gap2;
+      }
+      return score;
+    }
+
+  private:
+    static int toIntegerGap_(double gap)
+    {
+      double r = std::floor(gap + 0.5);
+      if (std::fabs(r - gap) > 1e-6)
+        throw Exception("GlobalAlignmentTools: the gap score must be an integer.");
+      return static_cast<int>(r);
+    }
+
+    static void encode_(const Sequence& seq1, const Sequence& seq2, const ScoringProfile& profile, std::vector<int>& a, std::vector<int>& b)
+    {
+      if (seq1.getAlphabet()->getAlphabetType() != profile.getAlphabet()->getAlphabetType())
+        throw AlphabetMismatchException("GlobalAlignmentTools. Sequence 1 and scoring profile do not match.", seq1.getAlphabet(), profile.getAlphabet());
+      if (seq2.getAlphabet()->getAlphabetType() != profile.getAlphabet()->getAlphabetType())
+        throw AlphabetMismatchException("GlobalAlignmentTools. Sequence 2 and scoring profile do not match.", seq2.getAlphabet(), profile.getAlphabet());
+      profile.encode(seq1, a);
+      profile.encode(seq2, b);
+    }
+
+    /*
+     * Compute one anti-diagonal. For cell k:
+     *   diag[k] is the score of the cell (i-1, j-1),
+     *   up[k] of the cell (i-1, j), left[k] of the cell (i, j-1),
+     *   a[k] + b[k] is the index of the substitution score in the matrix.
+     * The traceback direction is written in dirs if it is not null.
+     */
+    static void diagonalScalar_(const int* diag, const int* up, const int* left, const int* a, const int* b,
+        const int* matrix, int gap, size_t count, int* out, uint8_t* dirs)
+    {
+      for (size_t k = 0; k < count; ++k)
+      {
+        int d = diag[k] + matrix[a[k] + b[k]];
+        int g = std::max(up[k], left[k]) + gap;
+        out[k] = std::max(d, g);
+        if (dirs)
+          dirs[k] = static_cast<uint8_t>(d >= g ? DIAGONAL : (left[k] > up[k] ? LEFT : UP));
+      }
+    }
+
+#ifdef BPP_SIMD_X86
+    BPP_TARGET_SSE41
+    static void diagonalSse41_(const int* diag, const int* up, const int* left, const int* a, const int* b,
+        const int* matrix, int gap, size_t count, int* out, uint8_t* dirs)
+    {
+      const __m128i vgap = _mm_set1_epi32(gap);
+      const __m128i one = _mm_set1_epi32(1);
+      size_t k = 0;
+      for ( ; k + 4 <= count; k += 4)
+      {
+        //No gather instruction before AVX2:
+        __m128i vs = _mm_setr_epi32(matrix[a[k] + b[k]], matrix[a[k + 1] + b[k + 1]], matrix[a[k + 2] + b[k + 2]], matrix[a[k + 3] + b[k + 3]]);
+        __m128i vu = _mm_loadu_si128(reinterpret_cast<const __m128i*>(up + k));
+        __m128i vl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left + k));
+        __m128i vd = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(diag + k)), vs);
+        __m128i vg = _mm_add_epi32(_mm_max_epi32(vu, vl), vgap);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k), _mm_max_epi32(vd, vg));
+        if (dirs)
+        {
+          __m128i notDiag = _mm_cmpgt_epi32(vg, vd);
+          __m128i leftWins = _mm_and_si128(notDiag, _mm_cmpgt_epi32(vl, vu));
+          __m128i dv = _mm_add_epi32(_mm_and_si128(notDiag, one), _mm_and_si128(leftWins, one));
+          __m128i p16 = _mm_packs_epi32(dv, dv);
+          int packed = _mm_cvtsi128_si32(_mm_packus_epi16(p16, p16));
+          std::memcpy(dirs + k, &packed, 4);
+        }
+      }
+      diagonalScalar_(diag + k, up + k, left + k, a + k, b + k, matrix, gap, count - k, out + k, dirs ? dirs + k : 0);
+    }
+
+    BPP_TARGET_AVX2
+    static void diagonalAvx2_(const int* diag, const int* up, const int* left, const int* a, const int* b,
+        const int* matrix, int gap, size_t count, int* out, uint8_t* dirs)
+    {
+      const __m256i vgap = _mm256_set1_epi32(gap);
+      const __m256i one = _mm256_set1_epi32(1);
+      size_t k = 0;
+      for ( ; k + 8 <= count; k += 8)
+      {
+        __m256i idx = _mm256_add_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k)));
+        __m256i vs = _mm256_i32gather_epi32(matrix, idx, 4);
+        __m256i vu = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(up + k));
+        __m256i vl = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + k));
+        __m256i vd = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(diag + k)), vs);
+        __m256i vg = _mm256_add_epi32(_mm256_max_epi32(vu, vl), vgap);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), _mm256_max_epi32(vd, vg));
+        if (dirs)
+        {
+          __m256i notDiag = _mm256_cmpgt_epi32(vg, vd);
+          __m256i leftWins = _mm256_and_si256(notDiag, _mm256_cmpgt_epi32(vl, vu));
+          __m256i dv = _mm256_add_epi32(_mm256_and_si256(notDiag, one), _mm256_and_si256(leftWins, one));
+          __m128i p16 = _mm_packs_epi32(_mm256_castsi256_si128(dv), _mm256_extracti128_si256(dv, 1));
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(dirs + k), _mm_packus_epi16(p16, p16));
+        }
+      }
+      diagonalScalar_(diag + k, up + k, left + k, a + k, b + k, matrix, gap, count - k, out + k, dirs ? dirs + k : 0);
+    }
+#endif
+
+    static void diagonal_(SimdLevel level, const int* diag, const int* up, const int* left, const int* a, const int* b,
+        const int* matrix, int gap, size_t count, int* out, uint8_t* dirs)
+    {
+#ifdef BPP_SIMD_X86
+      if (level == SIMD_AVX2)
+        return diagonalAvx2_(diag, up, left, a, b, matrix, gap, count, out, dirs);
+      if (level == SIMD_SSE41)
+        return diagonalSse41_(diag, up, left, a, b, matrix, gap, count, out, dirs);
+#endif
+      diagonalScalar_(diag, up, left, a, b, matrix, gap, count, out, dirs);
+    }
+
+    /*
+     * Compute one anti-diagonal with affine gap penalties (Gotoh). For cell k:
+     *   diag[k] is the score H of the cell (i-1, j-1),
+     *   upH[k] and upF[k] are the scores H and F of the cell (i-1, j),
+     *   leftH[k] and leftE[k] are the scores H and E of the cell (i, j-1),
+     * where E (resp. F) is the best score of an alignment ending with a gap in the first (resp. second) sequence.
+     */
+    static void affineDiagonalScalar_(const int* diag, const int* upH, const int* upF, const int* leftH, const int* leftE,
+        const int* a, const int* b, const int* matrix, int opening, int extending, size_t count,
+        int* outH, int* outE, int* outF, uint8_t* dirs)
+    {
+      for (size_t k = 0; k < count; ++k)
+      {
+        int eExtend = leftE[k] + extending, eOpen = leftH[k] + opening;
+        int fExtend = upF[k] + extending, fOpen = upH[k] + opening;
+        int e = std::max(eExtend, eOpen);
+        int f = std::max(fExtend, fOpen);
+        int d = diag[k] + matrix[a[k] + b[k]];
+        int g = std::max(e, f);
+        outH[k] = std::max(d, g);
+        outE[k] = e;
+        outF[k] = f;
+        if (dirs)
+          dirs[k] = static_cast<uint8_t>((d >= g ? DIAGONAL : (e > f ? LEFT : UP))
+              | (eExtend > eOpen ? E_EXTENDED : 0) | (fExtend > fOpen ? F_EXTENDED : 0));
+      }
+    }
+
+#ifdef BPP_SIMD_X86
+    BPP_TARGET_SSE41
+    static void affineDiagonalSse41_(const int* diag, const int* upH, const int* upF, const int* leftH, const int* leftE,
+        const int* a, const int* b, const int* matrix, int opening, int extending, size_t count,
+        int* outH, int* outE, int* outF, uint8_t* dirs)
+    {
+      const __m128i vopen = _mm_set1_epi32(opening);
+      const __m128i vext = _mm_set1_epi32(extending);
+      const __m128i one = _mm_set1_epi32(1);
+      const __m128i eBit = _mm_set1_epi32(E_EXTENDED);
+      const __m128i fBit = _mm_set1_epi32(F_EXTENDED);
+      size_t k = 0;
+      for ( ; k + 4 <= count; k += 4)
+      {
+        __m128i vs = _mm_setr_epi32(matrix[a[k] + b[k]], matrix[a[k + 1] + b[k + 1]], matrix[a[k + 2] + b[k + 2]], matrix[a[k + 3] + b[k + 3]]);
+        __m128i eExtend = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(leftE + k)), vext);
+        __m128i eOpen = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(leftH + k)), vopen);
+        __m128i fExtend = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(upF + k)), vext);
+        __m128i fOpen = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(upH + k)), vopen);
+        __m128i ve = _mm_max_epi32(eExtend, eOpen);
+        __m128i vf = _mm_max_epi32(fExtend, fOpen);
+        __m128i vd = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(diag + k)), vs);
+        __m128i vg = _mm_max_epi32(ve, vf);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(outH + k), _mm_max_epi32(vd, vg));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(outE + k), ve);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(outF + k), vf);
+        if (dirs)
+        {
+          __m128i notDiag = _mm_cmpgt_epi32(vg, vd);
+          __m128i leftWins = _mm_and_si128(notDiag, _mm_cmpgt_epi32(ve, vf));
+          __m128i dv = _mm_add_epi32(_mm_and_si128(notDiag, one), _mm_and_si128(leftWins, one));
+          dv = _mm_or_si128(dv, _mm_and_si128(_mm_cmpgt_epi32(eExtend, eOpen), eBit));
+          dv = _mm_or_si128(dv, _mm_and_si128(_mm_cmpgt_epi32(fExtend, fOpen), fBit));
+          __m128i p16 = _mm_packs_epi32(dv, dv);
+          int packed = _mm_cvtsi128_si32(_mm_packus_epi16(p16, p16));
+          std::memcpy(dirs + k, &packed, 4);
+        }
+      }
+      affineDiagonalScalar_(diag + k, upH + k, upF + k, leftH + k, leftE + k, a + k, b + k, matrix, opening, extending,
+          count - k, outH + k, outE + k, outF + k, dirs ? dirs + k : 0);
+    }
+
+    BPP_TARGET_AVX2
+    static void affineDiagonalAvx2_(const int* diag, const int* upH, const int* upF, const int* leftH, const int* leftE,
+        const int* a, const int* b, const int* matrix, int opening, int extending, size_t count,
+        int* outH, int* outE, int* outF, uint8_t* dirs)
+    {
+      const __m256i vopen = _mm256_set1_epi32(opening);
+      const __m256i vext = _mm256_set1_epi32(extending);
+      const __m256i one = _mm256_set1_epi32(1);
+      const __m256i eBit = _mm256_set1_epi32(E_EXTENDED);
+      const __m256i fBit = _mm256_set1_epi32(F_EXTENDED);
+      size_t k = 0;
+      for ( ; k + 8 <= count; k += 8)
+      {
+        __m256i idx = _mm256_add_epi32(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + k)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k)));
+        __m256i vs = _mm256_i32gather_epi32(matrix, idx, 4);
+        __m256i eExtend = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(leftE + k)), vext);
+        __m256i eOpen = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(leftH + k)), vopen);
+        __m256i fExtend = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(upF + k)), vext);
+        __m256i fOpen = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(upH + k)), vopen);
+        __m256i ve = _mm256_max_epi32(eExtend, eOpen);
+        __m256i vf = _mm256_max_epi32(fExtend, fOpen);
+        __m256i vd = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(diag + k)), vs);
+        __m256i vg = _mm256_max_epi32(ve, vf);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(outH + k), _mm256_max_epi32(vd, vg));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(outE + k), ve);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(outF + k), vf);
+        if (dirs)
+        {
+          __m256i notDiag = _mm256_cmpgt_epi32(vg, vd);
+          __m256i leftWins = _mm256_and_si256(notDiag, _mm256_cmpgt_epi32(ve, vf));
+          __m256i dv = _mm256_add_epi32(_mm256_and_si256(notDiag, one), _mm256_and_si256(leftWins, one));
+          dv = _mm256_or_si256(dv, _mm256_and_si256(_mm256_cmpgt_epi32(eExtend, eOpen), eBit));
+          dv = _mm256_or_si256(dv, _mm256_and_si256(_mm256_cmpgt_epi32(fExtend, fOpen), fBit));
+          __m128i p16 = _mm_packs_epi32(_mm256_castsi256_si128(dv), _mm256_extracti128_si256(dv, 1));
+          _mm_storel_epi64(reinterpret_cast<__m128i*>(dirs + k), _mm_packus_epi16(p16, p16));
+        }
+      }
+      affineDiagonalScalar_(diag + k, upH + k, upF + k, leftH + k, leftE + k, a + k, b + k, matrix, opening, extending,
+          count - k, outH + k, outE + k, outF + k, dirs ? dirs + k : 0);
+    }
+#endif
+
+    static void affineDiagonal_(SimdLevel level, const int* diag, const int* upH, const int* upF, const int* leftH, const int* leftE,
+        const int* a, const int* b, const int* matrix, int opening, int extending, size_t count,
+        int* outH, int* outE, int* outF, uint8_t* dirs)
+    {
+#ifdef BPP_SIMD_X86
+      if (level == SIMD_AVX2)
+        return affineDiagonalAvx2_(diag, upH, upF, leftH, leftE, a, b, matrix, opening, extending, count, outH, outE, outF, dirs);
+      if (level == SIMD_SSE41)
+        return affineDiagonalSse41_(diag, upH, upF, leftH, leftE, a, b, matrix, opening, extending, count, outH, outE, outF, dirs);
+#endif
+      affineDiagonalScalar_(diag, upH, upF, leftH, leftE, a, b, matrix, opening, extending, count, outH, outE, outF, dirs);
+    }
+
+    /*
+     * The first and last rows of the cells of anti-diagonal d (i + j = d) computed by fill_, with i, j > 0
+     * and lower <= j - i <= upper. The whole matrix is computed with lower = -n and upper = m.
+     */
+    static size_t diagonalStart_(size_t d, size_t m, long upper)
+    {
+      size_t lo = (d > m ? d - m : 1);
+      long x = static_cast<long>(d) - upper;
+      if (x > 0)
+        lo = std::max(lo, static_cast<size_t>((x + 1) / 2));
+      return lo;
+    }
+
+    static size_t diagonalEnd_(size_t d, size_t n, long lower)
+    {
+      return std::min(std::min(n, d - 1), static_cast<size_t>((static_cast<long>(d) - lower) / 2));
+    }
+
+    /*
+     * The number of inner cells (i, j) of a matrix with lower <= j - i <= upper.
+     */
+    static size_t getNumberOfCells_(size_t n, size_t m, long lower, long upper)
+    {
+      size_t cells = 0;
+      for (size_t d = 2; d <= n + m; ++d)
+      {
+        size_t lo = diagonalStart_(d, m, upper);
+        size_t hi = diagonalEnd_(d, n, lower);
+        cells += (lo <= hi ? hi - lo + 1 : 0);
+      }
+      return cells;
+    }
+
+    /*
+     * Fill the dynamic programming matrix anti-diagonal by anti-diagonal, and return the final score.
+     * Scores are stored in arrays indexed by the row i, so that cells of consecutive
+     * anti-diagonals needed by a cell are at consecutive addresses.
+     * Only cells with lower <= j - i <= upper are computed: cells just outside this band are set to
+     * minus infinity, so that they are never chosen by their neighbours.
+     * If traceback is true, directions of the inner cells of anti-diagonal d
+     * are stored in workspace.dirs, from workspace.bases[d].
+     * If lastRow is not null, the scores of the last row (a aligned with each prefix of b) are copied into it.
+     * The computed cells are counted in the ALIGN category of Instrumentation: this includes the cells computed
+     * again by Hirschberg's algorithm, and each pass of a banded alignment.
+     */
+    static int fill_(const int* a, size_t n, const int* b, size_t m, const ScoringProfile& profile, int gap,
+        SimdLevel level, bool traceback, AlignmentWorkspace& ws, long lower, long upper, std::vector<int>* lastRow = 0)
+    {
+      BPP_INSTRUMENT_COUNT(ALIGN, getNumberOfCells_(n, m, lower, upper));
+      const int minusInfinity = INT_MIN / 4;
+      level = SimdSupport::getSupportedLevel(level);
+      int nbStates = profile.getNumberOfStates();
+      ws.matrix.assign(profile.getMatrix().begin(), profile.getMatrix().end());
+      ws.rowIndex.resize(n + 1);
+      ws.rowIndex[0] = 0;
+      for (size_t i = 1; i <= n; ++i)
+        ws.rowIndex[i] = a[i - 1] * nbStates;
+      ws.reversed.resize(m + 1);
+      for (size_t k = 0; k < m; ++k)
+        ws.reversed[k] = b[m - 1 - k];
+      if (traceback)
+      {
+        ws.dirs.resize(getNumberOfCells_(n, m, lower, upper));
+        ws.bases.resize(n + m + 1);
+      }
+      if (lastRow)
+      {
+        lastRow->resize(m + 1);
+        (*lastRow)[0] = static_cast<int>(n) * gap;
+      }
+
+      ws.h0.assign(n + 1, 0);
+      ws.h1.assign(n + 1, 0);
+      ws.h2.assign(n + 1, 0);
+      int* prev2 = &ws.h0[0];
+      int* prev1 = &ws.h1[0];
+      int* current = &ws.h2[0];
+      size_t base = 0;
+      for (size_t d = 1; d <= n + m; ++d)
+      {
+        long ld = static_cast<long>(d);
+        if (d <= m)
+          current[0] = (ld <= upper ? static_cast<int>(d) * gap : minusInfinity);
+        if (d <= n)
+          current[d] = (-ld >= lower ? static_cast<int>(d) * gap : minusInfinity);
+        size_t lo = diagonalStart_(d, m, upper);
+        size_t hi = diagonalEnd_(d, n, lower);
+        if (traceback)
+          ws.bases[d] = base;
+        if (lo <= hi)
+        {
+          size_t count = hi - lo + 1;
+          //Cell (i, j = d - i) of b is at position m - j in the reversed sequence:
+          diagonal_(level, prev2 + lo - 1, prev1 + lo - 1, prev1 + lo, &ws.rowIndex[lo], &ws.reversed[m + lo - d],
+              &ws.matrix[0], gap, count, current + lo, traceback ? &ws.dirs[base] : 0);
+          base += count;
+          if (lo > 1)
+            current[lo - 1] = minusInfinity;
+          if (hi < n && hi + 1 < d)
+            current[hi + 1] = minusInfinity;
+        }
+        //Cell (n, d - n) is the last one of the anti-diagonal:
+        if (lastRow && d >= n)
+          (*lastRow)[d - n] = current[n];
+        int* tmp = prev2;
+        prev2 = prev1;
+        prev1 = current;
+        current = tmp;
+      }
+      return prev1[n];
+    }
+
+    /*
+     * Append the alignment found by fill_ to r1 and r2.
+     */
+    static void traceback_(const int* a, size_t n, const int* b, size_t m, int gapCode, long upper,
+        const AlignmentWorkspace& ws, std::vector<int>& r1, std::vector<int>& r2)
+    {
+      size_t start = r1.size();
+      size_t i = n, j = m;
+      while (i > 0 || j > 0)
+      {
+        int dir;
+        if (i == 0)
+          dir = LEFT;
+        else if (j == 0)
+          dir = UP;
+        else
+        {
+          size_t d = i + j;
+          dir = ws.dirs[ws.bases[d] + i - diagonalStart_(d, m, upper)];
+        }
+        if (dir == DIAGONAL)
+        {
+          r1.push_back(a[--i]);
+          r2.push_back(b[--j]);
+        }
+        else if (dir == UP)
+        {
+          r1.push_back(a[--i]);
+          r2.push_back(gapCode);
+        }
+        else
+        {
+          r1.push_back(gapCode);
+          r2.push_back(b[--j]);
+        }
+      }
+      std::reverse(r1.begin() + static_cast<std::ptrdiff_t>(start), r1.end());
+      std::reverse(r2.begin() + static_cast<std::ptrdiff_t>(start), r2.end());
+    }
+
+    /*
+     * Hirschberg's algorithm: the best crossing point of the middle row of a is found
+     * from the last rows of the forward and backward matrices, and both halves are aligned
+     * recursively. Small sub-problems are aligned with a full traceback matrix, which is
+     * faster and uses a bounded amount of memory.
+     * ra and rb point to the reversed sequences, that is ra[k] == a[n - 1 - k].
+     */
+    static int hirschberg_(const int* a, size_t n, const int* b, size_t m, const int* ra, const int* rb,
+        const ScoringProfile& profile, int gap, int gapCode, SimdLevel level, AlignmentWorkspace& ws,
+        std::vector<int>& r1, std::vector<int>& r2)
+    {
+      long ln = static_cast<long>(n), lm = static_cast<long>(m);
+      if (n <= 1 || n * m <= HIRSCHBERG_LEAF_CELLS)
+      {
+        int score = fill_(a, n, b, m, profile, gap, level, true, ws, -ln, lm);
+        traceback_(a, n, b, m, gapCode, lm, ws, r1, r2);
+        return score;
+      }
+      size_t mid = n / 2;
+      fill_(a, mid, b, m, profile, gap, level, false, ws, -ln, lm, &ws.forward);
+      fill_(ra, n - mid, rb, m, profile, gap, level, false, ws, -ln, lm, &ws.backward);
+      size_t split = 0;
+      int best = INT_MIN;
+      for (size_t j = 0; j <= m; ++j)
+      {
+        int score = ws.forward[j] + ws.backward[m - j];
+        if (score > best)
+        {
+          best = score;
+          split = j;
+        }
+      }
+      hirschberg_(a, mid, b, split, ra + (n - mid), rb + (m - split), profile, gap, gapCode, level, ws, r1, r2);
+      hirschberg_(a + mid, n - mid, b + split, m - split, ra, rb, profile, gap, gapCode, level, ws, r1, r2);
+      return best;
+    }
+
+    /*
+     * Banded alignment: cells (i, j) are computed if j - i is in [lower, upper], with
+     * lower = min(0, m - n) - width and upper = max(0, m - n) + width.
+     * If no width is given, it is doubled until the alignment is proven optimal: an alignment leaving
+     * the band has at least g gap positions, and at most (n + m - g) / 2 aligned pairs, which bounds its score.
+     */
+    static int banded_(const int* a, size_t n, const int* b, size_t m, const ScoringProfile& profile, int gap,
+        int gapCode, size_t bandWidth, SimdLevel level, AlignmentWorkspace& ws, std::vector<int>& r1, std::vector<int>& r2)
+    {
+      const std::vector<int16_t>& matrix = profile.getMatrix();
+      int maxScore = *std::max_element(matrix.begin(), matrix.end());
+      long shift = static_cast<long>(m) - static_cast<long>(n);
+      size_t width = (bandWidth > 0 ? bandWidth : static_cast<size_t>(DEFAULT_BAND_WIDTH));
+      while (true)
+      {
+        long lower = std::min(0l, shift) - static_cast<long>(width);
+        long upper = std::max(0l, shift) + static_cast<long>(width);
+        int score = fill_(a, n, b, m, profile, gap, level, true, ws, lower, upper);
+        if (bandWidth == 0 && width < std::max(n, m))
+        {
+          //Fewest gaps needed to leave the band, on its upper or lower side.
+          //The bound only holds if additional gaps never increase the score:
+          long g = 2 * (static_cast<long>(width) + 1) + std::labs(shift);
+          long bound = g * gap + (static_cast<long>(n + m) - g) / 2 * maxScore;
+          if (2 * gap > maxScore || static_cast<long>(score) < bound)
+          {
+            width *= 2;
+            continue;
+          }
+        }
+        traceback_(a, n, b, m, gapCode, upper, ws, r1, r2);
+        return score;
+      }
+    }
+
+    /*
+     * Same as fill_ (on the whole matrix), with affine gap penalties.
+     * Two anti-diagonals of E and F scores are kept in addition to the three anti-diagonals of H scores.
+     */
+    static int affineFill_(const int* a, size_t n, const int* b, size_t m, const ScoringProfile& profile, int opening, int extending,
+        SimdLevel level, bool traceback, AlignmentWorkspace& ws)
+    {
+      const int minusInfinity = INT_MIN / 4;
+      level = SimdSupport::getSupportedLevel(level);
+      int nbStates = profile.getNumberOfStates();
+      ws.matrix.assign(profile.getMatrix().begin(), profile.getMatrix().end());
+      ws.rowIndex.resize(n + 1);
+      ws.rowIndex[0] = 0;
+      for (size_t i = 1; i <= n; ++i)
+        ws.rowIndex[i] = a[i - 1] * nbStates;
+      ws.reversed.resize(m + 1);
+      for (size_t k = 0; k < m; ++k)
+        ws.reversed[k] = b[m - 1 - k];
+      if (traceback)
+      {
+        ws.dirs.resize(n * m);
+        ws.bases.resize(n + m + 1);
+      }
+
+      ws.h0.assign(n + 1, 0);
+      ws.h1.assign(n + 1, 0);
+      ws.h2.assign(n + 1, 0);
+      ws.e0.assign(n + 1, minusInfinity);
+      ws.e1.assign(n + 1, minusInfinity);
+      ws.f0.assign(n + 1, minusInfinity);
+      ws.f1.assign(n + 1, minusInfinity);
+      int* prev2 = &ws.h0[0];
+      int* prev1 = &ws.h1[0];
+      int* current = &ws.h2[0];
+      int* prevE = &ws.e0[0];
+      int* currentE = &ws.e1[0];
+      int* prevF = &ws.f0[0];
+      int* currentF = &ws.f1[0];
+      size_t base = 0;
+      for (size_t d = 1; d <= n + m; ++d)
+      {
+        //Borders: a single gap of length d.
+        int border = opening + static_cast<int>(d - 1) * extending;
+        if (d <= m)
+        {
+          current[0] = border;
+          currentE[0] = border;
+          currentF[0] = minusInfinity;
+        }
+        if (d <= n)
+        {
+          current[d] = border;
+          currentE[d] = minusInfinity;
+          currentF[d] = border;
+        }
+        size_t lo = (d > m ? d - m : 1);
+        size_t hi = std::min(n, d - 1);
+        if (traceback)
+          ws.bases[d] = base;
+        if (lo <= hi)
+        {
+          size_t count = hi - lo + 1;
+          affineDiagonal_(level, prev2 + lo - 1, prev1 + lo - 1, prevF + lo - 1, prev1 + lo, prevE + lo,
+              &ws.rowIndex[lo], &ws.reversed[m + lo - d], &ws.matrix[0], opening, extending, count,
+              current + lo, currentE + lo, currentF + lo, traceback ? &ws.dirs[base] : 0);
+          base += count;
+        }
+        int* tmp = prev2;
+        prev2 = prev1;
+        prev1 = current;
+        current = tmp;
+        std::swap(prevE, currentE);
+        std::swap(prevF, currentF);
+      }
+      return prev1[n];
+    }
+
+    /*
+     * Append the alignment found by affineFill_ to r1 and r2.
+     * The traceback moves between three matrices: H, E (gap in the first sequence) and F (gap in the second one).
+     */
+    static void affineTraceback_(const int* a, size_t n, const int* b, size_t m, int gapCode,
+        const AlignmentWorkspace& ws, std::vector<int>& r1, std::vector<int>& r2)
+    {
+      size_t start = r1.size();
+      size_t i = n, j = m;
+      int state = DIAGONAL;
+      while (i > 0 || j > 0)
+      {
+        uint8_t cell = 0;
+        if (i > 0 && j > 0)
+        {
+          size_t d = i + j;
+          cell = ws.dirs[ws.bases[d] + i - (d > m ? d - m : 1)];
+        }
+        if (state == DIAGONAL)
+        {
+          if (i == 0)
+            state = LEFT;
+          else if (j == 0)
+            state = UP;
+          else
+            state = cell & DIRECTION_MASK;
+          if (state != DIAGONAL)
+            continue;
+          r1.push_back(a[--i]);
+          r2.push_back(b[--j]);
+        }
+        else if (state == UP)
+        {
+          r1.push_back(a[--i]);
+          r2.push_back(gapCode);
+          if (j > 0 && !(cell & F_EXTENDED))
+            state = DIAGONAL;
+        }
+        else
+        {
+          r1.push_back(gapCode);
+          r2.push_back(b[--j]);
+          if (i > 0 && !(cell & E_EXTENDED))
+            state = DIAGONAL;
+        }
+      }
+      std::reverse(r1.begin() + static_cast<std::ptrdiff_t>(start), r1.end());
+      std::reverse(r2.begin() + static_cast<std::ptrdiff_t>(start), r2.end());
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_GLOBALALIGNMENTTOOLS_H_
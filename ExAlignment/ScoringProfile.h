@@ -0,0 +1,116 @@
+/*
+ * File: ScoringProfile.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 13:20 2026
+ *
+ * Integer substitution matrices precomputed from an AlphabetIndex2, for fast alignment.
+ */
+
+#ifndef _SCORINGPROFILE_H_
+#define _SCORINGPROFILE_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/AlphabetIndex/AlphabetIndex2.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A substitution score matrix stored as a flat array of 16 bits integers.
+   *
+   * The matrix is filled once from an AlphabetIndex2, for all non-gap states of the alphabet,
+   * so that alignment algorithms only do array lookups instead of virtual calls.
+   * Scores are multiplied by a scale factor and must then be integers.
+   * States for which the index is not defined (getIndex throws an exception) are not supported,
+   * and sequences containing them are rejected by encode().
+   */
+  class ScoringProfile
+  {
+  private:
+    const Alphabet* alphabet_;
+    int nbStates_;
+    double scale_;
+    std::vector<int16_t> matrix_;
+    std::vector<bool> supported_;
+
+  public:
+    /**
+     * @param index The scoring index to use, for instance DefaultNucleotideScore.
+     * @param scale A factor applied to all scores, which must be integers after scaling.
+     * @throw Exception If a scaled score is not an integer, or does not fit in 16 bits.
+     */
+    explicit ScoringProfile(const AlphabetIndex2& index, double scale = 1.) :
+      alphabet_(index.getAlphabet()), nbStates_(0), scale_(scale), matrix_(), supported_()
+    {
+      while (alphabet_->isIntInAlphabet(nbStates_))
+        ++nbStates_;
+      matrix_.assign(static_cast<size_t>(nbStates_ * nbStates_), 0);
+      supported_.assign(static_cast<size_t>(nbStates_), true);
+      for (int a = 0; a < nbStates_; ++a)
+      {
+        for (int b = 0; b < nbStates_; ++b)
+        {
+          double s;
+          try
+          {
+            s = index.getIndex(a, b) * scale;
+          }
+          catch (Exception& e)
+          {
+            supported_[static_cast<size_t>(a)] = false;
+            supported_[static_cast<size_t>(b)] = false;
+            continue;
+          }
+          double r = std::floor(s + 0.5);
+          if (std::fabs(r - s) > 1e-6)
+            throw Exception("ScoringProfile: score " + TextTools::toString(s) + " is not an integer. Use a scale factor.");
+          if (r < -32768. || r > 32767.)
+            throw Exception("ScoringProfile: score " + TextTools::toString(s) + " does not fit in 16 bits.");
+          matrix_[static_cast<size_t>(a * nbStates_ + b)] = static_cast<int16_t>(r);
+        }
+      }
+    }
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+
+    /**
+     * @return The number of states in the matrix: states are 0 to getNumberOfStates() - 1.
+     */
+    int getNumberOfStates() const { return nbStates_; }
+    double getScale() const { return scale_; }
+    bool isSupported(int state) const { return state >= 0 && state < nbStates_ && supported_[static_cast<size_t>(state)]; }
+    int getScore(int a, int b) const { return matrix_[static_cast<size_t>(a * nbStates_ + b)]; }
+
+    /**
+     * @return The flat matrix, where the score of (a, b) is at a * getNumberOfStates() + b.
+     */
+    const std::vector<int16_t>& getMatrix() const { return matrix_; }
+
+    /**
+     * @brief Check the states of a sequence and copy them into a vector.
+     *
+     * @throw BadIntException If a state (for instance a gap) is not supported by the profile.
+     */
+    void encode(const Sequence& seq, std::vector<int>& states) const
+    {
+      const std::vector<int>& content = seq.getContent();
+      states.resize(content.size());
+      for (size_t i = 0; i < content.size(); ++i)
+      {
+        if (!isSupported(content[i]))
+          throw BadIntException(content[i], "ScoringProfile::encode. State not supported, in sequence " + seq.getName(), alphabet_);
+        states[i] = content[i];
+      }
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_SCORINGPROFILE_H_
@@ -0,0 +1,87 @@
+/*
+ * File: SimdSupport.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 13:20 2026
+ *
+ * Runtime detection of the SIMD instruction sets available on the processor.
+ */
+
+#ifndef _SIMDSUPPORT_H_
+#define _SIMDSUPPORT_H_
+
+#include <string>
+
+/*
+ * Vectorized code is compiled with per-function target attributes, so that the program
+ * itself does not need to be compiled with -mavx2 and still runs on older processors.
+ * This requires GCC or Clang on x86. Other compilers and architectures only get the scalar code.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define BPP_SIMD_X86 1
+#include <immintrin.h>
+#define BPP_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define BPP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace bpp
+{
+  /**
+   * @brief The instruction sets used by the vectorized algorithms, from the least to the most powerful.
+   */
+  enum SimdLevel
+  {
+    SIMD_SCALAR = 0,
+    SIMD_SSE41 = 1,
+    SIMD_AVX2 = 2
+  };
+
+  /**
+   * @brief Detection of the instruction sets supported by the processor.
+   */
+  class SimdSupport
+  {
+  public:
+    /**
+     * @return The most powerful instruction set supported by both the processor and the compiler.
+     */
+    static SimdLevel getBestLevel()
+    {
+      static const SimdLevel level = detect_();
+      return level;
+    }
+
+    /**
+     * @return The requested level if it is supported, the best supported level otherwise.
+     */
+    static SimdLevel getSupportedLevel(SimdLevel requested)
+    {
+      return requested <= getBestLevel() ? requested : getBestLevel();
+    }
+
+    static std::string getName(SimdLevel level)
+    {
+      switch (level)
+      {
+      case SIMD_AVX2: return "AVX2";
+      case SIMD_SSE41: return "SSE4.1";
+      default: return "scalar";
+      }
+    }
+
+  private:
+    static SimdLevel detect_()
+    {
+#ifdef BPP_SIMD_X86
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2"))
+        return SIMD_AVX2;
+      if (__builtin_cpu_supports("sse4.1"))
+        return SIMD_SSE41;
+#endif
+      return SIMD_SCALAR;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_SIMDSUPPORT_H_
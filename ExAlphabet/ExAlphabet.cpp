@@ -77,6 +77,12 @@ int main(int args, char ** argv)
       cout << states[i] << "\t" << alphabet->charToInt(states[i]) << endl; 
     }
 
+    /*
+     * Each call to charToInt builds and looks up a string. When many characters are converted,
+     * as when reading sequences, a CharacterTable (in ExContainer) does the same with a single
+     * table lookup per character. Run exalphabetbenchmark to compare both.
+     */
+
   }
   catch(Exception& e)
   {
@@ -0,0 +1,161 @@
+/*
+ * File: ExAlphabetBenchmark.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 22:40 2026
+ *
+ * Micro-benchmark of the conversions between characters and state codes:
+ * Alphabet::charToInt / intToChar, one character at a time, versus the CharacterTable lookup tables.
+ *
+ * Usage: exalphabetbenchmark [input.length=10000000] [bench.warmup=3] [bench.repetitions=20] [output.json.file=alphabet.json]
+ */
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+
+/*
+ * From bpp-core:
+ */
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/App/AttributesTools.h>
+
+/*
+ * The benchmark tools, and the lookup tables:
+ */
+#include "BenchmarkTools.h" /* from ExBenchmark */
+#include "CharacterTable.h" /* from ExContainer */
+
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * A random text made of the resolved states of an alphabet.
+ */
+static string randomText(const Alphabet* alphabet, size_t length, unsigned int seed)
+{
+  mt19937 rng(seed);
+  uniform_int_distribution<int> state(0, static_cast<int>(alphabet->getSize()) - 1);
+  vector<char> chars(alphabet->getSize());
+  for (size_t i = 0; i < chars.size(); ++i)
+    chars[i] = alphabet->intToChar(static_cast<int>(i))[0];
+  string text(length, ' ');
+  for (size_t i = 0; i < length; ++i)
+    text[i] = chars[static_cast<size_t>(state(rng))];
+  return text;
+}
+
+/*
+ * The benchmarked operations, one character at a time as in ExAlphabet...
+ */
+static size_t encodeByChar(const Alphabet* alphabet, const string& text, vector<int>& states)
+{
+  for (size_t i = 0; i < text.size(); ++i)
+    states[i] = alphabet->charToInt(string(1, text[i]));
+  return states.size();
+}
+
+static size_t decodeByChar(const Alphabet* alphabet, const vector<int>& states, string& text)
+{
+  for (size_t i = 0; i < states.size(); ++i)
+    text[i] = alphabet->intToChar(states[i])[0];
+  return text.size();
+}
+
+/*
+ * ... and with the lookup tables, one buffer at a time:
+ */
+static size_t encodeByTable(const CharacterTable& table, const string& text, vector<int>& states)
+{
+  table.encode(text.data(), text.size(), &states[0]);
+  return states.size();
+}
+
+static size_t decodeByTable(const CharacterTable& table, const vector<int>& states, string& text)
+{
+  table.decode(&states[0], states.size(), &text[0]);
+  return text.size();
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+
+int main(int args, char** argv)
+{
+  try
+  {
+    map<string, string> params = AttributesTools::parseOptions(args, argv);
+    size_t length = static_cast<size_t>(ApplicationTools::getIntParameter("input.length", params, 10000000));
+    unsigned int warmup = static_cast<unsigned int>(ApplicationTools::getIntParameter("bench.warmup", params, 3));
+    unsigned int nrep = static_cast<unsigned int>(ApplicationTools::getIntParameter("bench.repetitions", params, 20));
+    string jsonPath = ApplicationTools::getStringParameter("output.json.file", params, "alphabet.json");
+    ApplicationTools::displayResult("Text length", length);
+    ApplicationTools::displayResult("Warmup / repetitions", TextTools::toString(warmup) + " / " + TextTools::toString(nrep));
+
+    vector<const Alphabet*> alphabets;
+    alphabets.push_back(&AlphabetTools::DNA_ALPHABET);
+    alphabets.push_back(&AlphabetTools::RNA_ALPHABET);
+    alphabets.push_back(&AlphabetTools::PROTEIN_ALPHABET);
+
+    vector<BenchmarkResult> results;
+    for (size_t a = 0; a < alphabets.size(); ++a)
+    {
+      const Alphabet* alphabet = alphabets[a];
+      string type = alphabet->getAlphabetType();
+      CharacterTable table(alphabet);
+      string text = randomText(alphabet, length, 42);
+      vector<int> states(length);
+      string decoded(length, ' ');
+
+      results.push_back(BenchmarkTools::run("encode", type + " charToInt",
+          [&]() { return encodeByChar(alphabet, text, states); }, warmup, nrep));
+      vector<int> reference = states;
+      results.push_back(BenchmarkTools::run("encode", type + " CharacterTable",
+          [&]() { return encodeByTable(table, text, states); }, warmup, nrep));
+      if (states != reference)
+        throw Exception("CharacterTable::encode does not give the same states as charToInt for the " + type);
+
+      results.push_back(BenchmarkTools::run("decode", type + " intToChar",
+          [&]() { return decodeByChar(alphabet, states, decoded); }, warmup, nrep));
+      results.push_back(BenchmarkTools::run("decode", type + " CharacterTable",
+          [&]() { return decodeByTable(table, states, decoded); }, warmup, nrep));
+      if (decoded != text)
+        throw Exception("CharacterTable::decode does not give back the original text for the " + type);
+    }
+
+    for (size_t i = 0; i < results.size(); ++i)
+      BenchmarkTools::display(results[i]);
+
+    if (jsonPath != "none")
+    {
+      map<string, string> context;
+      context["input.length"] = TextTools::toString(length);
+      ofstream json(jsonPath.c_str(), ios::out);
+      BenchmarkTools::writeJson(json, context, results);
+      ApplicationTools::displayResult("JSON report written to", jsonPath);
+    }
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
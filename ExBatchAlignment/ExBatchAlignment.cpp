@@ -0,0 +1,187 @@
+/*
+ * File: ExBatchAlignment.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 14:40 2026
+ *
+ * All-against-all pairwise alignments, on several threads.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <chrono> /* for timings below the second. */
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+#include <Bpp/Seq/AlphabetIndex/DefaultNucleotideScore.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * And the alignment engine, in this directory:
+ */
+#include "PairwiseAlignmentEngine.h"
+#include "Instrumentation.h" /* from ExBenchmark */
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * Alignments are read from an aligned file, so we need to remove the gaps first:
+ */
+Sequence* ungap(const Sequence& seq)
+{
+  vector<int> content;
+  for (size_t i = 0; i < seq.size(); i++)
+    if (!seq.getAlphabet()->isGap(seq[i]))
+      content.push_back(seq[i]);
+  return new BasicSequence(seq.getName(), content, seq.getAlphabet());
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * We read the sequences from the ExContainer alignment, and remove the gaps.
+     * All 453 sequences make more than 100,000 pairs, so we only keep a few of them:
+     */
+    unsigned int nseq = 100; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
+    Fasta fasReader;
+    OrderedSequenceContainer* alignment = fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    VectorSequenceContainer sequences(&AlphabetTools::DNA_ALPHABET);
+    for (size_t i = 0; i < nseq && i < alignment->getNumberOfSequences(); i++)
+    {
+      Sequence* seq = ungap(alignment->getSequence(i));
+      sequences.addSequence(*seq, false);
+      delete seq;
+    }
+    delete alignment;
+    size_t n = sequences.getNumberOfSequences();
+    ApplicationTools::displayResult("Number of pairs", n * (n - 1) / 2);
+
+    /*
+     * The engine takes the scores once, as a ScoringProfile (see ExAlignment):
+     */
+    DefaultNucleotideScore scores(&AlphabetTools::DNA_ALPHABET);
+    ScoringProfile profile(scores);
+    PairwiseAlignmentEngine engine(profile, -5);
+
+    /*
+     * By default, only the scores are computed. Let's see how the computation scales with the number of threads:
+     */
+    double reference = 0;
+    PairwiseAlignmentMatrix* sequential = 0;
+    unsigned int nbThreads[] = { 1, 2, 4, 8 };
+    for (size_t t = 0; t < 4; t++)
+    {
+      engine.setNumberOfThreads(nbThreads[t]);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      PairwiseAlignmentMatrix* matrix = engine.alignAll(sequences);
+      double time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      if (t == 0)
+      {
+        reference = time;
+        sequential = matrix;
+      }
+      bool identical = (matrix->getScores() == sequential->getScores());
+      ApplicationTools::displayResult("All pairs, " + TextTools::toString(nbThreads[t]) + " thread(s)",
+          TextTools::toString(time * 1000., 4) + " ms, speedup x" + TextTools::toString(reference / time, 3) + ", same scores: " + (identical ? "yes" : "no"));
+      if (matrix != sequential)
+        delete matrix;
+    }
+    /*
+     * Note that speedups are limited by the number of cores of your computer:
+     */
+    ApplicationTools::displayResult("Hardware threads", ThreadPool::getDefaultNumberOfThreads());
+
+    /*
+     * The scores are the same as with GlobalAlignmentTools, one pair at a time:
+     */
+    bool identical = true;
+    for (size_t j = 1; j < n; j++)
+      identical = identical && (sequential->getScore(0, j) == GlobalAlignmentTools::getNWScore(sequences.getSequence(0), sequences.getSequence(j), profile, -5));
+    ApplicationTools::displayResult("Same scores as GlobalAlignmentTools", identical ? "yes" : "no");
+    delete sequential;
+
+    /*
+     * Identities need a traceback, and alignments can be kept if needed.
+     * Instead of all pairs, we can also give a list of pairs:
+     */
+    engine.setNumberOfThreads(0);
+    engine.setComputeIdentities(true);
+    engine.setKeepAlignments(true);
+    vector< pair<size_t, size_t> > pairs;
+    for (size_t j = 1; j < 5; j++)
+      pairs.push_back(make_pair(static_cast<size_t>(0), j));
+    PairwiseAlignmentMatrix* matrix = engine.align(sequences, pairs);
+    for (size_t j = 1; j < 5; j++)
+      cout << matrix->getSequencesNames()[0] << " / " << matrix->getSequencesNames()[j]
+           << ": score " << matrix->getScore(0, j)
+           << ", identity " << TextTools::toString(matrix->getIdentity(0, j), 3)
+           << ", alignment length " << matrix->getAlignment(0, j).getNumberOfSites() << endl;
+    /*
+     * Other pairs were not computed:
+     */
+    cout << "Pair 1/2 computed: " << (matrix->isComputed(1, 2) ? "yes" : "no") << endl;
+    delete matrix;
+
+    /*
+     * In a build with 'make INSTRUMENTATION=1', alignments are counted by thread.
+     * Check that no thread spent much more time aligning than the others:
+     */
+    Instrumentation::display();
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ * File: PairwiseAlignmentEngine.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 14:40 2026
+ *
+ * All-against-all pairwise alignment of a set of sequences, on several threads.
+ */
+
+#ifndef _PAIRWISEALIGNMENTENGINE_H_
+#define _PAIRWISEALIGNMENTENGINE_H_
+
+#include "GlobalAlignmentTools.h" /* from ExAlignment */
+#include "ThreadPool.h" /* from ExParallelFasta */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Results of a batch of pairwise alignments: dense matrices of scores and identities,
+   * and optionally the alignments themselves.
+   *
+   * The identity of two sequences is the number of identical aligned residues
+   * divided by the length of their alignment.
+   */
+  class PairwiseAlignmentMatrix
+  {
+  private:
+    std::vector<std::string> names_;
+    size_t n_;
+    std::vector<int> scores_;
+    std::vector<double> identities_;
+    std::vector<unsigned char> computed_;
+    std::map<std::pair<size_t, size_t>, AlignedSequenceContainer*> alignments_;
+
+  public:
+    PairwiseAlignmentMatrix(const std::vector<std::string>& names) :
+      names_(names),
+      n_(names.size()),
+      scores_(n_ * n_, 0),
+      identities_(n_ * n_, std::numeric_limits<double>::quiet_NaN()),
+      computed_(n_ * n_, 0),
+      alignments_()
+    {}
+
+    ~PairwiseAlignmentMatrix()
+    {
+      for (std::map<std::pair<size_t, size_t>, AlignedSequenceContainer*>::iterator it = alignments_.begin(); it != alignments_.end(); ++it)
+        delete it->second;
+    }
+
+  private:
+    PairwiseAlignmentMatrix(const PairwiseAlignmentMatrix&);
+    PairwiseAlignmentMatrix& operator=(const PairwiseAlignmentMatrix&);
+
+  public:
+    size_t getNumberOfSequences() const { return n_; }
+    const std::vector<std::string>& getSequencesNames() const { return names_; }
+
+    /**
+     * @return True if the pair (i, j) was aligned.
+     */
+    bool isComputed(size_t i, size_t j) const { return computed_[i * n_ + j] != 0; }
+
+    /**
+     * @return The score of the alignment of sequences i and j, in profile units.
+     */
+    int getScore(size_t i, size_t j) const { return scores_[i * n_ + j]; }
+
+    /**
+     * @return The identity of sequences i and j, or NaN if it was not computed.
+     */
+    double getIdentity(size_t i, size_t j) const { return identities_[i * n_ + j]; }
+
+    /**
+     * @return The dense score matrix, row-major.
+     */
+    const std::vector<int>& getScores() const { return scores_; }
+
+    /**
+     * @return The dense identity matrix, row-major.
+     */
+    const std::vector<double>& getIdentities() const { return identities_; }
+
+    bool hasAlignment(size_t i, size_t j) const { return alignments_.find(key_(i, j)) != alignments_.end(); }
+
+    /**
+     * @return The alignment of sequences i and j, if it was kept. Sequence i comes first if i < j.
+     * @throw Exception If the alignment was not kept.
+     */
+    const AlignedSequenceContainer& getAlignment(size_t i, size_t j) const
+    {
+      std::map<std::pair<size_t, size_t>, AlignedSequenceContainer*>::const_iterator it = alignments_.find(key_(i, j));
+      if (it == alignments_.end())
+        throw Exception("PairwiseAlignmentMatrix::getAlignment. Alignment was not kept.");
+      return *it->second;
+    }
+
+    /*
+     * Filling methods, used by the engine. Different pairs can be set concurrently.
+     */
+    void set(size_t i, size_t j, int score, double identity)
+    {
+      scores_[i * n_ + j] = scores_[j * n_ + i] = score;
+      identities_[i * n_ + j] = identities_[j * n_ + i] = identity;
+      computed_[i * n_ + j] = computed_[j * n_ + i] = 1;
+    }
+
+    void setAlignment(size_t i, size_t j, AlignedSequenceContainer* alignment)
+    {
+      std::pair<size_t, size_t> k = key_(i, j);
+      delete alignments_[k];
+      alignments_[k] = alignment;
+    }
+
+  private:
+    static std::pair<size_t, size_t> key_(size_t i, size_t j) { return std::make_pair(std::min(i, j), std::max(i, j)); }
+  };
+
+  /**
+   * @brief Align many pairs of sequences on several threads.
+   *
+   * Sequences are checked and encoded once. Pairs are then distributed to the threads of a
+   * pool with work stealing, and each thread reuses its own alignment buffers
+   * (see AlignmentWorkspace), so that threads never share writable memory
+   * and memory is not reallocated for each pair.
+   *
+   * By default, only scores are computed, in linear memory. Identities require a traceback,
+   * and full alignments are only kept when requested.
+   */
+  class PairwiseAlignmentEngine
+  {
+  private:
+    ScoringProfile profile_;
+    int gap_;
+    unsigned int nbThreads_;
+    SimdLevel level_;
+    bool computeIdentities_;
+    bool keepAlignments_;
+
+  public:
+    /**
+     * @param profile   The substitution scores.
+     * @param gap       The score of a gap position.
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     */
+    PairwiseAlignmentEngine(const ScoringProfile& profile, int gap, unsigned int nbThreads = 0) :
+      profile_(profile),
+      gap_(gap),
+      nbThreads_(nbThreads),
+      level_(SimdSupport::getBestLevel()),
+      computeIdentities_(false),
+      keepAlignments_(false)
+    {}
+
+  public:
+    void setNumberOfThreads(unsigned int nbThreads) { nbThreads_ = nbThreads; }
+    void setSimdLevel(SimdLevel level) { level_ = level; }
+
+    /**
+     * @brief Also compute identities. This requires a traceback for each pair.
+     */
+    void setComputeIdentities(bool yn) { computeIdentities_ = yn; }
+
+    /**
+     * @brief Keep the alignment of each pair. This implies setComputeIdentities(true).
+     */
+    void setKeepAlignments(bool yn) { keepAlignments_ = yn; }
+
+    /**
+     * @brief Align all pairs of distinct sequences.
+     *
+     * @param sequences The sequences to align. They must not contain gaps.
+     * @return A new matrix with the results.
+     */
+    PairwiseAlignmentMatrix* alignAll(const OrderedSequenceContainer& sequences) const
+    {
+      size_t n = sequences.getNumberOfSequences();
+      //Pairs (i, j > i) are numbered row by row. rowStart[i] is the number of the pair (i, i + 1):
+      std::vector<size_t> rowStart(n + 1, 0);
+      for (size_t i = 0; i < n; ++i)
+        rowStart[i + 1] = rowStart[i] + (n - 1 - i);
+      size_t nbPairs = rowStart[n];
+      return run_(sequences, nbPairs, [&rowStart](size_t p) {
+        size_t i = static_cast<size_t>(std::upper_bound(rowStart.begin(), rowStart.end(), p) - rowStart.begin()) - 1;
+        return std::make_pair(i, i + 1 + (p - rowStart[i]));
+      });
+    }
+
+    /**
+     * @brief Align a list of pairs of sequences.
+     *
+     * @param sequences The sequences to align. They must not contain gaps.
+     * @param pairs     The indices of the sequences to align. Pairs given twice, in the same or in the reverse order,
+     *                  are aligned once. Kept alignments have the sequence with the smaller index first.
+     * @return A new matrix with the results.
+     * @throw IndexOutOfBoundsException If an index is not a sequence of the container.
+     * @throw Exception If pairs are given for an empty container.
+     */
+    PairwiseAlignmentMatrix* align(const OrderedSequenceContainer& sequences, const std::vector< std::pair<size_t, size_t> >& pairs) const
+    {
+      size_t n = sequences.getNumberOfSequences();
+      if (n == 0 && !pairs.empty())
+        throw Exception("PairwiseAlignmentEngine::align. The container is empty.");
+      //Both cells of a pair are written by the thread aligning it, so each pair must appear only once:
+      std::vector< std::pair<size_t, size_t> > canonical(pairs.size());
+      for (size_t p = 0; p < pairs.size(); ++p)
+      {
+        if (pairs[p].first >= n || pairs[p].second >= n)
+          throw IndexOutOfBoundsException("PairwiseAlignmentEngine::align. Invalid sequence index.", std::max(pairs[p].first, pairs[p].second), 0, n - 1);
+        canonical[p] = std::make_pair(std::min(pairs[p].first, pairs[p].second), std::max(pairs[p].first, pairs[p].second));
+      }
+      std::sort(canonical.begin(), canonical.end());
+      canonical.erase(std::unique(canonical.begin(), canonical.end()), canonical.end());
+      return run_(sequences, canonical.size(), [&canonical](size_t p) { return canonical[p]; });
+    }
+
+  private:
+    template<class PairFunction>
+    PairwiseAlignmentMatrix* run_(const OrderedSequenceContainer& sequences, size_t nbPairs, PairFunction getPair) const
+    {
+      size_t n = sequences.getNumberOfSequences();
+      const Alphabet* alphabet = sequences.getAlphabet();
+      int gapCode = alphabet->getGapCharacterCode();
+      //Sequences are only accessed here: some containers (as VectorSiteContainer) rebuild them on each call to getSequence.
+      std::vector< std::vector<int> > encoded(n);
+      for (size_t i = 0; i < n; ++i)
+        profile_.encode(sequences.getSequence(i), encoded[i]);
+      std::vector<std::string> names = sequences.getSequencesNames();
+
+      PairwiseAlignmentMatrix* results = new PairwiseAlignmentMatrix(names);
+      bool traceback = computeIdentities_ || keepAlignments_;
+      std::vector<AlignedSequenceContainer*> alignments(keepAlignments_ ? nbPairs : 0, 0);
+      try
+      {
+        ThreadPool pool(nbThreads_);
+        std::vector<AlignmentWorkspace> workspaces(pool.getNumberOfThreads());
+        std::vector< std::vector<int> > rows1(pool.getNumberOfThreads()), rows2(pool.getNumberOfThreads());
+        pool.parallelForStealing(nbPairs, [&](size_t begin, size_t end, size_t slot) {
+          AlignmentWorkspace& ws = workspaces[slot];
+          std::vector<int>& r1 = rows1[slot];
+          std::vector<int>& r2 = rows2[slot];
+          for (size_t p = begin; p < end; ++p)
+          {
+            std::pair<size_t, size_t> ij = getPair(p);
+            const std::vector<int>& a = encoded[ij.first];
+            const std::vector<int>& b = encoded[ij.second];
+            if (!traceback)
+            {
+              results->set(ij.first, ij.second, GlobalAlignmentTools::getNWScore(a, b, profile_, gap_, level_, ws), std::numeric_limits<double>::quiet_NaN());
+              continue;
+            }
+            int score = GlobalAlignmentTools::alignNW(a, b, profile_, gap_, gapCode, level_, ws, r1, r2);
+            size_t identical = 0;
+            for (size_t k = 0; k < r1.size(); ++k)
+              if (r1[k] == r2[k] && r1[k] != gapCode)
+                ++identical;
+            results->set(ij.first, ij.second, score, r1.empty() ? 0. : static_cast<double>(identical) / static_cast<double>(r1.size()));
+            if (keepAlignments_)
+            {
+              AlignedSequenceContainer* asc = new AlignedSequenceContainer(alphabet);
+              asc->addSequence(BasicSequence(names[ij.first], r1, alphabet), false);
+              asc->addSequence(BasicSequence(names[ij.second], r2, alphabet), false);
+              alignments[p] = asc;
+            }
+          }
+        }, 4);
+      }
+      catch (...)
+      {
+        for (size_t p = 0; p < alignments.size(); ++p)
+          delete alignments[p];
+        delete results;
+        throw;
+      }
+      for (size_t p = 0; p < alignments.size(); ++p)
+      {
+        std::pair<size_t, size_t> ij = getPair(p);
+        results->setAlignment(ij.first, ij.second, alignments[p]);
+      }
+      return results;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_PAIRWISEALIGNMENTENGINE_H_
@@ -0,0 +1,61 @@
+/*
+ * File: AllocationCounter.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 09:12 2026
+ */
+
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace bpp;
+
+/*
+ * Relaxed atomics are enough here: we only need the totals to be exact, not ordered.
+ */
+static std::atomic<size_t> numberOfAllocations_(0);
+static std::atomic<size_t> allocatedBytes_(0);
+
+/*
+ * Counters of each thread: as they are constant-initialized, using them in operator new does not allocate.
+ */
+static thread_local size_t threadNumberOfAllocations_ = 0;
+static thread_local size_t threadAllocatedBytes_ = 0;
+
+static void* countedAllocation(size_t size)
+{
+  numberOfAllocations_.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes_.fetch_add(size, std::memory_order_relaxed);
+  ++threadNumberOfAllocations_;
+  threadAllocatedBytes_ += size;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+AllocationSnapshot AllocationCounter::getSnapshot()
+{
+  AllocationSnapshot snapshot;
+  snapshot.numberOfAllocations = numberOfAllocations_.load(std::memory_order_relaxed);
+  snapshot.allocatedBytes = allocatedBytes_.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+AllocationSnapshot AllocationCounter::getThreadSnapshot()
+{
+  AllocationSnapshot snapshot;
+  snapshot.numberOfAllocations = threadNumberOfAllocations_;
+  snapshot.allocatedBytes = threadAllocatedBytes_;
+  return snapshot;
+}
+
+/*
+ * Replacement of the global allocation functions:
+ */
+void* operator new(size_t size) { return countedAllocation(size); }
+void* operator new[](size_t size) { return countedAllocation(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
@@ -0,0 +1,64 @@
+/*
+ * File: AllocationCounter.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 09:12 2026
+ *
+ * Global counters for heap allocations, used by the benchmark programs.
+ *
+ * Linking AllocationCounter.cpp into a program replaces the global operator new/delete,
+ * so that every allocation made by the program (including the ones made inside bpp-seq)
+ * is counted. Programs which do not link it are not affected.
+ */
+
+#ifndef _ALLOCATIONCOUNTER_H_
+#define _ALLOCATIONCOUNTER_H_
+
+#include <cstddef>
+
+namespace bpp
+{
+  /**
+   * @brief Snapshot of the global allocation counters.
+   */
+  struct AllocationSnapshot
+  {
+    size_t numberOfAllocations;
+    size_t allocatedBytes;
+  };
+
+  /**
+   * @brief Access to the global allocation counters.
+   *
+   * Counters are cumulative: to know what a piece of code allocates,
+   * take a snapshot before and after it and compute the difference.
+   */
+  class AllocationCounter
+  {
+  public:
+    /**
+     * @return The current value of the counters.
+     */
+    static AllocationSnapshot getSnapshot();
+
+    /**
+     * @return The current value of the counters of the calling thread,
+     * which only count the allocations made by this thread.
+     */
+    static AllocationSnapshot getThreadSnapshot();
+
+    /**
+     * @return The number of allocations and bytes allocated since a previous snapshot.
+     */
+    static AllocationSnapshot getDifference(const AllocationSnapshot& since)
+    {
+      AllocationSnapshot now = getSnapshot();
+      AllocationSnapshot diff;
+      diff.numberOfAllocations = now.numberOfAllocations - since.numberOfAllocations;
+      diff.allocatedBytes = now.allocatedBytes - since.allocatedBytes;
+      return diff;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_ALLOCATIONCOUNTER_H_
@@ -0,0 +1,318 @@
+/*
+ * File: BenchmarkTools.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 09:12 2026
+ *
+ * A small harness to time a piece of code with warmup, repetitions and allocation counts,
+ * and to measure the memory it uses.
+ */
+
+#ifndef _BENCHMARKTOOLS_H_
+#define _BENCHMARKTOOLS_H_
+
+#include "AllocationCounter.h"
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace bpp
+{
+  /**
+   * @brief Result of a benchmark: all timings are in milliseconds, and allocations are given per repetition.
+   */
+  struct BenchmarkResult
+  {
+    std::string name;
+    std::string target;
+    unsigned int warmup;
+    unsigned int repetitions;
+    std::vector<double> times;
+    double min;
+    double mean;
+    double median;
+    double p95;
+    double allocationsPerRepetition;
+    double bytesPerRepetition;
+  };
+
+  /**
+   * @brief Memory used by a single run of a function, in a fresh process.
+   */
+  struct MemoryResult
+  {
+    std::string name;
+    std::string target;
+    double allocations;
+    double bytesAllocated;
+    double peakBytes;
+  };
+
+  /**
+   * @brief Static tools to run benchmarks and report their results.
+   *
+   * A benchmarked function takes no argument and returns a size_t,
+   * which is accumulated in a sink so that the compiler cannot discard the work.
+   * Nothing is printed between repetitions.
+   */
+  class BenchmarkTools
+  {
+  public:
+    /**
+     * @brief Run a function 'warmup' times without measuring it, then 'repetitions' times.
+     *
+     * @param name   The name of the benchmark (e.g. "site access").
+     * @param target What is benchmarked (e.g. "VectorSiteContainer").
+     * @param f      The function to run.
+     * @param warmup The number of unmeasured runs.
+     * @param repetitions The number of measured runs.
+     * @return The timings and allocation statistics.
+     */
+    template<class F>
+    static BenchmarkResult run(const std::string& name, const std::string& target, F f, unsigned int warmup, unsigned int repetitions)
+    {
+      BenchmarkResult result;
+      result.name = name;
+      result.target = target;
+      result.warmup = warmup;
+      result.repetitions = repetitions;
+      result.times.reserve(repetitions); //so that it is not counted in the allocations.
+      for (unsigned int i = 0; i < warmup; ++i)
+        sink() += f();
+
+      AllocationSnapshot before = AllocationCounter::getSnapshot();
+      for (unsigned int i = 0; i < repetitions; ++i)
+      {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        sink() += f();
+        std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+        result.times.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+      }
+      AllocationSnapshot allocs = AllocationCounter::getDifference(before);
+      double n = static_cast<double>(std::max(repetitions, 1u));
+      result.allocationsPerRepetition = static_cast<double>(allocs.numberOfAllocations) / n;
+      result.bytesPerRepetition = static_cast<double>(allocs.allocatedBytes) / n;
+      computeStatistics(result);
+      return result;
+    }
+
+    /**
+     * @brief Same as run(), but with an unmeasured preparation before each run.
+     *
+     * 'prepare' is called before each run of 'f', and its result is given to 'f'.
+     * Neither its time nor its allocations are counted. This is useful to measure
+     * the destruction of an object, for instance.
+     *
+     * @param name    The name of the benchmark.
+     * @param target  What is benchmarked.
+     * @param prepare The function creating the input of 'f'.
+     * @param f       The function to run.
+     * @param warmup  The number of unmeasured runs.
+     * @param repetitions The number of measured runs.
+     * @return The timings and allocation statistics.
+     */
+    template<class P, class F>
+    static BenchmarkResult run(const std::string& name, const std::string& target, P prepare, F f, unsigned int warmup, unsigned int repetitions)
+    {
+      BenchmarkResult result;
+      result.name = name;
+      result.target = target;
+      result.warmup = warmup;
+      result.repetitions = repetitions;
+      result.times.reserve(repetitions);
+      for (unsigned int i = 0; i < warmup; ++i)
+        sink() += f(prepare());
+
+      size_t allocations = 0;
+      size_t bytes = 0;
+      for (unsigned int i = 0; i < repetitions; ++i)
+      {
+        auto input = prepare();
+        AllocationSnapshot before = AllocationCounter::getSnapshot();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        sink() += f(input);
+        std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+        AllocationSnapshot allocs = AllocationCounter::getDifference(before);
+        result.times.push_back(std::chrono::duration<double, std::milli>(stop - start).count());
+        allocations += allocs.numberOfAllocations;
+        bytes += allocs.allocatedBytes;
+      }
+      double n = static_cast<double>(std::max(repetitions, 1u));
+      result.allocationsPerRepetition = static_cast<double>(allocations) / n;
+      result.bytesPerRepetition = static_cast<double>(bytes) / n;
+      computeStatistics(result);
+      return result;
+    }
+
+    /**
+     * @brief Run a function once in a child process, and measure the memory it uses.
+     *
+     * Each measure starts from a fresh process, so that the peak memory of the process
+     * (which never decreases) is the one of the function, plus the memory of the program before the call.
+     *
+     * @param name   The name of the benchmark (e.g. "alignment creation").
+     * @param target What is benchmarked (e.g. "copy").
+     * @param f      The function to run.
+     * @return The number of allocations, the allocated bytes, and the peak memory of the child process.
+     * @throw Exception If the child process can not be created, or does not return a result (if f throws, for instance).
+     */
+    template<class F>
+    static MemoryResult measureMemory(const std::string& name, const std::string& target, F f)
+    {
+      int fd[2];
+      if (pipe(fd) != 0)
+        throw Exception("BenchmarkTools::measureMemory. Can't create pipe.");
+      pid_t pid = fork();
+      if (pid < 0)
+      {
+        close(fd[0]);
+        close(fd[1]);
+        throw Exception("BenchmarkTools::measureMemory. Can't create a child process.");
+      }
+      if (pid == 0)
+      {
+        //The child must never return into the caller, even if f throws: no result is written then.
+        try
+        {
+          close(fd[0]);
+          AllocationSnapshot before = AllocationCounter::getSnapshot();
+          sink() += f();
+          AllocationSnapshot allocs = AllocationCounter::getDifference(before);
+          struct rusage usage;
+          getrusage(RUSAGE_SELF, &usage);
+          //ru_maxrss is in kilobytes:
+          double values[3] = { static_cast<double>(allocs.numberOfAllocations), static_cast<double>(allocs.allocatedBytes), static_cast<double>(usage.ru_maxrss) * 1024. };
+          ssize_t written = write(fd[1], values, sizeof(values));
+          _exit(written == sizeof(values) ? 0 : 1);
+        }
+        catch (...)
+        {
+          _exit(1);
+        }
+      }
+      close(fd[1]);
+      double values[3] = { 0, 0, 0 };
+      ssize_t nread = read(fd[0], values, sizeof(values));
+      close(fd[0]);
+      waitpid(pid, 0, 0);
+      if (nread != sizeof(values))
+        throw Exception("BenchmarkTools::measureMemory. No result from the child process.");
+      MemoryResult result;
+      result.name = name;
+      result.target = target;
+      result.allocations = values[0];
+      result.bytesAllocated = values[1];
+      result.peakBytes = values[2];
+      return result;
+    }
+
+    /**
+     * @brief Print a result in the terminal.
+     */
+    static void display(const BenchmarkResult& result)
+    {
+      ApplicationTools::displayResult(result.name + " [" + result.target + "]",
+          "median " + TextTools::toString(result.median, 4) + " ms"
+          + ", p95 " + TextTools::toString(result.p95, 4) + " ms"
+          + ", " + TextTools::toString(result.bytesPerRepetition, 6) + " bytes"
+          + " in " + TextTools::toString(result.allocationsPerRepetition, 6) + " allocations");
+    }
+
+    /**
+     * @brief Print a memory result in the terminal.
+     */
+    static void display(const MemoryResult& result)
+    {
+      ApplicationTools::displayResult(result.name + " [" + result.target + "]",
+          "peak " + TextTools::toString(result.peakBytes / 1048576., 6) + " MB"
+          + ", " + TextTools::toString(result.bytesAllocated / 1048576., 6) + " MB"
+          + " in " + TextTools::toString(result.allocations, 6) + " allocations");
+    }
+
+    /**
+     * @brief Write a set of results as a JSON document.
+     *
+     * @param out     The output stream.
+     * @param context Key/value pairs describing the run (input file, sizes, ...).
+     * @param results The benchmark results.
+     */
+    static void writeJson(std::ostream& out, const std::map<std::string, std::string>& context, const std::vector<BenchmarkResult>& results)
+    {
+      out << "{" << std::endl;
+      out << "  \"context\": {";
+      for (std::map<std::string, std::string>::const_iterator it = context.begin(); it != context.end(); ++it)
+        out << (it == context.begin() ? "" : ",") << std::endl << "    \"" << escape(it->first) << "\": \"" << escape(it->second) << "\"";
+      out << std::endl << "  }," << std::endl;
+      out << "  \"benchmarks\": [";
+      for (size_t i = 0; i < results.size(); ++i)
+      {
+        const BenchmarkResult& r = results[i];
+        out << (i == 0 ? "" : ",") << std::endl;
+        out << "    {\"name\": \"" << escape(r.name) << "\", \"target\": \"" << escape(r.target) << "\""
+            << ", \"warmup\": " << r.warmup << ", \"repetitions\": " << r.repetitions
+            << ", \"min_ms\": " << r.min << ", \"mean_ms\": " << r.mean
+            << ", \"median_ms\": " << r.median << ", \"p95_ms\": " << r.p95
+            << ", \"allocations\": " << r.allocationsPerRepetition
+            << ", \"bytes_allocated\": " << r.bytesPerRepetition << "}";
+      }
+      out << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
+
+    /**
+     * @return The accumulated values returned by the benchmarked functions.
+     */
+    static volatile size_t& sink()
+    {
+      static volatile size_t value = 0;
+      return value;
+    }
+
+  private:
+    static void computeStatistics(BenchmarkResult& result)
+    {
+      std::vector<double> sorted = result.times;
+      std::sort(sorted.begin(), sorted.end());
+      if (sorted.empty())
+      {
+        result.min = result.mean = result.median = result.p95 = 0;
+        return;
+      }
+      size_t n = sorted.size();
+      result.min = sorted[0];
+      double sum = 0;
+      for (size_t i = 0; i < n; ++i)
+        sum += sorted[i];
+      result.mean = sum / static_cast<double>(n);
+      result.median = (n % 2 == 1) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.;
+      //Nearest-rank percentile:
+      size_t rank = (95 * n + 99) / 100;
+      result.p95 = sorted[std::max(rank, static_cast<size_t>(1)) - 1];
+    }
+
+    static std::string escape(const std::string& s)
+    {
+      std::string escaped;
+      for (size_t i = 0; i < s.size(); ++i)
+      {
+        if (s[i] == '"' || s[i] == '\\')
+          escaped += '\\';
+        escaped += s[i];
+      }
+      return escaped;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_BENCHMARKTOOLS_H_
@@ -0,0 +1,274 @@
+/*
+ * File: ExBenchmark.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 09:12 2026
+ *
+ * Benchmark of the sequence containers: this is the timing section of ExContainer,
+ * turned into a proper benchmark with warmup, repetitions, percentiles and allocation counts.
+ *
+ * HOW TO USE THAT FILE:
+ * - Options are passed as name=value pairs on the command line, for instance:
+ *   ./exbenchmark input.sequence.file=../ExContainer/TIMnuc.aln.fasta bench.repetitions=50
+ * - Synthetic alignments of any size can be benchmarked with:
+ *   ./exbenchmark input.synthetic.sequences=10000 input.synthetic.sites=5000
+ * - Available options (and default values):
+ *   input.sequence.file        = ../ExContainer/TIMnuc.aln.fasta
+ *   input.synthetic.sequences  = 0 (if > 0, a synthetic alignment is generated instead of reading input.sequence.file)
+ *   input.synthetic.sites      = 1000
+ *   input.synthetic.divergence = 0.1
+ *   input.synthetic.gaps       = 0.05
+ *   input.synthetic.seed       = 42
+ *   input.synthetic.file       = synthetic.aln.fasta (where the synthetic alignment is written, for the Fasta load benchmark)
+ *   bench.warmup               = 3
+ *   bench.repetitions          = 20
+ *   memory.synthetic.sequences = 1000 (0 to disable the memory benchmark)
+ *   memory.synthetic.sites     = 20000
+ *   output.json.file           = benchmark.json ('none' to disable)
+ *
+ * The memory benchmark creates an alignment from a synthetic container of
+ * memory.synthetic.sequences x memory.synthetic.sites states, by copying or by moving the sequences,
+ * each in a child process. WATCHOUT!!! reduce these numbers if you lack memory!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * From the STL:
+ */
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * From bpp-core:
+ */
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/App/AttributesTools.h>
+
+/*
+ * The benchmark tools:
+ */
+#include "BenchmarkTools.h"
+#include "SyntheticAlignment.h"
+#include "MappedFasta.h" /* from ExContainer */
+#include "SequenceMoveTools.h" /* from ExContainer */
+#include "PackedSequence.h" /* from ExPackedSequence */
+
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * The benchmarked operations. Each of them returns a value depending on the work done,
+ * so that it can not be optimized away.
+ */
+static size_t accessSequences(const SiteContainer& sc)
+{
+  size_t n = 0;
+  for (size_t i = 0; i < sc.getNumberOfSequences(); ++i)
+    n += sc.getSequence(i).size();
+  return n;
+}
+
+static size_t accessSites(const SiteContainer& sc)
+{
+  size_t n = 0;
+  for (size_t i = 0; i < sc.getNumberOfSites(); ++i)
+    n += sc.getSite(i).size();
+  return n;
+}
+
+/*
+ * Packed alignments are decoded into a buffer which is reused between calls:
+ */
+static size_t accessSequences(const PackedAlignment& pa, vector<int>& buffer)
+{
+  size_t n = 0;
+  for (size_t i = 0; i < pa.getNumberOfSequences(); ++i)
+  {
+    pa.getSequenceContent(i, buffer);
+    n += buffer.size();
+  }
+  return n;
+}
+
+static size_t accessSites(const PackedAlignment& pa, vector<int>& buffer)
+{
+  size_t n = 0;
+  for (size_t i = 0; i < pa.getNumberOfSites(); ++i)
+  {
+    pa.getSiteContent(i, buffer);
+    n += buffer.size();
+  }
+  return n;
+}
+
+template<class C>
+static size_t construct(const OrderedSequenceContainer& sequences)
+{
+  C* sc = new C(sequences);
+  size_t n = sc->getNumberOfSites();
+  delete sc;
+  return n;
+}
+
+template<class C>
+static size_t load(const Fasta& fasReader, const string& path, const Alphabet* alphabet)
+{
+  C* sc = new C(alphabet);
+  fasReader.readSequences(path, *sc);
+  size_t n = sc->getNumberOfSites();
+  delete sc;
+  return n;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+
+int main(int args, char** argv)
+{
+  try
+  {
+    map<string, string> params = AttributesTools::parseOptions(args, argv);
+    string path = ApplicationTools::getStringParameter("input.sequence.file", params, "../ExContainer/TIMnuc.aln.fasta");
+    int nbSynthSeq = ApplicationTools::getIntParameter("input.synthetic.sequences", params, 0);
+    unsigned int warmup = static_cast<unsigned int>(ApplicationTools::getIntParameter("bench.warmup", params, 3));
+    unsigned int nrep = static_cast<unsigned int>(ApplicationTools::getIntParameter("bench.repetitions", params, 20));
+    int nbMemorySeq = ApplicationTools::getIntParameter("memory.synthetic.sequences", params, 1000);
+    int nbMemorySites = ApplicationTools::getIntParameter("memory.synthetic.sites", params, 20000);
+    string jsonPath = ApplicationTools::getStringParameter("output.json.file", params, "benchmark.json");
+
+    const Alphabet* alphabet = &AlphabetTools::DNA_ALPHABET;
+    Fasta fasReader;
+    OrderedSequenceContainer* sequences = 0;
+    if (nbSynthSeq > 0)
+    {
+      int nbSynthSites = ApplicationTools::getIntParameter("input.synthetic.sites", params, 1000);
+      double divergence = ApplicationTools::getDoubleParameter("input.synthetic.divergence", params, 0.1);
+      double gaps = ApplicationTools::getDoubleParameter("input.synthetic.gaps", params, 0.05);
+      unsigned int seed = static_cast<unsigned int>(ApplicationTools::getIntParameter("input.synthetic.seed", params, 42));
+      path = ApplicationTools::getStringParameter("input.synthetic.file", params, "synthetic.aln.fasta");
+      ApplicationTools::displayTask("Generating synthetic alignment");
+      sequences = SyntheticAlignment::generate(static_cast<size_t>(nbSynthSeq), static_cast<size_t>(nbSynthSites), alphabet, divergence, gaps, 5., seed);
+      fasReader.writeSequences(path, *sequences, true);
+      ApplicationTools::displayTaskDone();
+    }
+    else
+    {
+      sequences = fasReader.readSequences(path, alphabet);
+    }
+    size_t nbSeq = sequences->getNumberOfSequences();
+    size_t nbSites = nbSeq > 0 ? sequences->getSequence(0).size() : 0;
+    ApplicationTools::displayResult("Alignment file", path);
+    ApplicationTools::displayResult("Number of sequences", nbSeq);
+    ApplicationTools::displayResult("Number of sites", nbSites);
+    ApplicationTools::displayResult("Warmup / repetitions", TextTools::toString(warmup) + " / " + TextTools::toString(nrep));
+
+    SiteContainer* align = new AlignedSequenceContainer(*sequences);
+    SiteContainer* sites = new VectorSiteContainer(*sequences);
+    PackedAlignment packed(*sequences);
+    vector<int> buffer;
+
+    vector<BenchmarkResult> results;
+    results.push_back(BenchmarkTools::run("sequence access", "AlignedSequenceContainer",
+        [&]() { return accessSequences(*align); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("sequence access", "VectorSiteContainer",
+        [&]() { return accessSequences(*sites); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("sequence access", "PackedAlignment",
+        [&]() { return accessSequences(packed, buffer); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("site access", "AlignedSequenceContainer",
+        [&]() { return accessSites(*align); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("site access", "VectorSiteContainer",
+        [&]() { return accessSites(*sites); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("site access", "PackedAlignment",
+        [&]() { return accessSites(packed, buffer); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("construction", "AlignedSequenceContainer",
+        [&]() { return construct<AlignedSequenceContainer>(*sequences); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("construction", "VectorSiteContainer",
+        [&]() { return construct<VectorSiteContainer>(*sequences); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("construction", "PackedAlignment",
+        [&]() { return PackedAlignment(*sequences).getNumberOfSites(); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("fasta load", "AlignedSequenceContainer",
+        [&]() { return load<AlignedSequenceContainer>(fasReader, path, alphabet); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("fasta load", "VectorSiteContainer",
+        [&]() { return load<VectorSiteContainer>(fasReader, path, alphabet); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("mapped fasta load", "VectorSequenceContainer",
+        [&]() { OrderedSequenceContainer* sc = MappedFasta::readSequences(path, alphabet); size_t n = sc->getNumberOfSequences(); delete sc; return n; }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("mapped fasta load", "VectorSiteContainer",
+        [&]() { SiteContainer* sc = MappedFasta::readAlignment(path, alphabet); size_t n = sc->getNumberOfSites(); delete sc; return n; }, warmup, nrep));
+
+    for (size_t i = 0; i < results.size(); ++i)
+      BenchmarkTools::display(results[i]);
+
+    /*
+     * Creating an AlignedSequenceContainer from a container copies all sequences, and doubles the peak memory.
+     * If the original container is not used afterwards, the sequences can be moved instead.
+     * (Note that this is not possible with a VectorSiteContainer, which stores the sites and not the sequences.)
+     */
+    vector<MemoryResult> memoryResults;
+    if (nbMemorySeq > 0)
+    {
+      size_t nbMemSeq = static_cast<size_t>(nbMemorySeq);
+      size_t nbMemSites = static_cast<size_t>(nbMemorySites);
+      memoryResults.push_back(BenchmarkTools::measureMemory("alignment creation", "copy", [&]() {
+        unique_ptr<OrderedSequenceContainer> synthetic(SyntheticAlignment::generate(nbMemSeq, nbMemSites, alphabet));
+        unique_ptr<SiteContainer> copy(new AlignedSequenceContainer(*synthetic));
+        return copy->getNumberOfSites();
+      }));
+      memoryResults.push_back(BenchmarkTools::measureMemory("alignment creation", "move", [&]() {
+        unique_ptr<OrderedSequenceContainer> synthetic(SyntheticAlignment::generate(nbMemSeq, nbMemSites, alphabet));
+        unique_ptr<SiteContainer> moved(SequenceMoveTools::moveToAlignment(std::move(synthetic)));
+        return moved->getNumberOfSites();
+      }));
+      for (size_t i = 0; i < memoryResults.size(); ++i)
+        BenchmarkTools::display(memoryResults[i]);
+    }
+
+    if (jsonPath != "none")
+    {
+      map<string, string> context;
+      context["input.sequence.file"] = path;
+      context["number_of_sequences"] = TextTools::toString(nbSeq);
+      context["number_of_sites"] = TextTools::toString(nbSites);
+      context["packed_bits_per_state"] = TextTools::toString(packed.getNumberOfBitsPerState());
+      context["packed_bytes"] = TextTools::toString(packed.getMemoryUsage());
+      context["unpacked_bytes"] = TextTools::toString(nbSeq * nbSites * sizeof(int));
+      for (size_t i = 0; i < memoryResults.size(); ++i)
+        context["memory_peak_bytes_" + memoryResults[i].target] = TextTools::toString(memoryResults[i].peakBytes, 12);
+      ofstream json(jsonPath.c_str(), ios::out);
+      BenchmarkTools::writeJson(json, context, results);
+      ApplicationTools::displayResult("JSON report written to", jsonPath);
+    }
+
+    delete sequences;
+    delete align;
+    delete sites;
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,377 @@
+/*
+ * File: Instrumentation.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 05:10 2026
+ *
+ * Optional counters and timers in the hot paths of the examples, enabled at compile time.
+ *
+ * The hot paths of the example classes (Fasta parsing, state encoding, sequence cloning,
+ * site transposition, alignment, translation) are marked with the BPP_INSTRUMENT_SCOPE
+ * and BPP_INSTRUMENT_COUNT macros. Unless BPP_INSTRUMENTATION is defined, these macros
+ * expand to nothing, and the instrumented code is exactly the original code.
+ *
+ * When BPP_INSTRUMENTATION is defined, AllocationCounter.cpp must be linked into the program,
+ * so that the allocations made in each scope can be counted. All Makefiles of the examples
+ * do so with 'make INSTRUMENTATION=1'.
+ */
+
+#ifndef _INSTRUMENTATION_H_
+#define _INSTRUMENTATION_H_
+
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#ifdef BPP_INSTRUMENTATION
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace bpp
+{
+  /**
+   * @brief Totals of one category of instrumented code, for one thread or for the whole program.
+   *
+   * Times and allocations are inclusive: they contain everything done inside the scopes,
+   * including nested scopes of other categories (e.g. the encoding done while parsing a file).
+   * Nested scopes of the same category are only counted once.
+   */
+  struct InstrumentationTotals
+  {
+    size_t calls;
+    size_t items;
+    double milliseconds;
+    size_t allocations;
+    size_t allocatedBytes;
+  };
+
+  /**
+   * @brief Access to the instrumentation counters, and reports.
+   *
+   * Each thread has its own counters, so that instrumented code never waits for a lock.
+   * The counters of threads which have finished are kept until the end of the program.
+   *
+   * A report of the whole run can be printed with display(), or written as JSON or CSV.
+   * If the BPP_INSTRUMENTATION_REPORT environment variable is set to a file name when the program
+   * exits, the report is also written to that file: as CSV if its name ends with ".csv", as JSON otherwise.
+   */
+  class Instrumentation
+  {
+  public:
+    enum Category
+    {
+      PARSE = 0,     //!< Reading sequences from a file, items are sequences.
+      ENCODE = 1,    //!< Converting characters or states to another encoding, items are states.
+      CLONE = 2,     //!< Copying sequences into a container, items are sequences.
+      TRANSPOSE = 3, //!< Converting rows to columns, items are states.
+      ALIGN = 4,     //!< Pairwise alignment, items are cells of the dynamic programming matrix.
+      TRANSLATE = 5, //!< Translating nucleotides to proteins, items are codons.
+      NUMBER_OF_CATEGORIES = 6
+    };
+
+    static const char* getCategoryName(Category category)
+    {
+      static const char* names[NUMBER_OF_CATEGORIES] = { "parse", "encode", "clone", "transpose", "align", "translate" };
+      return names[category];
+    }
+
+    /**
+     * @return True if the program was compiled with BPP_INSTRUMENTATION.
+     */
+    static bool isEnabled()
+    {
+#ifdef BPP_INSTRUMENTATION
+      return true;
+#else
+      return false;
+#endif
+    }
+
+#ifdef BPP_INSTRUMENTATION
+    /**
+     * @brief The counters of one thread.
+     *
+     * Each counter is only written by its thread, so that relaxed loads and stores are enough:
+     * atomics are only used so that reports can be written while other threads run.
+     */
+    struct ThreadCounters
+    {
+      size_t thread;
+      std::atomic<size_t> calls[NUMBER_OF_CATEGORIES];
+      std::atomic<size_t> items[NUMBER_OF_CATEGORIES];
+      std::atomic<size_t> nanoseconds[NUMBER_OF_CATEGORIES];
+      std::atomic<size_t> allocations[NUMBER_OF_CATEGORIES];
+      std::atomic<size_t> allocatedBytes[NUMBER_OF_CATEGORIES];
+      unsigned int depth[NUMBER_OF_CATEGORIES];
+
+      explicit ThreadCounters(size_t index) : thread(index)
+      {
+        for (size_t c = 0; c < NUMBER_OF_CATEGORIES; ++c)
+        {
+          calls[c].store(0); items[c].store(0); nanoseconds[c].store(0);
+          allocations[c].store(0); allocatedBytes[c].store(0);
+          depth[c] = 0;
+        }
+      }
+
+      static void add(std::atomic<size_t>& counter, size_t value)
+      {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+      }
+    };
+
+    /**
+     * @return The counters of the calling thread, created at its first call.
+     */
+    static ThreadCounters& getThreadCounters()
+    {
+      static thread_local ThreadCounters* counters = 0;
+      if (!counters)
+      {
+        Registry& registry = getRegistry_();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.threads.push_back(std::unique_ptr<ThreadCounters>(new ThreadCounters(registry.threads.size())));
+        counters = registry.threads.back().get();
+      }
+      return *counters;
+    }
+#endif
+
+    /**
+     * @brief Add a number of processed items to a category, for the calling thread.
+     *
+     * Use the BPP_INSTRUMENT_COUNT macro rather than this function, so that the call disappears when instrumentation is disabled.
+     */
+    static void count(Category category, size_t items)
+    {
+#ifdef BPP_INSTRUMENTATION
+      ThreadCounters::add(getThreadCounters().items[category], items);
+#else
+      (void)category; (void)items;
+#endif
+    }
+
+    /**
+     * @return The totals of a category, over all threads (thread = -1) or for one thread (in order of first use).
+     */
+    static InstrumentationTotals getTotals(Category category, long thread = -1)
+    {
+      InstrumentationTotals totals = { 0, 0, 0., 0, 0 };
+#ifdef BPP_INSTRUMENTATION
+      Registry& registry = getRegistry_();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      for (size_t t = 0; t < registry.threads.size(); ++t)
+      {
+        if (thread >= 0 && static_cast<size_t>(thread) != t)
+          continue;
+        const ThreadCounters& c = *registry.threads[t];
+        totals.calls += c.calls[category].load(std::memory_order_relaxed);
+        totals.items += c.items[category].load(std::memory_order_relaxed);
+        totals.milliseconds += static_cast<double>(c.nanoseconds[category].load(std::memory_order_relaxed)) / 1e6;
+        totals.allocations += c.allocations[category].load(std::memory_order_relaxed);
+        totals.allocatedBytes += c.allocatedBytes[category].load(std::memory_order_relaxed);
+      }
+#else
+      (void)category; (void)thread;
+#endif
+      return totals;
+    }
+
+    /**
+     * @return The number of threads which ran instrumented code.
+     */
+    static size_t getNumberOfThreads()
+    {
+#ifdef BPP_INSTRUMENTATION
+      Registry& registry = getRegistry_();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      return registry.threads.size();
+#else
+      return 0;
+#endif
+    }
+
+    /**
+     * @brief Print the totals of each category in the terminal.
+     */
+    static void display()
+    {
+      if (!isEnabled())
+      {
+        ApplicationTools::displayMessage("Instrumentation is disabled (build with 'make INSTRUMENTATION=1' to enable it).");
+        return;
+      }
+      ApplicationTools::displayMessage("Instrumentation report (" + TextTools::toString(getNumberOfThreads()) + " thread(s)):");
+      for (size_t c = 0; c < NUMBER_OF_CATEGORIES; ++c)
+      {
+        Category category = static_cast<Category>(c);
+        InstrumentationTotals t = getTotals(category);
+        if (t.calls == 0)
+          continue;
+        ApplicationTools::displayResult(std::string("  ") + getCategoryName(category),
+            TextTools::toString(t.calls) + " calls, " + TextTools::toString(t.items) + " items, "
+            + TextTools::toString(t.milliseconds, 6) + " ms, "
+            + TextTools::toString(t.allocatedBytes) + " bytes in " + TextTools::toString(t.allocations) + " allocations");
+      }
+    }
+
+    /**
+     * @brief Write the totals of each category, for each thread and for the whole program, as a JSON document.
+     */
+    static void writeJson(std::ostream& out)
+    {
+      size_t nbThreads = getNumberOfThreads();
+      out << "{" << std::endl;
+      out << "  \"enabled\": " << (isEnabled() ? "true" : "false") << "," << std::endl;
+      out << "  \"threads\": " << nbThreads << "," << std::endl;
+      out << "  \"categories\": [";
+      for (size_t c = 0; c < NUMBER_OF_CATEGORIES; ++c)
+      {
+        Category category = static_cast<Category>(c);
+        out << (c == 0 ? "" : ",") << std::endl;
+        out << "    {\"name\": \"" << getCategoryName(category) << "\", \"total\": ";
+        writeJsonTotals_(out, getTotals(category));
+        out << ", \"per_thread\": [";
+        for (size_t t = 0; t < nbThreads; ++t)
+        {
+          out << (t == 0 ? "" : ", ");
+          writeJsonTotals_(out, getTotals(category, static_cast<long>(t)));
+        }
+        out << "]}";
+      }
+      out << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
+
+    /**
+     * @brief Write the totals of each category as CSV, one line per thread and one line for the whole program (thread "all").
+     */
+    static void writeCsv(std::ostream& out)
+    {
+      size_t nbThreads = getNumberOfThreads();
+      out << "category,thread,calls,items,milliseconds,allocations,bytes_allocated" << std::endl;
+      for (size_t c = 0; c < NUMBER_OF_CATEGORIES; ++c)
+      {
+        Category category = static_cast<Category>(c);
+        writeCsvLine_(out, category, "all", getTotals(category));
+        for (size_t t = 0; t < nbThreads; ++t)
+          writeCsvLine_(out, category, TextTools::toString(t), getTotals(category, static_cast<long>(t)));
+      }
+    }
+
+  private:
+    static void writeJsonTotals_(std::ostream& out, const InstrumentationTotals& t)
+    {
+      out << "{\"calls\": " << t.calls << ", \"items\": " << t.items << ", \"ms\": " << t.milliseconds
+          << ", \"allocations\": " << t.allocations << ", \"bytes_allocated\": " << t.allocatedBytes << "}";
+    }
+
+    static void writeCsvLine_(std::ostream& out, Category category, const std::string& thread, const InstrumentationTotals& t)
+    {
+      out << getCategoryName(category) << "," << thread << "," << t.calls << "," << t.items << "," << t.milliseconds
+          << "," << t.allocations << "," << t.allocatedBytes << std::endl;
+    }
+
+#ifdef BPP_INSTRUMENTATION
+    /*
+     * Counters of all threads. The registry is destroyed at exit: the report file, if one was requested,
+     * is written at that time, while its members are still alive.
+     */
+    struct Registry
+    {
+      std::mutex mutex;
+      std::vector< std::unique_ptr<ThreadCounters> > threads;
+
+      ~Registry()
+      {
+        const char* path = std::getenv("BPP_INSTRUMENTATION_REPORT");
+        if (!path || !*path)
+          return;
+        std::string file(path);
+        std::ofstream out(file.c_str());
+        if (file.size() >= 4 && file.compare(file.size() - 4, 4, ".csv") == 0)
+          Instrumentation::writeCsv(out);
+        else
+          Instrumentation::writeJson(out);
+      }
+    };
+
+    static Registry& getRegistry_()
+    {
+      static Registry registry;
+      return registry;
+    }
+
+    friend class InstrumentationScope;
+#endif
+  };
+
+#ifdef BPP_INSTRUMENTATION
+  /**
+   * @brief Measure the time and allocations of the calling thread, from its creation to its destruction.
+   */
+  class InstrumentationScope
+  {
+  private:
+    Instrumentation::Category category_;
+    Instrumentation::ThreadCounters& counters_;
+    bool outermost_;
+    AllocationSnapshot allocations_;
+    std::chrono::steady_clock::time_point start_;
+
+  public:
+    explicit InstrumentationScope(Instrumentation::Category category) :
+      category_(category),
+      counters_(Instrumentation::getThreadCounters()),
+      outermost_(counters_.depth[category]++ == 0),
+      allocations_(AllocationCounter::getThreadSnapshot()),
+      start_(std::chrono::steady_clock::now())
+    {}
+
+    ~InstrumentationScope()
+    {
+      --counters_.depth[category_];
+      if (!outermost_)
+        return;
+      std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+      AllocationSnapshot allocations = AllocationCounter::getThreadSnapshot();
+      typedef Instrumentation::ThreadCounters Counters;
+      Counters::add(counters_.calls[category_], 1);
+      Counters::add(counters_.nanoseconds[category_],
+          static_cast<size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start_).count()));
+      Counters::add(counters_.allocations[category_], allocations.numberOfAllocations - allocations_.numberOfAllocations);
+      Counters::add(counters_.allocatedBytes[category_], allocations.allocatedBytes - allocations_.allocatedBytes);
+    }
+
+  private:
+    InstrumentationScope(const InstrumentationScope&);
+    InstrumentationScope& operator=(const InstrumentationScope&);
+  };
+
+#define BPP_INSTRUMENT_CONCAT_(a, b) a##b
+#define BPP_INSTRUMENT_NAME_(line) BPP_INSTRUMENT_CONCAT_(bppInstrumentationScope, line)
+/**
+ * @brief Measure the rest of the enclosing block, in a category of Instrumentation (e.g. BPP_INSTRUMENT_SCOPE(PARSE)).
+ */
+#define BPP_INSTRUMENT_SCOPE(category) bpp::InstrumentationScope BPP_INSTRUMENT_NAME_(__LINE__)(bpp::Instrumentation::category)
+/**
+ * @brief Add a number of processed items to a category of Instrumentation. The number is not evaluated when instrumentation is disabled.
+ */
+#define BPP_INSTRUMENT_COUNT(category, n) bpp::Instrumentation::count(bpp::Instrumentation::category, (n))
+#else
+#define BPP_INSTRUMENT_SCOPE(category)
+#define BPP_INSTRUMENT_COUNT(category, n)
+#endif
+
+} //end of namespace bpp.
+
+#endif //_INSTRUMENTATION_H_
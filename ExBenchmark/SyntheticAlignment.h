@@ -0,0 +1,87 @@
+/*
+ * File: SyntheticAlignment.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 09:12 2026
+ *
+ * Generation of random alignments of arbitrary size, for benchmarking purposes.
+ */
+
+#ifndef _SYNTHETICALIGNMENT_H_
+#define _SYNTHETICALIGNMENT_H_
+
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Generates random aligned sequences.
+   *
+   * A random ancestral sequence is drawn, and each sequence is derived from it by
+   * substituting each position with probability 'divergence', and by inserting
+   * gap runs of mean length 'meanGapLength' so that a fraction 'gapFraction' of
+   * the positions are gaps on average. The same seed always produces the same alignment.
+   */
+  class SyntheticAlignment
+  {
+  public:
+    /**
+     * @param nbSequences   The number of sequences to generate.
+     * @param nbSites       The length of the alignment.
+     * @param alphabet      The alphabet to use. Only resolved states are drawn.
+     * @param divergence    The probability that a position differs from the ancestral sequence.
+     * @param gapFraction   The expected proportion of gaps.
+     * @param meanGapLength The mean length of gap runs.
+     * @param seed          The seed of the random generator.
+     * @return A new container with the generated sequences, named Seq_1 to Seq_n.
+     */
+    static VectorSequenceContainer* generate(
+        size_t nbSequences,
+        size_t nbSites,
+        const Alphabet* alphabet,
+        double divergence = 0.1,
+        double gapFraction = 0.05,
+        double meanGapLength = 5.,
+        unsigned int seed = 42)
+    {
+      std::mt19937 rng(seed);
+      std::uniform_int_distribution<int> state(0, static_cast<int>(alphabet->getSize()) - 1);
+      std::uniform_real_distribution<double> unif(0., 1.);
+      double gapOpening = gapFraction / meanGapLength;
+      double gapExtension = 1. - 1. / meanGapLength;
+
+      std::vector<int> ancestor(nbSites);
+      for (size_t j = 0; j < nbSites; ++j)
+        ancestor[j] = state(rng);
+
+      VectorSequenceContainer* sequences = new VectorSequenceContainer(alphabet);
+      std::vector<int> content(nbSites);
+      for (size_t i = 0; i < nbSequences; ++i)
+      {
+        bool inGap = false;
+        for (size_t j = 0; j < nbSites; ++j)
+        {
+          inGap = inGap ? (unif(rng) < gapExtension) : (unif(rng) < gapOpening);
+          if (inGap)
+            content[j] = alphabet->getGapCharacterCode();
+          else if (unif(rng) < divergence)
+            content[j] = state(rng);
+          else
+            content[j] = ancestor[j];
+        }
+        BasicSequence seq("Seq_" + TextTools::toString(i + 1), content, alphabet);
+        sequences->addSequence(seq, false);
+      }
+      return sequences;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_SYNTHETICALIGNMENT_H_
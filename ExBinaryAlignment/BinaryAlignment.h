@@ -0,0 +1,667 @@
+/*
+ * File: BinaryAlignment.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 04:20 2026
+ *
+ * A binary file format for alignments, mapped in memory for loading and random access.
+ */
+
+#ifndef _BINARYALIGNMENT_H_
+#define _BINARYALIGNMENT_H_
+
+#include "SequenceMoveTools.h" /* from ExContainer */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/SequenceExceptions.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace bpp
+{
+  /**
+   * @brief Binary alignment files, written with write() and mapped in memory for reading.
+   *
+   * States are packed with 2 bits (DNA or RNA alignments with resolved nucleotides only), 4 bits (other DNA or RNA
+   * alignments) or 8 bits (proteins) per state. The alignment can be stored twice:
+   * - by sequences: sequence i is a run of words, padded to a whole number of 64 bits words;
+   * - by sites: site j is a run of words, as in PackedAlignment.
+   * Each layout is split in blocks (of 64 sequences and 1024 sites by default), which are optionally compressed
+   * with zlib. An index after the header gives the position and size of each block, so that any sequence,
+   * part of a sequence or site is found without reading the rest of the file. Uncompressed blocks are read directly
+   * from the mapped file, compressed ones are decompressed on demand.
+   *
+   * The file starts with:
+   * - the header: magic "BPPALIGN", version, alphabet (0: DNA, 1: RNA, 2: proteins), bits per state, layouts and sizes,
+   * - the offsets of the names and their characters, padded to 8 bytes,
+   * - the index of the blocks of sequences, then of sites: offset and size in bytes of each block,
+   * - the blocks, each starting at an offset multiple of 8 bytes.
+   * Files are only valid on machines with the same endianness.
+   */
+  class BinaryAlignment
+  {
+  public:
+    enum Layout { LAYOUT_SEQUENCES = 1, LAYOUT_SITES = 2, LAYOUT_BOTH = 3 };
+
+  private:
+    struct Header
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t alphabet;
+      uint32_t bits;
+      uint32_t layouts;
+      uint64_t nbSequences;
+      uint64_t nbSites;
+      uint64_t sequencesPerBlock;
+      uint64_t sitesPerBlock;
+      uint64_t nbNameChars;
+      uint64_t wordsPerSequence;
+      uint64_t wordsPerSite;
+    };
+
+    struct Block
+    {
+      uint64_t offset;
+      uint64_t size; //Compressed size, or size of the words if the block is not compressed.
+    };
+
+    enum { VERSION = 1 };
+
+    const Alphabet* alphabet_;
+    Header header_;
+    size_t nbSequenceBlocks_;
+    size_t nbSiteBlocks_;
+    const uint64_t* nameOffsets_;
+    const char* nameChars_;
+    const Block* sequenceBlocks_;
+    const Block* siteBlocks_;
+    const char* data_;
+    size_t size_;
+
+  public:
+    /**
+     * @brief Map a file written with write().
+     *
+     * Only the header and index are checked at this point: blocks are read when they are needed.
+     *
+     * @param path The file to map.
+     * @throw IOException If the file can't be mapped, or is not a valid alignment file.
+     */
+    explicit BinaryAlignment(const std::string& path) :
+      alphabet_(0), header_(), nbSequenceBlocks_(0), nbSiteBlocks_(0),
+      nameOffsets_(0), nameChars_(0), sequenceBlocks_(0), siteBlocks_(0), data_(0), size_(0)
+    {
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        throw IOException("BinaryAlignment: can't open file " + path);
+      struct stat st;
+      if (::fstat(fd, &st) != 0)
+      {
+        ::close(fd);
+        throw IOException("BinaryAlignment: can't stat file " + path);
+      }
+      size_ = static_cast<size_t>(st.st_size);
+      if (size_ < sizeof(Header))
+      {
+        ::close(fd);
+        throw IOException("BinaryAlignment: not an alignment file: " + path);
+      }
+      void* map = ::mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if (map == MAP_FAILED)
+        throw IOException("BinaryAlignment: can't map file " + path);
+      data_ = static_cast<const char*>(map);
+      try
+      {
+        fixPointers_(path);
+      }
+      catch (...)
+      {
+        ::munmap(const_cast<char*>(data_), size_);
+        throw;
+      }
+    }
+
+    ~BinaryAlignment()
+    {
+      if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+
+  private:
+    BinaryAlignment(const BinaryAlignment&);
+    BinaryAlignment& operator=(const BinaryAlignment&);
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t getNumberOfSequences() const { return static_cast<size_t>(header_.nbSequences); }
+    size_t getNumberOfSites() const { return static_cast<size_t>(header_.nbSites); }
+    unsigned int getNumberOfBitsPerState() const { return header_.bits; }
+    bool hasSequences() const { return (header_.layouts & LAYOUT_SEQUENCES) != 0; }
+    bool hasSites() const { return (header_.layouts & LAYOUT_SITES) != 0; }
+
+    /**
+     * @return True if at least one block is compressed.
+     */
+    bool isCompressed() const
+    {
+      for (size_t b = 0; b < nbSequenceBlocks_; ++b)
+        if (sequenceBlocks_[b].size != getSequenceBlockWords_(b) * sizeof(uint64_t))
+          return true;
+      for (size_t b = 0; b < nbSiteBlocks_; ++b)
+        if (siteBlocks_[b].size != getSiteBlockWords_(b) * sizeof(uint64_t))
+          return true;
+      return false;
+    }
+
+    std::string getName(size_t i) const
+    {
+      checkSequence_(i);
+      return std::string(nameChars_ + nameOffsets_[i], static_cast<size_t>(nameOffsets_[i + 1] - nameOffsets_[i]));
+    }
+
+    std::vector<std::string> getNames() const
+    {
+      std::vector<std::string> names(getNumberOfSequences());
+      for (size_t i = 0; i < names.size(); ++i)
+        names[i] = getName(i);
+      return names;
+    }
+
+    /**
+     * @brief Decode the ith sequence into a vector, which is resized if needed.
+     */
+    void getSequenceContent(size_t i, std::vector<int>& content) const
+    {
+      getSequenceContent(i, 0, getNumberOfSites(), content);
+    }
+
+    /**
+     * @brief Decode positions [begin, end) of the ith sequence into a vector, which is resized if needed.
+     *
+     * If the file stores the sequences, only the words holding these positions are read (or the block of sequences
+     * is decompressed). Otherwise, the sequence is gathered from the blocks of sites.
+     *
+     * @throw IndexOutOfBoundsException If the sequence or positions are not in the alignment.
+     */
+    void getSequenceContent(size_t i, size_t begin, size_t end, std::vector<int>& content) const
+    {
+      checkSequence_(i);
+      if (begin > end || end > getNumberOfSites())
+        throw IndexOutOfBoundsException("BinaryAlignment::getSequenceContent. Bad range.", end, begin, getNumberOfSites());
+      content.resize(end - begin);
+      if (begin == end)
+        return;
+      std::vector<uint64_t> buffer;
+      if (hasSequences())
+      {
+        size_t b = i / header_.sequencesPerBlock;
+        const uint64_t* block = getBlock_(sequenceBlocks_[b], getSequenceBlockWords_(b), buffer);
+        const uint64_t* words = block + (i - b * header_.sequencesPerBlock) * header_.wordsPerSequence;
+        unpack_(words, begin, end - begin, &content[0]);
+        return;
+      }
+      for (size_t b = begin / header_.sitesPerBlock; b * header_.sitesPerBlock < end; ++b)
+      {
+        const uint64_t* block = getBlock_(siteBlocks_[b], getSiteBlockWords_(b), buffer);
+        size_t first = std::max(begin, static_cast<size_t>(b * header_.sitesPerBlock));
+        size_t last = std::min(end, static_cast<size_t>((b + 1) * header_.sitesPerBlock));
+        for (size_t j = first; j < last; ++j)
+        {
+          const uint64_t* words = block + (j - b * header_.sitesPerBlock) * header_.wordsPerSite;
+          unpack_(words, i, 1, &content[j - begin]);
+        }
+      }
+    }
+
+    /**
+     * @brief Decode the jth site into a vector, which is resized if needed.
+     *
+     * If the file does not store the sites, the site is gathered from all the blocks of sequences:
+     * use readSites() to get all sites.
+     *
+     * @throw IndexOutOfBoundsException If the site is not in the alignment.
+     */
+    void getSiteContent(size_t j, std::vector<int>& content) const
+    {
+      if (j >= getNumberOfSites())
+        throw IndexOutOfBoundsException("BinaryAlignment::getSiteContent.", j, 0, getNumberOfSites() - 1);
+      content.resize(getNumberOfSequences());
+      if (content.empty())
+        return;
+      std::vector<uint64_t> buffer;
+      if (hasSites())
+      {
+        size_t b = j / header_.sitesPerBlock;
+        const uint64_t* block = getBlock_(siteBlocks_[b], getSiteBlockWords_(b), buffer);
+        unpack_(block + (j - b * header_.sitesPerBlock) * header_.wordsPerSite, 0, content.size(), &content[0]);
+        return;
+      }
+      for (size_t b = 0; b < nbSequenceBlocks_; ++b)
+      {
+        const uint64_t* block = getBlock_(sequenceBlocks_[b], getSequenceBlockWords_(b), buffer);
+        size_t first = b * static_cast<size_t>(header_.sequencesPerBlock);
+        size_t last = first + std::min(static_cast<size_t>(header_.sequencesPerBlock), getNumberOfSequences() - first);
+        for (size_t i = first; i < last; ++i)
+          unpack_(block + (i - first) * header_.wordsPerSequence, j, 1, &content[i]);
+      }
+    }
+
+    /**
+     * @brief Create a container with all the sequences of the file.
+     *
+     * Each block is decoded once. If the file does not store the sequences, they are gathered from the blocks of sites.
+     * The decoded content of each sequence is moved into the container, without any other copy.
+     *
+     * @return A new VectorSequenceContainer object.
+     */
+    VectorSequenceContainer* readSequences() const
+    {
+      std::unique_ptr<VectorSequenceContainer> sequences(new VectorSequenceContainer(alphabet_));
+      if (hasSequences())
+      {
+        forEachStoredSequence_([&](size_t i, const std::vector<int>& content) {
+          sequences->addSequence(MovableSequence(getName(i), std::vector<int>(content), alphabet_), false);
+        });
+        return sequences.release();
+      }
+      std::vector< std::vector<int> > contents(getNumberOfSequences(), std::vector<int>(getNumberOfSites()));
+      forEachStoredSite_([&](size_t j, const std::vector<int>& content) {
+        for (size_t i = 0; i < content.size(); ++i)
+          contents[i][j] = content[i];
+      });
+      for (size_t i = 0; i < contents.size(); ++i)
+        sequences->addSequence(MovableSequence(getName(i), std::move(contents[i]), alphabet_), false);
+      return sequences.release();
+    }
+
+    /**
+     * @return A new AlignedSequenceContainer object with all the sequences of the file.
+     */
+    AlignedSequenceContainer* readAlignment() const
+    {
+      std::unique_ptr<OrderedSequenceContainer> sequences(readSequences());
+      return SequenceMoveTools::moveToAlignment(std::move(sequences));
+    }
+
+    /**
+     * @brief Create a container with all the sites of the file.
+     *
+     * Each block is decoded once. If the file does not store the sites, they are gathered from the blocks of sequences.
+     *
+     * @return A new VectorSiteContainer object (positions start at 1).
+     */
+    VectorSiteContainer* readSites() const
+    {
+      std::unique_ptr<VectorSiteContainer> sites(new VectorSiteContainer(getNames(), alphabet_, false));
+      if (hasSites())
+      {
+        forEachStoredSite_([&](size_t j, const std::vector<int>& content) {
+          sites->addSite(Site(content, alphabet_, static_cast<int>(j + 1)), false);
+        });
+        return sites.release();
+      }
+      std::vector< std::vector<int> > contents(getNumberOfSites(), std::vector<int>(getNumberOfSequences()));
+      forEachStoredSequence_([&](size_t i, const std::vector<int>& content) {
+        for (size_t j = 0; j < content.size(); ++j)
+          contents[j][i] = content[j];
+      });
+      for (size_t j = 0; j < contents.size(); ++j)
+      {
+        sites->addSite(Site(contents[j], alphabet_, static_cast<int>(j + 1)), false);
+        std::vector<int>().swap(contents[j]);
+      }
+      return sites.release();
+    }
+
+    /**
+     * @brief Write an alignment to a file.
+     *
+     * @param path              The file to write.
+     * @param sequences         The aligned sequences, with a DNA, RNA or protein alphabet.
+     * @param layouts           The layouts to store: by sequences, by sites, or both.
+     * @param compressionLevel  The zlib compression level, from 0 (no compression) to 9.
+     *                          Blocks which are not made smaller by the compression are stored as they are.
+     * @param sequencesPerBlock The number of sequences per block of the layout by sequences.
+     * @param sitesPerBlock     The number of sites per block of the layout by sites.
+     * @throw AlphabetException If the alphabet is not supported.
+     * @throw SequenceNotAlignedException If sequences do not all have the same length.
+     * @throw IOException If the file can't be written.
+     */
+    static void write(const std::string& path, const OrderedSequenceContainer& sequences, Layout layouts = LAYOUT_BOTH,
+        int compressionLevel = 0, size_t sequencesPerBlock = 64, size_t sitesPerBlock = 1024)
+    {
+      const Alphabet* alphabet = sequences.getAlphabet();
+      Header header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, "BPPALIGN", 8);
+      header.version = VERSION;
+      if (AlphabetTools::isDNAAlphabet(alphabet))
+        header.alphabet = 0;
+      else if (AlphabetTools::isRNAAlphabet(alphabet))
+        header.alphabet = 1;
+      else if (AlphabetTools::isProteicAlphabet(alphabet))
+        header.alphabet = 2;
+      else
+        throw AlphabetException("BinaryAlignment::write. Only DNA, RNA and protein alignments are supported.", alphabet);
+      if (sequencesPerBlock == 0 || sitesPerBlock == 0)
+        throw Exception("BinaryAlignment::write. Blocks must have at least one sequence and one site.");
+
+      size_t nbSequences = sequences.getNumberOfSequences();
+      size_t nbSites = (nbSequences > 0 ? sequences.getSequence(0).size() : 0);
+      std::vector<const int*> rows(nbSequences);
+      std::string nameChars;
+      std::vector<uint64_t> nameOffsets(1, 0);
+      header.bits = (header.alphabet == 2 ? 8 : 2);
+      for (size_t i = 0; i < nbSequences; ++i)
+      {
+        const Sequence& sequence = sequences.getSequence(i);
+        if (sequence.size() != nbSites)
+          throw SequenceNotAlignedException("BinaryAlignment::write. Sequences must all have the same length.", &sequence);
+        rows[i] = (nbSites > 0 ? &sequence.getContent()[0] : 0);
+        if (header.bits == 2)
+        {
+          for (size_t j = 0; j < nbSites && header.bits == 2; ++j)
+            if (rows[i][j] < 0 || rows[i][j] > 3)
+              header.bits = 4;
+        }
+        nameChars += sequence.getName();
+        nameOffsets.push_back(nameChars.size());
+      }
+      header.layouts = layouts;
+      header.nbSequences = nbSequences;
+      header.nbSites = nbSites;
+      header.sequencesPerBlock = sequencesPerBlock;
+      header.sitesPerBlock = sitesPerBlock;
+      header.nbNameChars = nameChars.size();
+      size_t perWord = 64 / header.bits;
+      header.wordsPerSequence = (nbSites + perWord - 1) / perWord;
+      header.wordsPerSite = (nbSequences + perWord - 1) / perWord;
+
+      size_t nbSequenceBlocks = ((layouts & LAYOUT_SEQUENCES) ? (nbSequences + sequencesPerBlock - 1) / sequencesPerBlock : 0);
+      size_t nbSiteBlocks = ((layouts & LAYOUT_SITES) ? (nbSites + sitesPerBlock - 1) / sitesPerBlock : 0);
+      std::vector<Block> sequenceBlocks(nbSequenceBlocks);
+      std::vector<Block> siteBlocks(nbSiteBlocks);
+
+      std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+      if (!out)
+        throw IOException("BinaryAlignment::write. Can't open file " + path);
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      out.write(reinterpret_cast<const char*>(&nameOffsets[0]), static_cast<std::streamsize>(nameOffsets.size() * sizeof(uint64_t)));
+      out.write(nameChars.data(), static_cast<std::streamsize>(nameChars.size()));
+      pad_(out);
+      //The index is written once the blocks are:
+      std::streampos indexPosition = out.tellp();
+      std::vector<char> emptyIndex((nbSequenceBlocks + nbSiteBlocks) * sizeof(Block), 0);
+      if (!emptyIndex.empty())
+        out.write(&emptyIndex[0], static_cast<std::streamsize>(emptyIndex.size()));
+
+      unsigned int bits = header.bits;
+      int offset = (bits == 2 ? 0 : 1);
+      std::vector<uint64_t> words;
+      std::vector<unsigned char> compressed;
+      for (size_t b = 0; b < nbSequenceBlocks; ++b)
+      {
+        size_t first = b * sequencesPerBlock;
+        size_t last = std::min(first + sequencesPerBlock, nbSequences);
+        words.assign((last - first) * header.wordsPerSequence, 0);
+        for (size_t i = first; i < last && nbSites > 0; ++i)
+        {
+          uint64_t* row = &words[(i - first) * header.wordsPerSequence];
+          for (size_t j = 0; j < nbSites; ++j)
+            row[j / perWord] |= static_cast<uint64_t>(rows[i][j] + offset) << ((j % perWord) * bits);
+        }
+        sequenceBlocks[b] = writeBlock_(out, words, compressionLevel, compressed);
+      }
+      for (size_t b = 0; b < nbSiteBlocks; ++b)
+      {
+        size_t first = b * sitesPerBlock;
+        size_t last = std::min(first + sitesPerBlock, nbSites);
+        words.assign((last - first) * header.wordsPerSite, 0);
+        //Each sequence is read on the range of the block, and its states are spread over the sites:
+        for (size_t i = 0; i < nbSequences; ++i)
+        {
+          uint64_t shift = (i % perWord) * bits;
+          uint64_t* column = &words[i / perWord];
+          for (size_t j = first; j < last; ++j)
+            column[(j - first) * header.wordsPerSite] |= static_cast<uint64_t>(rows[i][j] + offset) << shift;
+        }
+        siteBlocks[b] = writeBlock_(out, words, compressionLevel, compressed);
+      }
+      out.seekp(indexPosition);
+      if (nbSequenceBlocks > 0)
+        out.write(reinterpret_cast<const char*>(&sequenceBlocks[0]), static_cast<std::streamsize>(nbSequenceBlocks * sizeof(Block)));
+      if (nbSiteBlocks > 0)
+        out.write(reinterpret_cast<const char*>(&siteBlocks[0]), static_cast<std::streamsize>(nbSiteBlocks * sizeof(Block)));
+      out.close();
+      if (!out)
+        throw IOException("BinaryAlignment::write. Error while writing file " + path);
+    }
+
+  private:
+    static void pad_(std::ofstream& out)
+    {
+      static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+      size_t position = static_cast<size_t>(out.tellp());
+      if (position % 8 != 0)
+        out.write(zeros, static_cast<std::streamsize>(8 - position % 8));
+    }
+
+    static Block writeBlock_(std::ofstream& out, const std::vector<uint64_t>& words, int compressionLevel, std::vector<unsigned char>& compressed)
+    {
+      Block block;
+      block.offset = static_cast<uint64_t>(out.tellp());
+      uLong rawSize = static_cast<uLong>(words.size() * sizeof(uint64_t));
+      block.size = rawSize;
+      const char* data = reinterpret_cast<const char*>(words.empty() ? 0 : &words[0]);
+      if (compressionLevel > 0 && rawSize > 0)
+      {
+        uLongf compressedSize = compressBound(rawSize);
+        compressed.resize(compressedSize);
+        if (compress2(&compressed[0], &compressedSize, reinterpret_cast<const Bytef*>(data), rawSize, compressionLevel) == Z_OK
+            && compressedSize < rawSize)
+        {
+          block.size = compressedSize;
+          data = reinterpret_cast<const char*>(&compressed[0]);
+        }
+      }
+      if (block.size > 0)
+        out.write(data, static_cast<std::streamsize>(block.size));
+      pad_(out);
+      return block;
+    }
+
+    /*
+     * Check the header and index against the size of the file, so that no access goes beyond the mapped data.
+     */
+    void fixPointers_(const std::string& path)
+    {
+      std::memcpy(&header_, data_, sizeof(Header));
+      if (std::memcmp(header_.magic, "BPPALIGN", 8) != 0 || header_.version != VERSION)
+        throw IOException("BinaryAlignment: not an alignment file: " + path);
+      switch (header_.alphabet)
+      {
+      case 0: alphabet_ = &AlphabetTools::DNA_ALPHABET; break;
+      case 1: alphabet_ = &AlphabetTools::RNA_ALPHABET; break;
+      case 2: alphabet_ = &AlphabetTools::PROTEIN_ALPHABET; break;
+      default: throw IOException("BinaryAlignment: unknown alphabet in file " + path);
+      }
+      bool validBits = (header_.alphabet == 2 ? header_.bits == 8 : (header_.bits == 2 || header_.bits == 4));
+      if (!validBits || header_.layouts < LAYOUT_SEQUENCES || header_.layouts > LAYOUT_BOTH
+          || header_.sequencesPerBlock == 0 || header_.sitesPerBlock == 0)
+        throw IOException("BinaryAlignment: invalid header in file " + path);
+      uint64_t perWord = 64 / header_.bits;
+      if (header_.wordsPerSequence != header_.nbSites / perWord + (header_.nbSites % perWord != 0 ? 1 : 0)
+          || header_.wordsPerSite != header_.nbSequences / perWord + (header_.nbSequences % perWord != 0 ? 1 : 0)
+          || (header_.nbSequences == 0 && header_.nbSites != 0)
+          || (header_.wordsPerSequence > 0 && header_.nbSequences > UINT64_MAX / sizeof(uint64_t) / header_.wordsPerSequence)
+          || (header_.wordsPerSite > 0 && header_.nbSites > UINT64_MAX / sizeof(uint64_t) / header_.wordsPerSite))
+        throw IOException("BinaryAlignment: inconsistent sizes in file " + path);
+      nbSequenceBlocks_ = (hasSequences() ? getNumberOfBlocks_(header_.nbSequences, header_.sequencesPerBlock) : 0);
+      nbSiteBlocks_ = (hasSites() ? getNumberOfBlocks_(header_.nbSites, header_.sitesPerBlock) : 0);
+
+      //Each part is checked against the remaining size before moving on, so that positions can't overflow:
+      size_t position = sizeof(Header);
+      if (header_.nbSequences >= (size_ - position) / sizeof(uint64_t))
+        throw IOException("BinaryAlignment: truncated file " + path);
+      nameOffsets_ = reinterpret_cast<const uint64_t*>(data_ + position);
+      position += (static_cast<size_t>(header_.nbSequences) + 1) * sizeof(uint64_t);
+      if (header_.nbNameChars > size_ - position)
+        throw IOException("BinaryAlignment: truncated file " + path);
+      nameChars_ = data_ + position;
+      position += static_cast<size_t>(header_.nbNameChars);
+      position = (position + 7) / 8 * 8;
+      if (position > size_ || nbSequenceBlocks_ + nbSiteBlocks_ > (size_ - position) / sizeof(Block))
+        throw IOException("BinaryAlignment: truncated file " + path);
+      sequenceBlocks_ = reinterpret_cast<const Block*>(data_ + position);
+      position += nbSequenceBlocks_ * sizeof(Block);
+      siteBlocks_ = reinterpret_cast<const Block*>(data_ + position);
+      position += nbSiteBlocks_ * sizeof(Block);
+
+      if (nameOffsets_[0] != 0 || nameOffsets_[header_.nbSequences] != header_.nbNameChars)
+        throw IOException("BinaryAlignment: invalid names in file " + path);
+      for (size_t i = 0; i < getNumberOfSequences(); ++i)
+        if (nameOffsets_[i + 1] < nameOffsets_[i])
+          throw IOException("BinaryAlignment: invalid names in file " + path);
+      for (size_t b = 0; b < nbSequenceBlocks_ + nbSiteBlocks_; ++b)
+      {
+        const Block& block = (b < nbSequenceBlocks_ ? sequenceBlocks_[b] : siteBlocks_[b - nbSequenceBlocks_]);
+        size_t nbWords = (b < nbSequenceBlocks_ ? getSequenceBlockWords_(b) : getSiteBlockWords_(b - nbSequenceBlocks_));
+        if (block.offset % 8 != 0 || block.offset < position || block.offset > size_ || block.size > size_ - block.offset)
+          throw IOException("BinaryAlignment: truncated file " + path);
+        //zlib does not compress by more than 1032:1, which bounds the buffer of a compressed block:
+        if (block.size > nbWords * sizeof(uint64_t) || nbWords * sizeof(uint64_t) > block.size * 1032 + 64)
+          throw IOException("BinaryAlignment: invalid block size in file " + path);
+      }
+    }
+
+    static size_t getNumberOfBlocks_(uint64_t n, uint64_t perBlock)
+    {
+      return static_cast<size_t>(n / perBlock + (n % perBlock != 0 ? 1 : 0));
+    }
+
+    void checkSequence_(size_t i) const
+    {
+      if (i >= getNumberOfSequences())
+        throw IndexOutOfBoundsException("BinaryAlignment. Bad sequence index.", i, 0, getNumberOfSequences() - 1);
+    }
+
+    size_t getSequenceBlockWords_(size_t b) const
+    {
+      size_t first = b * static_cast<size_t>(header_.sequencesPerBlock);
+      return std::min(static_cast<size_t>(header_.sequencesPerBlock), getNumberOfSequences() - first) * static_cast<size_t>(header_.wordsPerSequence);
+    }
+
+    size_t getSiteBlockWords_(size_t b) const
+    {
+      size_t first = b * static_cast<size_t>(header_.sitesPerBlock);
+      return std::min(static_cast<size_t>(header_.sitesPerBlock), getNumberOfSites() - first) * static_cast<size_t>(header_.wordsPerSite);
+    }
+
+    /*
+     * Return the words of a block: in the mapped file if it is not compressed, in the buffer otherwise.
+     */
+    const uint64_t* getBlock_(const Block& block, size_t nbWords, std::vector<uint64_t>& buffer) const
+    {
+      if (block.size == nbWords * sizeof(uint64_t))
+        return reinterpret_cast<const uint64_t*>(data_ + block.offset);
+      buffer.resize(nbWords);
+      uLongf rawSize = static_cast<uLongf>(nbWords * sizeof(uint64_t));
+      if (uncompress(reinterpret_cast<Bytef*>(&buffer[0]), &rawSize, reinterpret_cast<const Bytef*>(data_ + block.offset), static_cast<uLong>(block.size)) != Z_OK
+          || rawSize != nbWords * sizeof(uint64_t))
+        throw IOException("BinaryAlignment: corrupted block.");
+      return &buffer[0];
+    }
+
+    /*
+     * Call f(i, content) for each sequence of the layout by sequences. Each block is decoded once, into a reused buffer.
+     */
+    template<class F>
+    void forEachStoredSequence_(F f) const
+    {
+      std::vector<uint64_t> buffer;
+      std::vector<int> content(getNumberOfSites());
+      for (size_t b = 0; b < nbSequenceBlocks_; ++b)
+      {
+        const uint64_t* block = getBlock_(sequenceBlocks_[b], getSequenceBlockWords_(b), buffer);
+        size_t first = b * static_cast<size_t>(header_.sequencesPerBlock);
+        size_t last = first + std::min(static_cast<size_t>(header_.sequencesPerBlock), getNumberOfSequences() - first);
+        for (size_t i = first; i < last; ++i)
+        {
+          if (!content.empty())
+            unpack_(block + (i - first) * header_.wordsPerSequence, 0, content.size(), &content[0]);
+          f(i, content);
+        }
+      }
+    }
+
+    /*
+     * Call f(j, content) for each site of the layout by sites. Each block is decoded once, into a reused buffer.
+     */
+    template<class F>
+    void forEachStoredSite_(F f) const
+    {
+      std::vector<uint64_t> buffer;
+      std::vector<int> content(getNumberOfSequences());
+      for (size_t b = 0; b < nbSiteBlocks_; ++b)
+      {
+        const uint64_t* block = getBlock_(siteBlocks_[b], getSiteBlockWords_(b), buffer);
+        size_t first = b * static_cast<size_t>(header_.sitesPerBlock);
+        size_t last = first + std::min(static_cast<size_t>(header_.sitesPerBlock), getNumberOfSites() - first);
+        for (size_t j = first; j < last; ++j)
+        {
+          if (!content.empty())
+            unpack_(block + (j - first) * header_.wordsPerSite, 0, content.size(), &content[0]);
+          f(j, content);
+        }
+      }
+    }
+
+    /*
+     * Decode count states from position first of a run of words.
+     */
+    void unpack_(const uint64_t* words, size_t first, size_t count, int* out) const
+    {
+      unsigned int bits = header_.bits;
+      size_t perWord = 64 / bits;
+      uint64_t mask = (static_cast<uint64_t>(1) << bits) - 1;
+      int offset = (bits == 2 ? 0 : -1);
+      size_t w = first / perWord;
+      size_t k = first % perWord;
+      uint64_t word = words[w] >> (k * bits);
+      for (size_t n = 0; n < count; ++n)
+      {
+        out[n] = static_cast<int>(word & mask) + offset;
+        word >>= bits;
+        if (++k == perWord && n + 1 < count)
+        {
+          word = words[++w];
+          k = 0;
+        }
+      }
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_BINARYALIGNMENT_H_
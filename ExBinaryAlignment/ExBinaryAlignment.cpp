@@ -0,0 +1,209 @@
+/*
+ * File: ExBinaryAlignment.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 04:20 2026
+ *
+ * Saving alignments in a binary format, to load them again quickly.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <memory>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * And the binary format, in this directory:
+ */
+#include "BinaryAlignment.h"
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * Check that two containers have the same sequences, with the same names.
+ */
+bool sameSequences(const OrderedSequenceContainer& sequences1, const OrderedSequenceContainer& sequences2)
+{
+  if (sequences1.getNumberOfSequences() != sequences2.getNumberOfSequences())
+    return false;
+  for (size_t i = 0; i < sequences1.getNumberOfSequences(); i++)
+  {
+    if (sequences1.getSequence(i).getName() != sequences2.getSequence(i).getName()
+        || sequences1.getSequence(i).getContent() != sequences2.getSequence(i).getContent())
+      return false;
+  }
+  return true;
+}
+
+/*
+ * Check that two alignments have the same sites.
+ */
+bool sameSites(const SiteContainer& sites1, const SiteContainer& sites2)
+{
+  if (sites1.getNumberOfSites() != sites2.getNumberOfSites())
+    return false;
+  for (size_t j = 0; j < sites1.getNumberOfSites(); j++)
+  {
+    if (sites1.getSite(j).getContent() != sites2.getSite(j).getContent())
+      return false;
+  }
+  return true;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * Reading a Fasta file means parsing its text every time. When the same alignment is used again and again,
+     * it can be saved once in a binary file, which stores the encoded states, packed with 2 to 8 bits per state.
+     * We store it twice, by sequences and by sites, so that both can be read quickly:
+     */
+    Fasta fasReader;
+    unique_ptr<VectorSequenceContainer> sequences(fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET));
+    BinaryAlignment::write("TIMnuc.aln.bpp", *sequences);
+
+    /*
+     * Blocks of sequences and sites can also be compressed, with a zlib compression level from 1 to 9.
+     * This makes the file smaller, but blocks then have to be decompressed when they are read:
+     */
+    BinaryAlignment::write("TIMnuc.aln.bppz", *sequences, BinaryAlignment::LAYOUT_BOTH, 6);
+
+    /*
+     * A BinaryAlignment object maps the file in memory: nothing is read at this point.
+     * It gives access to any sequence, part of sequence or site, reading only the corresponding part of the file:
+     */
+    BinaryAlignment binary("TIMnuc.aln.bpp");
+    BinaryAlignment compressed("TIMnuc.aln.bppz");
+    cout << "The file has " << binary.getNumberOfSequences() << " sequences and " << binary.getNumberOfSites()
+         << " sites, with " << binary.getNumberOfBitsPerState() << " bits per state." << endl;
+    cout << "Is the second file compressed? " << (compressed.isCompressed() ? "yes" : "no") << endl;
+
+    vector<int> content;
+    size_t last = binary.getNumberOfSequences() - 1;
+    binary.getSequenceContent(last, 0, 20, content);
+    cout << binary.getName(last) << ", first 20 positions: " << BasicSequence("", content, binary.getAlphabet()).toString() << endl;
+    compressed.getSiteContent(100, content);
+    cout << "Site 101: " << Site(content, compressed.getAlphabet()).toString() << endl;
+
+    /*
+     * Whole containers are created from the file as well. Let's check that we get the same sequences
+     * and sites back, from both files, and from files with only one of the layouts:
+     */
+    BinaryAlignment::write("TIMnuc.seq.bppz", *sequences, BinaryAlignment::LAYOUT_SEQUENCES, 6);
+    BinaryAlignment::write("TIMnuc.sites.bppz", *sequences, BinaryAlignment::LAYOUT_SITES, 6);
+    VectorSiteContainer sites(*sequences);
+    const char* files[4] = { "TIMnuc.aln.bpp", "TIMnuc.aln.bppz", "TIMnuc.seq.bppz", "TIMnuc.sites.bppz" };
+    for (size_t f = 0; f < 4; f++)
+    {
+      BinaryAlignment file(files[f]);
+      unique_ptr<VectorSequenceContainer> loaded(file.readSequences());
+      unique_ptr<VectorSiteContainer> loadedSites(file.readSites());
+      cout << files[f] << ": same sequences as in the Fasta file? " << (sameSequences(*loaded, *sequences) ? "yes" : "no")
+           << ", same sites? " << (sameSites(*loadedSites, sites) ? "yes" : "no") << endl;
+    }
+
+    /*
+     * Now let's compare the time needed to load the alignment 100 times, from both formats:
+     */
+    unsigned int nload = 100; /* reduce this number if this is too slow on your computer! */
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nload; j++)
+    {
+      unique_ptr<OrderedSequenceContainer> s(fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET));
+      delete new AlignedSequenceContainer(*s);
+    }
+    ApplicationTools::displayTime("Time used for loading an AlignedSequenceContainer from the Fasta file:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nload; j++)
+    {
+      BinaryAlignment b("TIMnuc.aln.bpp");
+      delete b.readAlignment();
+    }
+    ApplicationTools::displayTime("Time used for loading an AlignedSequenceContainer from the binary file:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nload; j++)
+    {
+      unique_ptr<OrderedSequenceContainer> s(fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET));
+      delete new VectorSiteContainer(*s);
+    }
+    ApplicationTools::displayTime("Time used for loading a VectorSiteContainer from the Fasta file:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nload; j++)
+    {
+      BinaryAlignment b("TIMnuc.aln.bpp");
+      delete b.readSites();
+    }
+    ApplicationTools::displayTime("Time used for loading a VectorSiteContainer from the binary file:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nload; j++)
+    {
+      BinaryAlignment b("TIMnuc.aln.bppz");
+      delete b.readSites();
+    }
+    ApplicationTools::displayTime("Time used for loading a VectorSiteContainer from the compressed binary file:");
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,382 @@
+/*
+ * File: ArenaSequenceContainer.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 07:10 2026
+ *
+ * A sequence container allocating its names and states in large slabs, for sets of many short sequences.
+ */
+
+#ifndef _ARENASEQUENCECONTAINER_H_
+#define _ARENASEQUENCECONTAINER_H_
+
+#include "CharacterTable.h"
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Bump allocator: memory is taken from large slabs, and only released all at once.
+   *
+   * Each slab is a single allocation. Blocks larger than a slab get a slab of their own.
+   * reset() keeps the slabs, so that the next blocks reuse them without any new allocation.
+   */
+  class SequenceArena
+  {
+  private:
+    struct Slab
+    {
+      char* data;
+      size_t size;
+    };
+    std::vector<Slab> slabs_;
+    size_t slabSize_;
+    size_t current_; //index of the slab being filled.
+    size_t offset_;  //first free byte in this slab.
+    size_t used_;
+
+  public:
+    /**
+     * @param slabSize The size of slabs, in bytes.
+     */
+    SequenceArena(size_t slabSize = 1 << 20) :
+      slabs_(), slabSize_(std::max(slabSize, static_cast<size_t>(64))), current_(0), offset_(0), used_(0)
+    {}
+
+    ~SequenceArena() { release(); }
+
+  private:
+    SequenceArena(const SequenceArena&);
+    SequenceArena& operator=(const SequenceArena&);
+
+  public:
+    /**
+     * @brief Get a block of memory, valid until the next call to reset() or release().
+     *
+     * @param size  The size of the block, in bytes.
+     * @param align The alignment of the block, a power of 2.
+     */
+    void* allocate(size_t size, size_t align)
+    {
+      while (current_ < slabs_.size())
+      {
+        size_t begin = (offset_ + align - 1) & ~(align - 1);
+        if (begin + size <= slabs_[current_].size)
+        {
+          offset_ = begin + size;
+          used_ += size;
+          return slabs_[current_].data + begin;
+        }
+        ++current_;
+        offset_ = 0;
+      }
+      //Slabs are allocated with new[], so that their start is aligned for any type:
+      Slab slab;
+      slab.size = std::max(size, slabSize_);
+      slab.data = new char[slab.size];
+      slabs_.push_back(slab);
+      current_ = slabs_.size() - 1;
+      offset_ = size;
+      used_ += size;
+      return slab.data;
+    }
+
+    /**
+     * @brief Forget all blocks, but keep the slabs for the next ones.
+     */
+    void reset()
+    {
+      current_ = 0;
+      offset_ = 0;
+      used_ = 0;
+    }
+
+    /**
+     * @brief Free all slabs.
+     */
+    void release()
+    {
+      for (size_t i = 0; i < slabs_.size(); ++i)
+        delete[] slabs_[i].data;
+      slabs_.clear();
+      reset();
+    }
+
+    size_t getNumberOfSlabs() const { return slabs_.size(); }
+
+    /**
+     * @return The number of bytes in the blocks given since the last reset.
+     */
+    size_t getUsedBytes() const { return used_; }
+
+    /**
+     * @return The number of bytes held in slabs.
+     */
+    size_t getCapacity() const
+    {
+      size_t capacity = 0;
+      for (size_t i = 0; i < slabs_.size(); ++i)
+        capacity += slabs_[i].size;
+      return capacity;
+    }
+  };
+
+  /**
+   * @brief A sequence stored in an ArenaSequenceContainer.
+   *
+   * Objects of this class only point to the name and states stored in the slabs of their container,
+   * and have no destructor. They are valid as long as the container is not cleared or destroyed.
+   *
+   * Like SymbolView and PackedSequence, this class mirrors the read methods of the Sequence interface
+   * instead of implementing it: Sequence::getContent() and Sequence::getName() return references to
+   * a vector and a string, which would have to be allocated for each sequence. toSequence() gives a BasicSequence.
+   * Functions of ViewTools (see ExSymbolView) accept these objects directly.
+   */
+  class ArenaSequence
+  {
+  private:
+    const char* name_;
+    size_t nameLength_;
+    const int* content_;
+    size_t size_;
+    const Alphabet* alphabet_;
+
+  public:
+    ArenaSequence(const char* name, size_t nameLength, const int* content, size_t size, const Alphabet* alphabet) :
+      name_(name), nameLength_(nameLength), content_(content), size_(size), alphabet_(alphabet)
+    {}
+
+  public:
+    std::string getName() const { return std::string(name_, nameLength_); }
+
+    /**
+     * @return True if the sequence has this name. Unlike getName(), this does not create a string.
+     */
+    bool hasName(const std::string& name) const
+    {
+      return name.size() == nameLength_ && std::memcmp(name.data(), name_, nameLength_) == 0;
+    }
+
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t size() const { return size_; }
+    int operator[](size_t i) const { return content_[i]; }
+
+    int getValue(size_t i) const
+    {
+      if (i >= size_)
+        throw IndexOutOfBoundsException("ArenaSequence::getValue.", i, 0, size_ - 1);
+      return content_[i];
+    }
+
+    std::string getChar(size_t i) const { return alphabet_->intToChar(getValue(i)); }
+
+    std::string toString() const
+    {
+      std::string s;
+      for (size_t i = 0; i < size_; ++i)
+        s += alphabet_->intToChar(content_[i]);
+      return s;
+    }
+
+    /**
+     * @return A pointer to the states, contiguous in memory.
+     */
+    const int* getData() const { return content_; }
+
+    /**
+     * @return A new BasicSequence with the same name and content.
+     */
+    Sequence* toSequence() const
+    {
+      return new BasicSequence(getName(), std::vector<int>(content_, content_ + size_), alphabet_);
+    }
+  };
+
+  /**
+   * @brief A container for large sets of sequences which are created and discarded together, as batches of reads.
+   *
+   * A VectorSequenceContainer holds a BasicSequence object per sequence, each with its own name string and
+   * state vector: adding a sequence takes at least three allocations, and clearing the container as many deallocations.
+   * Here, the name and states of each sequence are copied into the slabs of a SequenceArena, and sequences are
+   * small records in a single vector. Adding a sequence takes no allocation, except when a slab is full;
+   * clear() and the destructor only free the slabs and the vector, whatever the number of sequences.
+   * reset() keeps the memory for the next batch of sequences.
+   *
+   * Sequences are added from Sequence objects (addSequence, addSequences), or directly from text with
+   * a CharacterTable, without any intermediate object. As slabs are never reorganized, sequences
+   * cannot be removed nor modified. Sequence comments are not kept, and names are not checked for uniqueness.
+   * Use toContainer() to get a VectorSequenceContainer.
+   */
+  class ArenaSequenceContainer
+  {
+  private:
+    const Alphabet* alphabet_;
+    SequenceArena arena_;
+    std::vector<ArenaSequence> sequences_;
+    std::unique_ptr<CharacterTable> table_; //built when text is first added.
+
+  public:
+    /**
+     * @param alphabet The alphabet of the sequences.
+     * @param slabSize The size of the slabs, in bytes.
+     */
+    ArenaSequenceContainer(const Alphabet* alphabet, size_t slabSize = 1 << 20) :
+      alphabet_(alphabet), arena_(slabSize), sequences_(), table_()
+    {}
+
+  private:
+    ArenaSequenceContainer(const ArenaSequenceContainer&);
+    ArenaSequenceContainer& operator=(const ArenaSequenceContainer&);
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t getNumberOfSequences() const { return sequences_.size(); }
+
+    /**
+     * @throw IndexOutOfBoundsException If there is no such sequence.
+     */
+    const ArenaSequence& getSequence(size_t i) const
+    {
+      if (i >= sequences_.size())
+        throw IndexOutOfBoundsException("ArenaSequenceContainer::getSequence.", i, 0, sequences_.size() - 1);
+      return sequences_[i];
+    }
+
+    std::vector<std::string> getSequencesNames() const
+    {
+      std::vector<std::string> names(sequences_.size());
+      for (size_t i = 0; i < sequences_.size(); ++i)
+        names[i] = sequences_[i].getName();
+      return names;
+    }
+
+    /**
+     * @brief Copy a sequence into the container.
+     *
+     * @throw AlphabetMismatchException If the sequence does not have the alphabet of the container.
+     */
+    void addSequence(const Sequence& sequence)
+    {
+      BPP_INSTRUMENT_SCOPE(CLONE);
+      BPP_INSTRUMENT_COUNT(CLONE, 1);
+      if (sequence.getAlphabet()->getAlphabetType() != alphabet_->getAlphabetType())
+        throw AlphabetMismatchException("ArenaSequenceContainer::addSequence", alphabet_, sequence.getAlphabet());
+      const std::string& name = sequence.getName();
+      const std::vector<int>& content = sequence.getContent();
+      int* states = allocate_(name, content.size());
+      if (!content.empty())
+        std::memcpy(states, &content[0], content.size() * sizeof(int));
+    }
+
+    /**
+     * @brief Copy all sequences of a container.
+     */
+    void addSequences(const OrderedSequenceContainer& sequences)
+    {
+      sequences_.reserve(sequences_.size() + sequences.getNumberOfSequences());
+      for (size_t i = 0; i < sequences.getNumberOfSequences(); ++i)
+        addSequence(sequences.getSequence(i));
+    }
+
+    /**
+     * @brief Add a sequence given as text, encoded directly into the slabs.
+     *
+     * @param name  The name of the sequence.
+     * @param chars The characters of the sequence, one per state.
+     * @param n     The number of characters.
+     * @throw BadCharException If a character is not in the alphabet. The sequence is then not added.
+     * @throw Exception If the alphabet has more than one character per state, as codon alphabets.
+     */
+    void addSequence(const std::string& name, const char* chars, size_t n)
+    {
+      BPP_INSTRUMENT_SCOPE(ENCODE);
+      BPP_INSTRUMENT_COUNT(ENCODE, n);
+      if (!table_.get())
+        table_.reset(new CharacterTable(alphabet_));
+      int* states = allocate_(name, n);
+      try
+      {
+        table_->encode(chars, n, states);
+      }
+      catch (...)
+      {
+        sequences_.pop_back(); //the slab space is lost until the next reset, which is harmless.
+        throw;
+      }
+    }
+
+    void addSequence(const std::string& name, const std::string& sequence)
+    {
+      addSequence(name, sequence.data(), sequence.size());
+    }
+
+    /**
+     * @brief Remove all sequences, and keep the slabs for the next ones.
+     *
+     * All ArenaSequence references obtained before are invalid after this call.
+     */
+    void reset()
+    {
+      sequences_.clear();
+      arena_.reset();
+    }
+
+    /**
+     * @brief Remove all sequences, and free the slabs.
+     *
+     * All ArenaSequence references obtained before are invalid after this call.
+     */
+    void clear()
+    {
+      std::vector<ArenaSequence>().swap(sequences_);
+      arena_.release();
+    }
+
+    /**
+     * @return A new container with a copy of all sequences, as BasicSequence objects.
+     */
+    VectorSequenceContainer* toContainer() const
+    {
+      VectorSequenceContainer* sequences = new VectorSequenceContainer(alphabet_);
+      for (size_t i = 0; i < sequences_.size(); ++i)
+      {
+        const ArenaSequence& s = sequences_[i];
+        sequences->addSequence(BasicSequence(s.getName(), std::vector<int>(s.getData(), s.getData() + s.size()), alphabet_), false);
+      }
+      return sequences;
+    }
+
+    const SequenceArena& getArena() const { return arena_; }
+
+  private:
+    /*
+     * Copy the name, reserve room for the states, and record the new sequence.
+     * States come first in each block, so that the name does not break their alignment.
+     */
+    int* allocate_(const std::string& name, size_t size)
+    {
+      char* block = static_cast<char*>(arena_.allocate(size * sizeof(int) + name.size(), sizeof(int)));
+      int* states = reinterpret_cast<int*>(block);
+      char* chars = block + size * sizeof(int);
+      if (!name.empty())
+        std::memcpy(chars, name.data(), name.size());
+      sequences_.push_back(ArenaSequence(chars, name.size(), states, size, alphabet_));
+      return states;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_ARENASEQUENCECONTAINER_H_
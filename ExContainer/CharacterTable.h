@@ -0,0 +1,175 @@
+/*
+ * File: CharacterTable.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 10:02 2026
+ *
+ * Lookup tables between bytes and state codes, for alphabets with one character per state.
+ */
+
+#ifndef _CHARACTERTABLE_H_
+#define _CHARACTERTABLE_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Lookup table from bytes to state codes, for alphabets with one character per state.
+   *
+   * The table has 256 entries, built once from Alphabet::charToInt, so that encoding a character
+   * is a single memory access instead of a string construction and a map lookup.
+   * It also has the reverse table, from state codes to characters.
+   *
+   * Whole buffers are encoded and decoded with encode() and decode(). The loops have no branch:
+   * invalid characters are detected once per block of 64 positions, and the exact position
+   * of the error is only searched for when the block is invalid. This lets the compiler
+   * unroll the loops, or vectorize them when gather instructions are available.
+   *
+   * This works for the DNA, RNA and protein alphabets, but not for codon alphabets.
+   */
+  class CharacterTable
+  {
+  public:
+    /**
+     * @brief Code used for bytes which are not part of the alphabet.
+     */
+    enum { UNDEFINED = -99 };
+
+  private:
+    enum { BLOCK_SIZE = 64 };
+    const Alphabet* alphabet_;
+    int codes_[256];
+    std::vector<char> chars_; //indexed by state + 1.
+
+  public:
+    /**
+     * @param alphabet The alphabet to use.
+     * @throw Exception If the alphabet has more than one character per state.
+     */
+    CharacterTable(const Alphabet* alphabet) : alphabet_(alphabet), codes_(), chars_()
+    {
+      if (alphabet->getStateCodingSize() != 1)
+        throw Exception("CharacterTable: only alphabets with one character per state are supported.");
+      codes_[0] = UNDEFINED;
+      for (int c = 1; c < 256; ++c)
+      {
+        std::string s(1, static_cast<char>(c));
+        codes_[c] = alphabet->isCharInAlphabet(s) ? alphabet->charToInt(s) : static_cast<int>(UNDEFINED);
+      }
+      for (int state = -1; state < 256 && alphabet->isIntInAlphabet(state); ++state)
+      {
+        std::string s = alphabet->intToChar(state);
+        chars_.push_back(s.size() == 1 ? s[0] : '\0');
+      }
+    }
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+
+    int operator[](unsigned char c) const { return codes_[c]; }
+
+    /**
+     * @return The character of a state, or '\\0' if the state is not in the alphabet.
+     */
+    char getChar(int state) const
+    {
+      size_t i = static_cast<size_t>(static_cast<unsigned int>(state + 1));
+      return i < chars_.size() ? chars_[i] : '\0';
+    }
+
+    /**
+     * @brief Encode a buffer of characters.
+     *
+     * @param chars The characters.
+     * @param n     The number of characters.
+     * @param out   [out] The states. It must have room for n states.
+     * @throw BadCharException If a character is not in the alphabet. The output is then only partially filled.
+     */
+    void encode(const char* chars, size_t n, int* out) const
+    {
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(chars);
+      for (size_t begin = 0; begin < n; begin += BLOCK_SIZE)
+      {
+        size_t end = std::min(begin + static_cast<size_t>(BLOCK_SIZE), n);
+        bool invalid = false;
+        for (size_t k = begin; k < end; ++k)
+        {
+          int code = codes_[p[k]];
+          out[k] = code;
+          invalid |= (code == UNDEFINED);
+        }
+        if (invalid)
+        {
+          for (size_t k = begin; k < end; ++k)
+          {
+            if (out[k] == UNDEFINED)
+              throw BadCharException(std::string(1, chars[k]), "CharacterTable::encode. At position " + TextTools::toString(k + 1), alphabet_);
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Encode a string into a vector of states, which is resized if needed.
+     */
+    void encode(const std::string& chars, std::vector<int>& out) const
+    {
+      out.resize(chars.size());
+      if (!chars.empty())
+        encode(chars.data(), chars.size(), &out[0]);
+    }
+
+    /**
+     * @brief Decode a buffer of states.
+     *
+     * @param states The states.
+     * @param n      The number of states.
+     * @param out    [out] The characters. It must have room for n characters (no terminating '\\0' is added).
+     * @throw BadIntException If a state is not in the alphabet. The output is then only partially filled.
+     */
+    void decode(const int* states, size_t n, char* out) const
+    {
+      size_t nbStates = chars_.size();
+      for (size_t begin = 0; begin < n; begin += BLOCK_SIZE)
+      {
+        size_t end = std::min(begin + static_cast<size_t>(BLOCK_SIZE), n);
+        bool invalid = false;
+        for (size_t k = begin; k < end; ++k)
+        {
+          size_t i = static_cast<size_t>(static_cast<unsigned int>(states[k] + 1));
+          bool ok = (i < nbStates);
+          out[k] = chars_[ok ? i : 0];
+          invalid |= !ok;
+        }
+        if (invalid)
+        {
+          for (size_t k = begin; k < end; ++k)
+          {
+            if (static_cast<size_t>(static_cast<unsigned int>(states[k] + 1)) >= nbStates)
+              throw BadIntException(states[k], "CharacterTable::decode. At position " + TextTools::toString(k + 1), alphabet_);
+          }
+        }
+      }
+    }
+
+    /**
+     * @brief Decode a vector of states into a string, which is resized if needed.
+     */
+    void decode(const std::vector<int>& states, std::string& out) const
+    {
+      out.resize(states.size());
+      if (!states.empty())
+        decode(&states[0], states.size(), &out[0]);
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_CHARACTERTABLE_H_
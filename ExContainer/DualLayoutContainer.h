@@ -0,0 +1,397 @@
+/*
+ * File: DualLayoutContainer.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 03:10 2026
+ *
+ * An alignment stored by sequences, with a site layout built on demand.
+ */
+
+#ifndef _DUALLAYOUTCONTAINER_H_
+#define _DUALLAYOUTCONTAINER_H_
+
+#include "ThreadPool.h" /* from ExParallelFasta */
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief An alignment with fast access to both its sequences and its sites.
+   *
+   * AlignedSequenceContainer stores the sequences, and builds a new Site object at each call of getSite();
+   * VectorSiteContainer stores the sites, and builds a new Sequence object at each call of getSequence().
+   * This class stores the sequences, as AlignedSequenceContainer, and keeps a second copy of the data
+   * stored by sites. This site layout is only built at the first call of getSite() (or of transpose()),
+   * by transposing the sequences tile by tile, so that reads and writes both stay in cache,
+   * with several threads. Both getSequence() and getSite() then return a stored object.
+   *
+   * The site layout is kept up to date when the alignment is modified:
+   * - replacing a sequence or a site, adding a sequence at the end, and adding or removing sites
+   *   update it in time proportional to the size of the sequence or site;
+   * - inserting or removing a sequence elsewhere than at the end, and getting a modifiable state
+   *   through valueAt() or operator() discard it, and it is built again at the next call of getSite().
+   * releaseSites() discards it explicitly, to free memory.
+   *
+   * The first call of getSite() can be made by several threads at once: only one of them builds the layout.
+   * As for other containers, modifications must not be concurrent with accesses.
+   */
+  class DualLayoutContainer :
+    public AlignedSequenceContainer
+  {
+  private:
+    mutable std::vector< std::unique_ptr<Site> > sites_;
+    mutable std::atomic<bool> transposed_;
+    mutable std::mutex mutex_;
+    unsigned int nbThreads_;
+
+  public:
+    /**
+     * @param alphabet  The alphabet of the alignment.
+     * @param nbThreads The number of threads used to build the site layout. 0 means as many as hardware threads.
+     */
+    explicit DualLayoutContainer(const Alphabet* alphabet, unsigned int nbThreads = 0) :
+      AlignedSequenceContainer(alphabet), sites_(), transposed_(false), mutex_(), nbThreads_(nbThreads)
+    {}
+
+    /**
+     * @param sequences The sequences of the alignment, which are copied.
+     * @param nbThreads The number of threads used to build the site layout. 0 means as many as hardware threads.
+     * @throw SequenceNotAlignedException If sequences do not all have the same length.
+     */
+    explicit DualLayoutContainer(const OrderedSequenceContainer& sequences, unsigned int nbThreads = 0) :
+      AlignedSequenceContainer(sequences), sites_(), transposed_(false), mutex_(), nbThreads_(nbThreads)
+    {}
+
+    /**
+     * @brief Copy an alignment. The site layout is not copied, and will be built when needed.
+     */
+    DualLayoutContainer(const DualLayoutContainer& container) :
+      AlignedSequenceContainer(container), sites_(), transposed_(false), mutex_(), nbThreads_(container.nbThreads_)
+    {}
+
+    DualLayoutContainer& operator=(const DualLayoutContainer& container)
+    {
+      AlignedSequenceContainer::operator=(container);
+      releaseSites();
+      nbThreads_ = container.nbThreads_;
+      return *this;
+    }
+
+    DualLayoutContainer* clone() const { return new DualLayoutContainer(*this); }
+
+    virtual ~DualLayoutContainer() {}
+
+  public:
+    /**
+     * @return A site, from the site layout, which is built first if needed.
+     * @throw IndexOutOfBoundsException If the position is not in the alignment.
+     */
+    const Site& getSite(size_t siteIndex) const
+    {
+      if (siteIndex >= getNumberOfSites())
+        throw IndexOutOfBoundsException("DualLayoutContainer::getSite.", siteIndex, 0, getNumberOfSites() - 1);
+      transpose();
+      return *sites_[siteIndex];
+    }
+
+    /**
+     * @brief Build the site layout now, if it is not built yet.
+     */
+    void transpose() const
+    {
+      if (transposed_.load(std::memory_order_acquire))
+        return;
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (transposed_.load(std::memory_order_relaxed))
+        return;
+      transpose_();
+      transposed_.store(true, std::memory_order_release);
+    }
+
+    bool isTransposed() const { return transposed_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Discard the site layout, to free memory. It will be built again when needed.
+     */
+    void releaseSites()
+    {
+      sites_.clear();
+      sites_.shrink_to_fit();
+      transposed_.store(false, std::memory_order_release);
+    }
+
+    unsigned int getNumberOfThreads() const { return nbThreads_; }
+    void setNumberOfThreads(unsigned int nbThreads) { nbThreads_ = nbThreads; }
+
+    /**
+     * @name Modifications of sequences.
+     *
+     * @{
+     */
+    using AlignedSequenceContainer::addSequence;
+    using AlignedSequenceContainer::setSequence;
+    using AlignedSequenceContainer::removeSequence;
+    using AlignedSequenceContainer::deleteSequence;
+
+    void setSequence(size_t sequenceIndex, const Sequence& sequence, bool checkName = true)
+    {
+      AlignedSequenceContainer::setSequence(sequenceIndex, sequence, checkName);
+      if (isTransposed())
+      {
+        const Sequence& stored = AlignedSequenceContainer::getSequence(sequenceIndex);
+        for (size_t j = 0; j < sites_.size(); ++j)
+          sites_[j]->setElement(sequenceIndex, stored[j]);
+      }
+    }
+
+    void setSequence(const std::string& name, const Sequence& sequence, bool checkName = true)
+    {
+      setSequence(getSequencePosition(name), sequence, checkName);
+    }
+
+    void addSequence(const Sequence& sequence, bool checkName = true)
+    {
+      AlignedSequenceContainer::addSequence(sequence, checkName);
+      if (isTransposed())
+      {
+        if (getNumberOfSequences() == 1)
+        {
+          //The first sequence sets the number of sites:
+          releaseSites();
+          return;
+        }
+        const Sequence& stored = AlignedSequenceContainer::getSequence(getNumberOfSequences() - 1);
+        for (size_t j = 0; j < sites_.size(); ++j)
+          sites_[j]->addElement(stored[j]);
+      }
+    }
+
+    void addSequence(const Sequence& sequence, size_t sequenceIndex, bool checkName = true)
+    {
+      AlignedSequenceContainer::addSequence(sequence, sequenceIndex, checkName);
+      releaseSites();
+    }
+
+    Sequence* removeSequence(size_t sequenceIndex)
+    {
+      Sequence* sequence = AlignedSequenceContainer::removeSequence(sequenceIndex);
+      releaseSites();
+      return sequence;
+    }
+
+    Sequence* removeSequence(const std::string& name)
+    {
+      return removeSequence(getSequencePosition(name));
+    }
+
+    void deleteSequence(size_t sequenceIndex)
+    {
+      AlignedSequenceContainer::deleteSequence(sequenceIndex);
+      releaseSites();
+    }
+
+    void deleteSequence(const std::string& name)
+    {
+      deleteSequence(getSequencePosition(name));
+    }
+
+    void clear()
+    {
+      AlignedSequenceContainer::clear();
+      releaseSites();
+    }
+    /** @} */
+
+    /**
+     * @name Access to the states.
+     *
+     * The modifiable versions return a reference to a state of a sequence, which can be changed after they return:
+     * they discard the site layout. Use the const versions, or getSite(), to only read the states.
+     *
+     * @{
+     */
+    using AlignedSequenceContainer::valueAt;
+    using AlignedSequenceContainer::operator();
+
+    int& valueAt(const std::string& sequenceName, size_t elementIndex)
+    {
+      int& state = AlignedSequenceContainer::valueAt(sequenceName, elementIndex);
+      releaseSites();
+      return state;
+    }
+
+    int& operator()(const std::string& sequenceName, size_t elementIndex)
+    {
+      return valueAt(sequenceName, elementIndex);
+    }
+
+    int& valueAt(size_t sequenceIndex, size_t elementIndex)
+    {
+      int& state = AlignedSequenceContainer::valueAt(sequenceIndex, elementIndex);
+      releaseSites();
+      return state;
+    }
+
+    int& operator()(size_t sequenceIndex, size_t elementIndex)
+    {
+      return valueAt(sequenceIndex, elementIndex);
+    }
+    /** @} */
+
+    /**
+     * @name Modifications of sites.
+     *
+     * @{
+     */
+    void setSite(size_t siteIndex, const Site& site, bool checkPosition = true)
+    {
+      AlignedSequenceContainer::setSite(siteIndex, site, checkPosition);
+      if (isTransposed())
+        sites_[siteIndex].reset(new Site(site));
+    }
+
+    void addSite(const Site& site, bool checkPosition = true)
+    {
+      AlignedSequenceContainer::addSite(site, checkPosition);
+      siteAdded_(site, getNumberOfSites() - 1, site.getPosition());
+    }
+
+    void addSite(const Site& site, int position, bool checkPosition = true)
+    {
+      AlignedSequenceContainer::addSite(site, position, checkPosition);
+      siteAdded_(site, getNumberOfSites() - 1, position);
+    }
+
+    void addSite(const Site& site, size_t siteIndex, bool checkPosition = true)
+    {
+      AlignedSequenceContainer::addSite(site, siteIndex, checkPosition);
+      siteAdded_(site, siteIndex, site.getPosition());
+    }
+
+    void addSite(const Site& site, size_t siteIndex, int position, bool checkPosition = true)
+    {
+      AlignedSequenceContainer::addSite(site, siteIndex, position, checkPosition);
+      siteAdded_(site, siteIndex, position);
+    }
+
+    Site* removeSite(size_t siteIndex)
+    {
+      Site* site = AlignedSequenceContainer::removeSite(siteIndex);
+      if (isTransposed())
+        sites_.erase(sites_.begin() + static_cast<ptrdiff_t>(siteIndex));
+      return site;
+    }
+
+    void deleteSite(size_t siteIndex)
+    {
+      AlignedSequenceContainer::deleteSite(siteIndex);
+      if (isTransposed())
+        sites_.erase(sites_.begin() + static_cast<ptrdiff_t>(siteIndex));
+    }
+
+    void deleteSites(size_t siteIndex, size_t length)
+    {
+      AlignedSequenceContainer::deleteSites(siteIndex, length);
+      if (isTransposed())
+        sites_.erase(sites_.begin() + static_cast<ptrdiff_t>(siteIndex), sites_.begin() + static_cast<ptrdiff_t>(siteIndex + length));
+    }
+
+    void reindexSites()
+    {
+      AlignedSequenceContainer::reindexSites();
+      updatePositions_();
+    }
+
+    void setSitePositions(std::vector<int> positions)
+    {
+      AlignedSequenceContainer::setSitePositions(positions);
+      updatePositions_();
+    }
+    /** @} */
+
+  private:
+    void siteAdded_(const Site& site, size_t siteIndex, int position)
+    {
+      if (!isTransposed())
+        return;
+      if (getNumberOfSequences() == 0 || sites_.size() + 1 != getNumberOfSites())
+      {
+        //Adding a site to an empty alignment creates its sequences:
+        releaseSites();
+        return;
+      }
+      std::unique_ptr<Site> copy(new Site(site));
+      copy->setPosition(position);
+      sites_.insert(sites_.begin() + static_cast<ptrdiff_t>(siteIndex), std::move(copy));
+    }
+
+    void updatePositions_()
+    {
+      if (!isTransposed())
+        return;
+      std::vector<int> positions = getSitePositions();
+      for (size_t j = 0; j < sites_.size(); ++j)
+        sites_[j]->setPosition(positions[j]);
+    }
+
+    /*
+     * Sites are built by blocks of columns, one block per task. In each block, the sequences are read
+     * by tiles of tileSize sequences x tileSize positions: the tile of the sequences and the tile of the columns
+     * it is copied to then both fit in the L1 cache. Each column is then copied to its Site.
+     */
+    void transpose_() const
+    {
+      static const size_t tileSize = 64;
+      size_t nbSequences = getNumberOfSequences();
+      size_t nbSites = (nbSequences > 0 ? getNumberOfSites() : 0);
+      std::vector<int> positions = getSitePositions();
+      std::vector<const int*> rows(nbSequences);
+      for (size_t i = 0; i < nbSequences; ++i)
+        rows[i] = (nbSites > 0 ? &AlignedSequenceContainer::getSequence(i).getContent()[0] : 0);
+
+      std::vector< std::unique_ptr<Site> > sites(nbSites);
+      const Alphabet* alphabet = getAlphabet();
+      //Small alignments are not worth starting threads:
+      ThreadPool pool(nbSequences * nbSites < 1000000 ? 1 : nbThreads_);
+      size_t nbBlocks = (nbSites + tileSize - 1) / tileSize;
+      pool.parallelFor(nbBlocks, [&](size_t firstBlock, size_t lastBlock) {
+        BPP_INSTRUMENT_SCOPE(TRANSPOSE);
+        BPP_INSTRUMENT_COUNT(TRANSPOSE, nbSequences * (std::min(lastBlock * tileSize, nbSites) - firstBlock * tileSize));
+        std::vector< std::vector<int> > columns(tileSize, std::vector<int>(nbSequences));
+        for (size_t b = firstBlock; b < lastBlock; ++b)
+        {
+          size_t j0 = b * tileSize;
+          size_t j1 = std::min(j0 + tileSize, nbSites);
+          for (size_t i0 = 0; i0 < nbSequences; i0 += tileSize)
+          {
+            size_t i1 = std::min(i0 + tileSize, nbSequences);
+            for (size_t j = j0; j < j1; ++j)
+            {
+              int* column = &columns[j - j0][0];
+              for (size_t i = i0; i < i1; ++i)
+                column[i] = rows[i][j];
+            }
+          }
+          for (size_t j = j0; j < j1; ++j)
+            sites[j].reset(new Site(columns[j - j0], alphabet, positions[j]));
+        }
+      });
+      sites_.swap(sites);
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_DUALLAYOUTCONTAINER_H_
@@ -0,0 +1,210 @@
+/*
+ * File: ExArenaBenchmark.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 07:40 2026
+ *
+ * Benchmark of the creation and destruction of large sets of short reads: one BasicSequence object
+ * per read, a VectorSequenceContainer, and the slabs of an ArenaSequenceContainer.
+ *
+ * Usage: exarenabenchmark [input.records=1000000] [input.length=150]
+ *                         [bench.warmup=1] [bench.repetitions=5] [output.json.file=arena.json]
+ *
+ * WATCHOUT!!! With the default values, the reads take about 1 GB of memory as BasicSequence objects.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+
+/*
+ * From bpp-core:
+ */
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/App/AttributesTools.h>
+
+/*
+ * The benchmark tools, the synthetic records, and the arena container:
+ */
+#include "BenchmarkTools.h" /* from ExBenchmark */
+#include "SyntheticAlignment.h" /* from ExBenchmark */
+#include "ArenaSequenceContainer.h"
+
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * Reads as they come out of a file: a name and a line of text.
+ */
+struct Reads
+{
+  vector<string> names;
+  vector<string> texts;
+};
+
+/*
+ * All approaches encode the text with the same CharacterTable, so that only the storage differs.
+ */
+static size_t loadObjects(const Reads& reads, const CharacterTable& table)
+{
+  vector<Sequence*> sequences(reads.names.size());
+  vector<int> content;
+  for (size_t i = 0; i < reads.names.size(); ++i)
+  {
+    table.encode(reads.texts[i], content);
+    sequences[i] = new BasicSequence(reads.names[i], content, table.getAlphabet());
+  }
+  size_t total = 0;
+  for (size_t i = 0; i < sequences.size(); ++i)
+  {
+    total += sequences[i]->size();
+    delete sequences[i];
+  }
+  return total;
+}
+
+static size_t loadContainer(const Reads& reads, const CharacterTable& table)
+{
+  VectorSequenceContainer sequences(table.getAlphabet());
+  vector<int> content;
+  for (size_t i = 0; i < reads.names.size(); ++i)
+  {
+    table.encode(reads.texts[i], content);
+    sequences.addSequence(BasicSequence(reads.names[i], content, table.getAlphabet()), false);
+  }
+  return sequences.getNumberOfSequences();
+}
+
+static size_t loadArena(const Reads& reads, ArenaSequenceContainer& sequences)
+{
+  for (size_t i = 0; i < reads.names.size(); ++i)
+    sequences.addSequence(reads.names[i], reads.texts[i]);
+  return sequences.getNumberOfSequences();
+}
+
+/*
+ * Destruction alone: the containers are filled before each measure, see BenchmarkTools::run.
+ */
+static VectorSequenceContainer* fillContainer(const Reads& reads, const CharacterTable& table)
+{
+  VectorSequenceContainer* sequences = new VectorSequenceContainer(table.getAlphabet());
+  vector<int> content;
+  for (size_t i = 0; i < reads.names.size(); ++i)
+  {
+    table.encode(reads.texts[i], content);
+    sequences->addSequence(BasicSequence(reads.names[i], content, table.getAlphabet()), false);
+  }
+  return sequences;
+}
+
+static ArenaSequenceContainer* fillArena(const Reads& reads, const CharacterTable& table)
+{
+  ArenaSequenceContainer* sequences = new ArenaSequenceContainer(table.getAlphabet());
+  loadArena(reads, *sequences);
+  return sequences;
+}
+
+template<class C>
+static size_t destroy(C* sequences)
+{
+  size_t n = sequences->getNumberOfSequences();
+  delete sequences;
+  return n;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+
+int main(int args, char** argv)
+{
+  try
+  {
+    map<string, string> params = AttributesTools::parseOptions(args, argv);
+    size_t nbRecords = static_cast<size_t>(ApplicationTools::getIntParameter("input.records", params, 1000000));
+    size_t length = static_cast<size_t>(ApplicationTools::getIntParameter("input.length", params, 150));
+    unsigned int warmup = static_cast<unsigned int>(ApplicationTools::getIntParameter("bench.warmup", params, 1));
+    unsigned int nrep = static_cast<unsigned int>(ApplicationTools::getIntParameter("bench.repetitions", params, 5));
+    string jsonPath = ApplicationTools::getStringParameter("output.json.file", params, "arena.json");
+    ApplicationTools::displayResult("Number of records", nbRecords);
+    ApplicationTools::displayResult("Record length", length);
+    ApplicationTools::displayResult("Warmup / repetitions", TextTools::toString(warmup) + " / " + TextTools::toString(nrep));
+
+    //Synthetic reads, without gaps, turned back into text:
+    const Alphabet* alphabet = &AlphabetTools::DNA_ALPHABET;
+    CharacterTable table(alphabet);
+    Reads reads;
+    {
+      unique_ptr<VectorSequenceContainer> records(SyntheticAlignment::generate(nbRecords, length, alphabet, 0.1, 0.));
+      reads.names.resize(nbRecords);
+      reads.texts.resize(nbRecords);
+      for (size_t i = 0; i < nbRecords; ++i)
+      {
+        reads.names[i] = records->getSequence(i).getName();
+        table.decode(records->getSequence(i).getContent(), reads.texts[i]);
+      }
+    }
+
+    vector<BenchmarkResult> results;
+    results.push_back(BenchmarkTools::run("load and discard", "new BasicSequence",
+        [&]() { return loadObjects(reads, table); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("load and discard", "VectorSequenceContainer",
+        [&]() { return loadContainer(reads, table); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("load and discard", "ArenaSequenceContainer",
+        [&]() { ArenaSequenceContainer sequences(alphabet); return loadArena(reads, sequences); }, warmup, nrep));
+    //The same container for all batches: after the first one, slabs are reused.
+    ArenaSequenceContainer batch(alphabet);
+    results.push_back(BenchmarkTools::run("load and discard", "ArenaSequenceContainer (reset)",
+        [&]() { batch.reset(); return loadArena(reads, batch); }, warmup, nrep));
+
+    results.push_back(BenchmarkTools::run("teardown", "VectorSequenceContainer",
+        [&]() { return fillContainer(reads, table); }, destroy<VectorSequenceContainer>, 0, nrep));
+    results.push_back(BenchmarkTools::run("teardown", "ArenaSequenceContainer",
+        [&]() { return fillArena(reads, table); }, destroy<ArenaSequenceContainer>, 0, nrep));
+
+    //Check that the arena holds the same reads:
+    for (size_t i = 0; i < nbRecords; ++i)
+    {
+      const ArenaSequence& s = batch.getSequence(i);
+      if (!s.hasName(reads.names[i]) || s.toString() != reads.texts[i])
+        throw Exception("The arena does not give the same sequences.");
+    }
+    ApplicationTools::displayResult("Arena slabs", batch.getArena().getNumberOfSlabs());
+
+    for (size_t i = 0; i < results.size(); ++i)
+      BenchmarkTools::display(results[i]);
+
+    if (jsonPath != "none")
+    {
+      map<string, string> context;
+      context["input.records"] = TextTools::toString(nbRecords);
+      context["input.length"] = TextTools::toString(length);
+      ofstream json(jsonPath.c_str(), ios::out);
+      BenchmarkTools::writeJson(json, context, results);
+      ApplicationTools::displayResult("JSON report written to", jsonPath);
+    }
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
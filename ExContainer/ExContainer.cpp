@@ -21,6 +21,7 @@
  * From the STL:
  */
 #include <iostream> //to be able to output stuff in the terminal.
+#include <memory> //for std::unique_ptr.
 
 /*
  * We'll use the standard template library namespace:
@@ -41,6 +42,20 @@ using namespace std;
  */
 #include <Bpp/App/ApplicationTools.h>
 
+/*
+ * And a reader for large Fasta files, containers with an index of the names,
+ * tools to move sequences into containers, and an alignment with both layouts, in this directory:
+ */
+#include "MappedFasta.h"
+#include "NameIndexedContainer.h"
+#include "SequenceMoveTools.h"
+#include "DualLayoutContainer.h"
+
+/*
+ * The instrumentation of the hot paths, from ExBenchmark:
+ */
+#include "Instrumentation.h" /* from ExBenchmark */
+
 /*
  * All Bio++ functions are also in a namespace, so we'll use it:
  */
@@ -94,6 +109,17 @@ int main(int args, char ** argv)
     cout << vsc->getSequence("Sequence 1").toString() << endl;
     /* still works! */
 
+    /*
+     * When a sequence is not needed anymore after being added, the copy is a waste of time and memory.
+     * A MovableSequence (see SequenceMoveTools.h) gives its content to its first copy instead:
+     * its content is moved, not copied, and the original sequence is left empty.
+     * SequenceMoveTools also gives a sequence we own to a container, and destroys it.
+     */
+    vsc->addSequence(MovableSequence("Sequence 3", "GATTACAGATTACA", &AlphabetTools::DNA_ALPHABET));
+    unique_ptr<Sequence> seq4(new MovableSequence("Sequence 4", "ATTACAGATTACAG", &AlphabetTools::DNA_ALPHABET));
+    SequenceMoveTools::addSequence(*vsc, std::move(seq4));
+    cout << "This container now has " << vsc->getNumberOfSequences() << " sequences." << endl;
+
     /*
      * As before, we have several utilitary methods available.
      */
@@ -116,6 +142,7 @@ int main(int args, char ** argv)
      * - remove the gaps from the alignment
      * - change the gaps to unresolve characters
      * - compute the frequencies of nucleotides
+     * Then have a look at ExSiteStatistics, which computes counts and gap fractions for all sites at once.
      * ----------------
      */
 
@@ -129,6 +156,56 @@ int main(int args, char ** argv)
     cout << "This container has " << sequences->getNumberOfSequences() << " sequences." << endl;
     cout << "Is that an alignment? " << (SequenceContainerTools::sequencesHaveTheSameLength(*sequences) ? "yes" : "no") << endl;
 
+    /*
+     * For large files, the MappedFasta reader (see MappedFasta.h) is a faster alternative:
+     * it maps the file in memory and encodes the states directly from the mapped bytes,
+     * without building any intermediate string. Let's check that both readers agree,
+     * and compare their speed:
+     */
+    OrderedSequenceContainer* mappedSequences = MappedFasta::readSequences("TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    bool identical = (mappedSequences->getNumberOfSequences() == sequences->getNumberOfSequences());
+    for (size_t i = 0; identical && i < sequences->getNumberOfSequences(); i++)
+    {
+      identical = (mappedSequences->getSequence(i).getName() == sequences->getSequence(i).getName())
+               && (mappedSequences->getSequence(i).getContent() == sequences->getSequence(i).getContent());
+    }
+    cout << "Do both readers give the same sequences? " << (identical ? "yes" : "no") << endl;
+    delete mappedSequences;
+
+    unsigned int nload = 100; /* reduce this number if this is too slow on your computer! */
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nload; j++)
+      delete fasReader.readSequences("TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    ApplicationTools::displayTime("Total time used for loading with Fasta:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nload; j++)
+      delete MappedFasta::readSequences("TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    ApplicationTools::displayTime("Total time used for loading with MappedFasta:");
+
+    /*
+     * MappedFasta can also directly create a SiteContainer, without going through a SequenceContainer:
+     */
+    SiteContainer* mappedSites = MappedFasta::readAlignment("TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    cout << "This alignment has " << mappedSites->getNumberOfSequences() << " sequences and " << mappedSites->getNumberOfSites() << " sites." << endl;
+    delete mappedSites;
+
+    /*
+     * Looking for a sequence by name is a linear search in the vector-based containers,
+     * and so is the check of the names when a sequence is added. With tens of thousands of sequences,
+     * this gets slow. The indexed versions of these containers keep a hash table of the names,
+     * and can add a whole container at once, checking the names in linear time
+     * (see ExNameIndexBenchmark for measurements):
+     */
+    IndexedVectorSequenceContainer* indexed = new IndexedVectorSequenceContainer(&AlphabetTools::DNA_ALPHABET);
+    indexed->addSequences(*sequences);
+    string lastName = sequences->getSequence(sequences->getNumberOfSequences() - 1).getName();
+    cout << lastName << " is at position " << indexed->getSequencePosition(lastName) << endl;
+    indexed->renameSequence(lastName, "Last sequence");
+    cout << "Renamed: " << indexed->getSequence("Last sequence").getName() << endl;
+    delete indexed;
+
     /*
      * The Fasta format can store sequences which are aligned or not.
      * It hence returns a SequenceContainer object, not an alignment.
@@ -136,17 +213,37 @@ int main(int args, char ** argv)
      * object from the SequenceContainer. There are two types of SiteContainer objects in Bio++,
      * (i) the AlignedSequenceContainer, which is a specialization of the VectorSequenceContainer,
      * and (ii) the VectorSiteContainer. They differ by the way they store the data.
-     * We will compare them to assess their properties:
+     * We will compare them to assess their properties.
+     * (This is only a rough comparison: see ExBenchmark for proper measurements,
+     * with warmup, repetitions, percentiles and allocation counts.)
      */
-    SiteContainer* align = new AlignedSequenceContainer(*sequences);
+    SiteContainer* align;
+    {
+      BPP_INSTRUMENT_SCOPE(CLONE);
+      BPP_INSTRUMENT_COUNT(CLONE, sequences->getNumberOfSequences());
+      align = new AlignedSequenceContainer(*sequences);
+    }
     SiteContainer* sites = new VectorSiteContainer(*sequences);
 
+    /*
+     * A third type of SiteContainer, the DualLayoutContainer (see DualLayoutContainer.h), stores the sequences
+     * as an AlignedSequenceContainer does, and builds a copy of the data stored by sites the first time a site
+     * is requested. It is then as fast as the best of the two other containers for both kinds of access,
+     * at the cost of twice the memory. Modifications of the alignment update both layouts.
+     */
+    DualLayoutContainer* dual = new DualLayoutContainer(*sequences);
+
+    /*
+     * Creating an AlignedSequenceContainer from a container copies all sequences too.
+     * If the original container is not used afterwards, SequenceMoveTools::moveToAlignment
+     * moves the sequences instead (see ExBenchmark for the memory saved on a large alignment).
+     */
+
     unsigned int nrep = 1000; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
 
     ApplicationTools::startTimer();
     for (unsigned int j = 0; j < nrep; j++)
     {
-      ApplicationTools::displayGauge(j, nrep-1, '=');
       for (unsigned int i = 0; i < align->getNumberOfSequences(); i++)
         align->getSequence(i);
     }
@@ -155,7 +252,9 @@ int main(int args, char ** argv)
     ApplicationTools::startTimer();
     for (unsigned int j = 0; j < nrep; j++)
     {
-      ApplicationTools::displayGauge(j, nrep-1, '=');
+      //Each sequence is rebuilt from the sites:
+      BPP_INSTRUMENT_SCOPE(TRANSPOSE);
+      BPP_INSTRUMENT_COUNT(TRANSPOSE, sites->getNumberOfSequences() * sites->getNumberOfSites());
       for (unsigned int i = 0; i < sites->getNumberOfSequences(); i++)
         sites->getSequence(i);
     }
@@ -164,7 +263,9 @@ int main(int args, char ** argv)
     ApplicationTools::startTimer();
     for (unsigned int j = 0; j < nrep; j++)
     {
-      ApplicationTools::displayGauge(j, nrep-1, '=');
+      //Each site is rebuilt from the sequences:
+      BPP_INSTRUMENT_SCOPE(TRANSPOSE);
+      BPP_INSTRUMENT_COUNT(TRANSPOSE, align->getNumberOfSequences() * align->getNumberOfSites());
       for (unsigned int i = 0; i < align->getNumberOfSites(); i++)
         align->getSite(i);
     }
@@ -173,15 +274,63 @@ int main(int args, char ** argv)
     ApplicationTools::startTimer();
     for (unsigned int j = 0; j < nrep; j++)
     {
-      ApplicationTools::displayGauge(j, nrep-1, '=');
       for (unsigned int i = 0; i < sites->getNumberOfSites(); i++)
         sites->getSite(i);
     }
     ApplicationTools::displayTime("\nTotal time used for site access in VSC:");
 
+    /*
+     * The site layout of the DualLayoutContainer is built at the first call of getSite,
+     * but we can also build it in advance, to see how long it takes:
+     */
+    ApplicationTools::startTimer();
+    dual->transpose();
+    ApplicationTools::displayTime("\nTotal time used for building the site layout in DLC:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nrep; j++)
+    {
+      for (unsigned int i = 0; i < dual->getNumberOfSequences(); i++)
+        dual->getSequence(i);
+    }
+    ApplicationTools::displayTime("\nTotal time used for sequence access in DLC:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nrep; j++)
+    {
+      for (unsigned int i = 0; i < dual->getNumberOfSites(); i++)
+        dual->getSite(i);
+    }
+    ApplicationTools::displayTime("\nTotal time used for site access in DLC:");
+
+    /*
+     * Sites stay up to date when the alignment is modified:
+     */
+    unique_ptr<Sequence> modified(dual->getSequence(0).clone());
+    modified->setElement(0, "A");
+    dual->setSequence(0, *modified);
+    cout << "First site after modification: " << dual->getSite(0).toString() << endl;
+
+    /*
+     * A state can also be changed in place, with valueAt (or operator()). The site layout
+     * is then built again at the next call of getSite:
+     */
+    dual->valueAt(0, 0) = dual->getAlphabet()->charToInt("C");
+    cout << "First site after a change in place: " << dual->getSite(0).toString() << endl;
+    cout << "Same state in the sequence and in the site? " << (dual->getSite(0)[0] == dual->getSequence(0)[0] ? "yes" : "no") << endl;
+
     delete sequences;
     delete align;
     delete sites;
+    delete dual;
+
+    /*
+     * Where did the time go? If this program was built with 'make INSTRUMENTATION=1',
+     * the readers, containers and loops above recorded the time and memory used for parsing,
+     * cloning and transposing. Set the BPP_INSTRUMENTATION_REPORT environment variable to a file name
+     * (e.g. report.json or report.csv) to also save the report when the program exits.
+     */
+    Instrumentation::display();
 
   }
   catch(Exception& e)
@@ -0,0 +1,145 @@
+/*
+ * File: ExNameIndexBenchmark.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 01:05 2026
+ *
+ * Benchmark of the name lookups in a VectorSequenceContainer, with and without the hashed name index
+ * of NameIndexedContainer: loading records with a check of the names, and finding sequences by name.
+ *
+ * Usage: exnameindexbenchmark [input.records=100000] [input.length=100] [bench.lookups=10000]
+ *                             [bench.warmup=0] [bench.repetitions=3] [output.json.file=nameindex.json]
+ *
+ * WATCHOUT!!! Loading with the plain container is quadratic: with the default 100,000 records,
+ * each repetition takes several seconds.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+
+/*
+ * From bpp-core:
+ */
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/App/AttributesTools.h>
+
+/*
+ * The benchmark tools, the synthetic records, and the indexed containers:
+ */
+#include "BenchmarkTools.h" /* from ExBenchmark */
+#include "SyntheticAlignment.h" /* from ExBenchmark */
+#include "NameIndexedContainer.h"
+
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * Load all records one by one, checking that names are unique, as readers do.
+ */
+template<class C>
+static size_t load(const OrderedSequenceContainer& records)
+{
+  C container(records.getAlphabet());
+  for (size_t i = 0; i < records.getNumberOfSequences(); ++i)
+    container.addSequence(records.getSequence(i), true);
+  return container.getNumberOfSequences();
+}
+
+static size_t bulkLoad(const OrderedSequenceContainer& records)
+{
+  IndexedVectorSequenceContainer container(records.getAlphabet());
+  container.addSequences(records);
+  return container.getNumberOfSequences();
+}
+
+static size_t lookup(const SequenceContainer& container, const vector<string>& names)
+{
+  size_t total = 0;
+  for (size_t i = 0; i < names.size(); ++i)
+    total += container.getSequence(names[i]).size();
+  return total;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+
+int main(int args, char** argv)
+{
+  try
+  {
+    map<string, string> params = AttributesTools::parseOptions(args, argv);
+    size_t nbRecords = static_cast<size_t>(ApplicationTools::getIntParameter("input.records", params, 100000));
+    size_t length = static_cast<size_t>(ApplicationTools::getIntParameter("input.length", params, 100));
+    size_t nbLookups = static_cast<size_t>(ApplicationTools::getIntParameter("bench.lookups", params, 10000));
+    unsigned int warmup = static_cast<unsigned int>(ApplicationTools::getIntParameter("bench.warmup", params, 0));
+    unsigned int nrep = static_cast<unsigned int>(ApplicationTools::getIntParameter("bench.repetitions", params, 3));
+    string jsonPath = ApplicationTools::getStringParameter("output.json.file", params, "nameindex.json");
+    ApplicationTools::displayResult("Number of records", nbRecords);
+    ApplicationTools::displayResult("Record length", length);
+    ApplicationTools::displayResult("Warmup / repetitions", TextTools::toString(warmup) + " / " + TextTools::toString(nrep));
+
+    VectorSequenceContainer* records = SyntheticAlignment::generate(nbRecords, length, &AlphabetTools::DNA_ALPHABET);
+
+    vector<BenchmarkResult> results;
+    results.push_back(BenchmarkTools::run("load", "VectorSequenceContainer",
+        [&]() { return load<VectorSequenceContainer>(*records); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("load", "IndexedVectorSequenceContainer",
+        [&]() { return load<IndexedVectorSequenceContainer>(*records); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("load", "IndexedVectorSequenceContainer (bulk)",
+        [&]() { return bulkLoad(*records); }, warmup, nrep));
+
+    //Random names, looked for in both containers:
+    mt19937 rng(42);
+    uniform_int_distribution<size_t> record(0, nbRecords - 1);
+    vector<string> names(nbLookups);
+    for (size_t i = 0; i < nbLookups; ++i)
+      names[i] = records->getSequence(record(rng)).getName();
+    IndexedVectorSequenceContainer indexed(*records);
+    results.push_back(BenchmarkTools::run("lookup", "VectorSequenceContainer",
+        [&]() { return lookup(*records, names); }, warmup, nrep));
+    results.push_back(BenchmarkTools::run("lookup", "IndexedVectorSequenceContainer",
+        [&]() { return lookup(indexed, names); }, warmup, nrep));
+    if (lookup(*records, names) != lookup(indexed, names))
+      throw Exception("Both containers do not give the same sequences.");
+
+    for (size_t i = 0; i < results.size(); ++i)
+      BenchmarkTools::display(results[i]);
+
+    if (jsonPath != "none")
+    {
+      map<string, string> context;
+      context["input.records"] = TextTools::toString(nbRecords);
+      context["input.length"] = TextTools::toString(length);
+      context["bench.lookups"] = TextTools::toString(nbLookups);
+      ofstream json(jsonPath.c_str(), ios::out);
+      BenchmarkTools::writeJson(json, context, results);
+      ApplicationTools::displayResult("JSON report written to", jsonPath);
+    }
+    delete records;
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
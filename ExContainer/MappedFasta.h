@@ -0,0 +1,287 @@
+/*
+ * File: MappedFasta.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 10:02 2026
+ *
+ * A Fasta reader for large alignments, working on a memory-mapped file.
+ */
+
+#ifndef _MAPPEDFASTA_H_
+#define _MAPPEDFASTA_H_
+
+#include "CharacterTable.h"
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/SequenceExceptions.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bpp
+{
+  /**
+   * @brief Fasta reader working on a memory-mapped file.
+   *
+   * The file is mapped and indexed in a single pass when the object is created:
+   * only the offsets of the names and sequences are stored. States are then encoded
+   * directly from the mapped bytes to the integer codes of the alphabet, without
+   * building intermediate strings. Line breaks and white spaces inside sequences are ignored.
+   *
+   * Sequence names are the full header lines, as with the Fasta class.
+   * The file remains mapped until the object is destroyed.
+   */
+  class MappedFasta
+  {
+  private:
+    struct Record
+    {
+      size_t nameBegin, nameEnd;
+      size_t sequenceBegin, sequenceEnd;
+    };
+
+    const char* data_;
+    size_t size_;
+    std::vector<Record> records_;
+
+  public:
+    /**
+     * @param path The Fasta file to map.
+     * @throw IOException If the file can't be opened or mapped.
+     */
+    MappedFasta(const std::string& path) : data_(0), size_(0), records_()
+    {
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        throw IOException("MappedFasta: can't open file " + path);
+      struct stat st;
+      if (::fstat(fd, &st) != 0)
+      {
+        ::close(fd);
+        throw IOException("MappedFasta: can't stat file " + path);
+      }
+      size_ = static_cast<size_t>(st.st_size);
+      if (size_ > 0)
+      {
+        void* map = ::mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+          ::close(fd);
+          throw IOException("MappedFasta: can't map file " + path);
+        }
+        ::madvise(map, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(map);
+      }
+      ::close(fd);
+      index_();
+    }
+
+    ~MappedFasta()
+    {
+      if (data_)
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+
+  private:
+    MappedFasta(const MappedFasta&);
+    MappedFasta& operator=(const MappedFasta&);
+
+  public:
+    size_t getNumberOfSequences() const { return records_.size(); }
+
+    /**
+     * @return The name of the ith sequence in the file.
+     */
+    std::string getName(size_t i) const
+    {
+      const Record& r = records_.at(i);
+      return std::string(data_ + r.nameBegin, r.nameEnd - r.nameBegin);
+    }
+
+    /**
+     * @return The number of bytes of the ith sequence in the file, including line breaks.
+     * This is an upper bound of its length, known without encoding it.
+     */
+    size_t getRawLength(size_t i) const
+    {
+      const Record& r = records_.at(i);
+      return r.sequenceEnd - r.sequenceBegin;
+    }
+
+    /**
+     * @brief Encode the ith sequence of the file.
+     *
+     * @param i       The index of the sequence.
+     * @param table   The character table of the alphabet to use.
+     * @param content [out] The vector where to store the states. Its previous content is erased.
+     * @throw BadCharException If a character is not in the alphabet.
+     */
+    void encode(size_t i, const CharacterTable& table, std::vector<int>& content) const
+    {
+      BPP_INSTRUMENT_SCOPE(ENCODE);
+      const Record& r = records_.at(i);
+      content.clear();
+      content.reserve(r.sequenceEnd - r.sequenceBegin);
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(data_ + r.sequenceBegin);
+      const unsigned char* end = reinterpret_cast<const unsigned char*>(data_ + r.sequenceEnd);
+      for ( ; p < end; ++p)
+      {
+        int code = table[*p];
+        if (code == CharacterTable::UNDEFINED)
+        {
+          if (isspace(*p))
+            continue;
+          throw BadCharException(std::string(1, static_cast<char>(*p)), "MappedFasta::encode. In sequence " + getName(i));
+        }
+        content.push_back(code);
+      }
+      BPP_INSTRUMENT_COUNT(ENCODE, content.size());
+    }
+
+    /**
+     * @brief Create a container with all sequences of the file.
+     *
+     * @param alphabet The alphabet to use.
+     * @return A new VectorSequenceContainer object.
+     */
+    VectorSequenceContainer* readSequences(const Alphabet* alphabet) const
+    {
+      BPP_INSTRUMENT_SCOPE(PARSE);
+      BPP_INSTRUMENT_COUNT(PARSE, records_.size());
+      CharacterTable table(alphabet);
+      VectorSequenceContainer* sequences = new VectorSequenceContainer(alphabet);
+      std::vector<int> content;
+      for (size_t i = 0; i < records_.size(); ++i)
+      {
+        encode(i, table, content);
+        BPP_INSTRUMENT_SCOPE(CLONE);
+        BPP_INSTRUMENT_COUNT(CLONE, 1);
+        sequences->addSequence(BasicSequence(getName(i), content, alphabet), true);
+      }
+      return sequences;
+    }
+
+    /**
+     * @brief Create an alignment with all sequences of the file.
+     *
+     * Sites are filled directly from the encoded rows, so that no intermediate
+     * sequence container is created.
+     *
+     * @param alphabet The alphabet to use.
+     * @return A new VectorSiteContainer object.
+     * @throw SequenceNotAlignedException If sequences do not all have the same length.
+     */
+    VectorSiteContainer* readAlignment(const Alphabet* alphabet) const
+    {
+      BPP_INSTRUMENT_SCOPE(PARSE);
+      BPP_INSTRUMENT_COUNT(PARSE, records_.size());
+      CharacterTable table(alphabet);
+      size_t nbSeq = records_.size();
+      std::vector<std::string> names(nbSeq);
+      std::vector<int> content;
+      std::vector<int> matrix; //row-major
+      size_t nbSites = 0;
+      for (size_t i = 0; i < nbSeq; ++i)
+      {
+        names[i] = getName(i);
+        encode(i, table, content);
+        if (i == 0)
+        {
+          nbSites = content.size();
+          matrix.resize(nbSeq * nbSites);
+        }
+        else if (content.size() != nbSites)
+          throw SequenceNotAlignedException("MappedFasta::readAlignment. Sequence " + names[i] + " does not have the same length as the previous ones.", 0);
+        std::copy(content.begin(), content.end(), matrix.begin() + static_cast<std::ptrdiff_t>(i * nbSites));
+      }
+      BPP_INSTRUMENT_SCOPE(TRANSPOSE);
+      BPP_INSTRUMENT_COUNT(TRANSPOSE, nbSeq * nbSites);
+      VectorSiteContainer* sites = new VectorSiteContainer(names, alphabet);
+      std::vector<int> column(nbSeq);
+      for (size_t j = 0; j < nbSites; ++j)
+      {
+        for (size_t i = 0; i < nbSeq; ++i)
+          column[i] = matrix[i * nbSites + j];
+        sites->addSite(Site(column, alphabet, static_cast<int>(j + 1)), false);
+      }
+      return sites;
+    }
+
+    /**
+     * @brief Convenience function: map a file and read all its sequences.
+     */
+    static VectorSequenceContainer* readSequences(const std::string& path, const Alphabet* alphabet)
+    {
+      BPP_INSTRUMENT_SCOPE(PARSE);
+      MappedFasta fasta(path);
+      return fasta.readSequences(alphabet);
+    }
+
+    /**
+     * @brief Convenience function: map a file and read it as an alignment.
+     */
+    static VectorSiteContainer* readAlignment(const std::string& path, const Alphabet* alphabet)
+    {
+      BPP_INSTRUMENT_SCOPE(PARSE);
+      MappedFasta fasta(path);
+      return fasta.readAlignment(alphabet);
+    }
+
+  private:
+    /*
+     * Single pass over the file, looking for header lines.
+     */
+    void index_()
+    {
+      BPP_INSTRUMENT_SCOPE(PARSE);
+      size_t pos = 0;
+      //Skip anything before the first header:
+      while (pos < size_ && !(data_[pos] == '>' && (pos == 0 || data_[pos - 1] == '\n')))
+        ++pos;
+      while (pos < size_)
+      {
+        Record r;
+        r.nameBegin = pos + 1;
+        const char* eol = static_cast<const char*>(std::memchr(data_ + pos, '\n', size_ - pos));
+        size_t lineEnd = eol ? static_cast<size_t>(eol - data_) : size_;
+        r.nameEnd = lineEnd;
+        while (r.nameEnd > r.nameBegin && isspace(static_cast<unsigned char>(data_[r.nameEnd - 1])))
+          --r.nameEnd;
+        r.sequenceBegin = std::min(lineEnd + 1, size_);
+        //Next header:
+        pos = r.sequenceBegin;
+        while (pos < size_)
+        {
+          const char* next = static_cast<const char*>(std::memchr(data_ + pos, '>', size_ - pos));
+          if (!next)
+          {
+            pos = size_;
+            break;
+          }
+          pos = static_cast<size_t>(next - data_);
+          if (data_[pos - 1] == '\n')
+            break;
+          ++pos;
+        }
+        r.sequenceEnd = pos;
+        records_.push_back(r);
+      }
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_MAPPEDFASTA_H_
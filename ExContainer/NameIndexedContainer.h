@@ -0,0 +1,285 @@
+/*
+ * File: NameIndexedContainer.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 01:05 2026
+ *
+ * Vector-based containers with a hashed index of the sequence names.
+ */
+
+#ifndef _NAMEINDEXEDCONTAINER_H_
+#define _NAMEINDEXEDCONTAINER_H_
+
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Container/SequenceContainerExceptions.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A vector-based container with a hashed index of the sequence names.
+   *
+   * The vector-based containers find a sequence by name with a linear search, and adding a sequence
+   * with a check of the names is hence linear too: loading n sequences costs O(n^2).
+   * This class adds a hash table from the names to the positions of the sequences, so that
+   * getSequence(name), hasSequence(name), getSequencePosition(name) and the checks of addSequence()
+   * take constant time. The index is kept up to date when sequences are added, removed, replaced or renamed.
+   * Insertions and removals in the middle of the container still shift the positions of the next
+   * sequences, and update the index in linear time, as they do for the underlying vector.
+   *
+   * addSequences() adds all the sequences of a container at once, checking that the names are unique
+   * in linear time: if a name is duplicated, an exception is thrown and nothing is added.
+   *
+   * When names are not checked, duplicated names are allowed, as in the underlying container:
+   * lookups then return the first sequence with that name.
+   *
+   * @tparam Container The vector-based container to extend: VectorSequenceContainer,
+   * AlignedSequenceContainer or VectorSiteContainer (see the typedefs below).
+   */
+  template<class Container>
+  class NameIndexedContainer :
+    public Container
+  {
+  private:
+    std::unordered_map<std::string, size_t> index_;
+    bool hasDuplicates_;
+
+  public:
+    explicit NameIndexedContainer(const Alphabet* alphabet) :
+      Container(alphabet), index_(), hasDuplicates_(false)
+    {}
+
+    /**
+     * @brief Copy the sequences of another container, checking the names in linear time.
+     */
+    explicit NameIndexedContainer(const OrderedSequenceContainer& sequences) :
+      Container(sequences.getAlphabet()), index_(), hasDuplicates_(false)
+    {
+      addSequences(sequences);
+    }
+
+    NameIndexedContainer* clone() const { return new NameIndexedContainer(*this); }
+
+    virtual ~NameIndexedContainer() {}
+
+  public:
+    using Container::getSequence;
+    using Container::addSequence;
+    using Container::setSequence;
+    using Container::removeSequence;
+    using Container::deleteSequence;
+
+    const Sequence& getSequence(const std::string& name) const
+    {
+      return Container::getSequence(getSequencePosition(name));
+    }
+
+    bool hasSequence(const std::string& name) const
+    {
+      return index_.find(name) != index_.end();
+    }
+
+    size_t getSequencePosition(const std::string& name) const
+    {
+      std::unordered_map<std::string, size_t>::const_iterator it = index_.find(name);
+      if (it == index_.end())
+        throw SequenceNotFoundException("NameIndexedContainer::getSequencePosition", name);
+      return it->second;
+    }
+
+    void addSequence(const Sequence& sequence, bool checkName = true)
+    {
+      checkName_(sequence.getName(), checkName, "NameIndexedContainer::addSequence");
+      BPP_INSTRUMENT_SCOPE(CLONE);
+      BPP_INSTRUMENT_COUNT(CLONE, 1);
+      Container::addSequence(sequence, false);
+      insert_(sequence.getName(), this->getNumberOfSequences() - 1);
+    }
+
+    void addSequence(const Sequence& sequence, size_t sequenceIndex, bool checkName = true)
+    {
+      checkName_(sequence.getName(), checkName, "NameIndexedContainer::addSequence");
+      BPP_INSTRUMENT_SCOPE(CLONE);
+      BPP_INSTRUMENT_COUNT(CLONE, 1);
+      Container::addSequence(sequence, sequenceIndex, false);
+      for (std::unordered_map<std::string, size_t>::iterator it = index_.begin(); it != index_.end(); ++it)
+        if (it->second >= sequenceIndex)
+          ++it->second;
+      insert_(sequence.getName(), sequenceIndex);
+    }
+
+    /**
+     * @brief Add all the sequences of a container.
+     *
+     * @param sequences  The sequences to add.
+     * @param checkNames Check that the names are unique, including with the sequences already in this container.
+     * @throw Exception If a name is duplicated. No sequence is added in this case.
+     */
+    void addSequences(const OrderedSequenceContainer& sequences, bool checkNames = true)
+    {
+      size_t n = sequences.getNumberOfSequences();
+      if (checkNames)
+      {
+        std::unordered_set<std::string> names(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+          const std::string& name = sequences.getSequence(i).getName();
+          if (hasSequence(name) || !names.insert(name).second)
+            throw Exception("NameIndexedContainer::addSequences : Sequence '" + name + "' already exists in container.");
+        }
+      }
+      BPP_INSTRUMENT_SCOPE(CLONE);
+      BPP_INSTRUMENT_COUNT(CLONE, n);
+      index_.reserve(index_.size() + n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        const Sequence& sequence = sequences.getSequence(i);
+        Container::addSequence(sequence, false);
+        insert_(sequence.getName(), this->getNumberOfSequences() - 1);
+      }
+    }
+
+    void setSequence(size_t sequenceIndex, const Sequence& sequence, bool checkName = true)
+    {
+      std::string oldName = Container::getSequence(sequenceIndex).getName();
+      const std::string& name = sequence.getName();
+      if (name != oldName)
+        checkName_(name, checkName, "NameIndexedContainer::setSequence");
+      Container::setSequence(sequenceIndex, sequence, false);
+      if (name != oldName)
+        rename_(sequenceIndex, oldName, name);
+    }
+
+    void setSequence(const std::string& name, const Sequence& sequence, bool checkName = true)
+    {
+      setSequence(getSequencePosition(name), sequence, checkName);
+    }
+
+    /**
+     * @brief Change the name of a sequence.
+     *
+     * @throw SequenceNotFoundException If there is no sequence with the old name.
+     * @throw Exception If checkName is true and a sequence already has the new name.
+     */
+    void renameSequence(const std::string& oldName, const std::string& newName, bool checkName = true)
+    {
+      size_t sequenceIndex = getSequencePosition(oldName);
+      std::unique_ptr<Sequence> sequence(Container::getSequence(sequenceIndex).clone());
+      sequence->setName(newName);
+      setSequence(sequenceIndex, *sequence, checkName);
+    }
+
+    void setSequencesNames(const std::vector<std::string>& names, bool checkNames = true)
+    {
+      Container::setSequencesNames(names, checkNames);
+      rebuild_();
+    }
+
+    Sequence* removeSequence(size_t sequenceIndex)
+    {
+      Sequence* sequence = Container::removeSequence(sequenceIndex);
+      removed_(sequenceIndex, sequence->getName());
+      return sequence;
+    }
+
+    Sequence* removeSequence(const std::string& name)
+    {
+      return removeSequence(getSequencePosition(name));
+    }
+
+    void deleteSequence(size_t sequenceIndex)
+    {
+      std::string name = Container::getSequence(sequenceIndex).getName();
+      Container::deleteSequence(sequenceIndex);
+      removed_(sequenceIndex, name);
+    }
+
+    void deleteSequence(const std::string& name)
+    {
+      deleteSequence(getSequencePosition(name));
+    }
+
+    void clear()
+    {
+      Container::clear();
+      index_.clear();
+      hasDuplicates_ = false;
+    }
+
+  private:
+    void checkName_(const std::string& name, bool checkName, const std::string& method) const
+    {
+      if (checkName && hasSequence(name))
+        throw Exception(method + " : Sequence '" + name + "' already exists in container.");
+    }
+
+    /*
+     * Index a name at a given position. If the name is already there, the first position is kept.
+     */
+    void insert_(const std::string& name, size_t position)
+    {
+      std::pair<std::unordered_map<std::string, size_t>::iterator, bool> r = index_.insert(std::make_pair(name, position));
+      if (!r.second)
+      {
+        hasDuplicates_ = true;
+        if (position < r.first->second)
+          r.first->second = position;
+      }
+    }
+
+    void rename_(size_t position, const std::string& oldName, const std::string& newName)
+    {
+      if (hasDuplicates_)
+      {
+        rebuild_();
+        return;
+      }
+      index_.erase(oldName);
+      insert_(newName, position);
+    }
+
+    void removed_(size_t position, const std::string& name)
+    {
+      if (hasDuplicates_)
+      {
+        rebuild_();
+        return;
+      }
+      index_.erase(name);
+      for (std::unordered_map<std::string, size_t>::iterator it = index_.begin(); it != index_.end(); ++it)
+        if (it->second > position)
+          --it->second;
+    }
+
+    /*
+     * Index all names again, when duplicated names make an incremental update ambiguous.
+     */
+    void rebuild_()
+    {
+      index_.clear();
+      hasDuplicates_ = false;
+      std::vector<std::string> names = this->getSequencesNames();
+      index_.reserve(names.size());
+      for (size_t i = 0; i < names.size(); ++i)
+        insert_(names[i], i);
+    }
+  };
+
+  typedef NameIndexedContainer<VectorSequenceContainer> IndexedVectorSequenceContainer;
+  typedef NameIndexedContainer<AlignedSequenceContainer> IndexedAlignedSequenceContainer;
+  typedef NameIndexedContainer<VectorSiteContainer> IndexedVectorSiteContainer;
+
+} //end of namespace bpp.
+
+#endif //_NAMEINDEXEDCONTAINER_H_
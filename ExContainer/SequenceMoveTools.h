@@ -0,0 +1,224 @@
+/*
+ * File: SequenceMoveTools.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 01:50 2026
+ *
+ * Adding sequences to containers by moving their content instead of copying it.
+ */
+
+#ifndef _SEQUENCEMOVETOOLS_H_
+#define _SEQUENCEMOVETOOLS_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Text/TextTools.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/SequenceExceptions.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A BasicSequence which gives its content to its next copy.
+   *
+   * Containers store a clone of the sequences they are given, so that they own their data. When a sequence
+   * was just read or generated, and is not used afterwards, this copies every state and doubles the peak memory.
+   * The first clone of a MovableSequence takes its content instead, and the MovableSequence is left empty.
+   * The clone is itself a MovableSequence, which is copied as usual (see SequenceMoveTools to move it again).
+   *
+   * @code
+   * container.addSequence(MovableSequence(name, std::move(content), alphabet), false);
+   * @endcode
+   */
+  class MovableSequence :
+    public BasicSequence
+  {
+  private:
+    mutable bool movable_;
+
+  public:
+    /**
+     * @param name     The name of the sequence.
+     * @param sequence The sequence, as a string.
+     * @param alphabet The alphabet of the sequence.
+     * @throw BadCharException If a character is not in the alphabet.
+     */
+    MovableSequence(const std::string& name, const std::string& sequence, const Alphabet* alphabet) :
+      BasicSequence(name, sequence, alphabet), movable_(true)
+    {}
+
+    /**
+     * @param name     The name of the sequence.
+     * @param content  The states of the sequence, which are moved, not copied.
+     * @param alphabet The alphabet of the sequence.
+     * @throw BadIntException If a state is not in the alphabet. The content is then left unchanged.
+     */
+    MovableSequence(const std::string& name, std::vector<int>&& content, const Alphabet* alphabet) :
+      BasicSequence(name, std::vector<int>(), alphabet), movable_(true)
+    {
+      for (size_t i = 0; i < content.size(); ++i)
+      {
+        if (!alphabet->isIntInAlphabet(content[i]))
+          throw BadIntException(content[i], "MovableSequence. Invalid state, at position " + TextTools::toString(i + 1), alphabet);
+      }
+      content_.swap(content);
+    }
+
+    virtual ~MovableSequence() {}
+
+  public:
+    /**
+     * @brief Copy the sequence. The first copy takes the content of this sequence, which is then empty.
+     */
+    MovableSequence* clone() const
+    {
+      MovableSequence* copy = new MovableSequence(getName(), std::vector<int>(), getAlphabet());
+      copy->setComments(getComments());
+      copy->movable_ = false;
+      if (movable_)
+      {
+        //Sequence::clone is const: the content given away is the only thing it modifies.
+        copy->content_.swap(const_cast<MovableSequence*>(this)->content_);
+        movable_ = false;
+      }
+      else
+        copy->content_ = content_;
+      return copy;
+    }
+
+    /**
+     * @return True if the next copy of this sequence takes its content.
+     */
+    bool isMovable() const { return movable_; }
+
+    friend class SequenceMoveTools;
+  };
+
+  /**
+   * @brief Moving sequences between containers without copying their content.
+   *
+   * The sequences removed from a container belong to the caller, who can give them to another container.
+   * MovableSequence objects, as the ones stored after adding a MovableSequence, give their content to the new container.
+   * Other sequences are copied, but each of them is destroyed as soon as it is copied, so that the peak memory
+   * only grows by one sequence instead of doubling.
+   */
+  class SequenceMoveTools
+  {
+  public:
+    /**
+     * @brief Add a sequence to a container, and destroy it.
+     *
+     * @param container The container.
+     * @param sequence  The sequence to add. The content of a MovableSequence is moved, other sequences are copied.
+     * @param checkName Check that the container does not already have a sequence with the same name.
+     * @throw Exception If the container rejects the sequence.
+     */
+    static void addSequence(SequenceContainer& container, std::unique_ptr<Sequence> sequence, bool checkName = true)
+    {
+      give_(container, *sequence, checkName);
+    }
+
+    /**
+     * @brief Move all the sequences of a container to the end of another one.
+     *
+     * The source container is empty afterwards.
+     *
+     * @param from       The source container.
+     * @param to         The target container.
+     * @param checkNames Check that the names are unique in the target container.
+     * @throw Exception If a name is duplicated, or if both containers are the same. No sequence is moved in this case.
+     * @throw Exception If the target container rejects a sequence. This sequence and the following ones are put back
+     * in the source container.
+     */
+    static void moveSequences(VectorSequenceContainer& from, VectorSequenceContainer& to, bool checkNames = true)
+    {
+      if (&from == &to)
+        throw Exception("SequenceMoveTools::moveSequences : source and target containers must be different.");
+      size_t n = from.getNumberOfSequences();
+      if (checkNames)
+      {
+        std::unordered_set<std::string> names(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+          const std::string& name = from.getSequence(i).getName();
+          if (to.hasSequence(name) || !names.insert(name).second)
+            throw Exception("SequenceMoveTools::moveSequences : Sequence '" + name + "' already exists in container.");
+        }
+      }
+      std::vector< std::unique_ptr<Sequence> > sequences = removeSequences_(from);
+      size_t i = 0;
+      try
+      {
+        for ( ; i < n; ++i)
+        {
+          give_(to, *sequences[i], false);
+          sequences[i].reset();
+        }
+      }
+      catch (...)
+      {
+        for ( ; i < n; ++i)
+          give_(from, *sequences[i], false);
+        throw;
+      }
+    }
+
+    /**
+     * @brief Create an alignment from a container of sequences, taking their content.
+     *
+     * This replaces new AlignedSequenceContainer(*sequences) when the sequences are not needed anymore.
+     * The sequences of a VectorSequenceContainer are removed from it, and given to the alignment one by one,
+     * as with addSequence(). Names are not checked again; the alignment checks the lengths.
+     *
+     * @param sequences The sequences, which are destroyed.
+     * @return A new AlignedSequenceContainer object.
+     * @throw SequenceNotAlignedException If sequences do not all have the same length.
+     */
+    static AlignedSequenceContainer* moveToAlignment(std::unique_ptr<OrderedSequenceContainer> sequences)
+    {
+      VectorSequenceContainer* source = dynamic_cast<VectorSequenceContainer*>(sequences.get());
+      if (!source)
+        return new AlignedSequenceContainer(*sequences);
+      std::unique_ptr<AlignedSequenceContainer> alignment(new AlignedSequenceContainer(source->getAlphabet()));
+      alignment->setGeneralComments(source->getGeneralComments());
+      std::vector< std::unique_ptr<Sequence> > removed = removeSequences_(*source);
+      for (size_t i = 0; i < removed.size(); ++i)
+      {
+        give_(*alignment, *removed[i], false);
+        removed[i].reset();
+      }
+      return alignment.release();
+    }
+
+  private:
+    static void give_(SequenceContainer& container, Sequence& sequence, bool checkName)
+    {
+      MovableSequence* movable = dynamic_cast<MovableSequence*>(&sequence);
+      if (movable)
+        movable->movable_ = true;
+      container.addSequence(sequence, checkName);
+    }
+
+    /*
+     * Sequences are removed from the end, so that no pointer is shifted in the container.
+     */
+    static std::vector< std::unique_ptr<Sequence> > removeSequences_(VectorSequenceContainer& container)
+    {
+      size_t n = container.getNumberOfSequences();
+      std::vector< std::unique_ptr<Sequence> > sequences(n);
+      for (size_t i = n; i > 0; --i)
+        sequences[i - 1].reset(container.removeSequence(i - 1));
+      return sequences;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_SEQUENCEMOVETOOLS_H_
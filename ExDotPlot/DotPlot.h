@@ -0,0 +1,586 @@
+/*
+ * File: DotPlot.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 23:40 2026
+ *
+ * Bit-parallel dot plots of two sequences, with a sliding window and a threshold.
+ */
+
+#ifndef _DOTPLOT_H_
+#define _DOTPLOT_H_
+
+#include "ThreadPool.h" /* from ExParallelFasta */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Sequence.h>
+
+#include <algorithm>
+#include <ostream>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A dot plot of two sequences, computed 64 cells at a time.
+   *
+   * The dot plot has a dot at (i, j) if the window of 'window' positions starting at position i
+   * of the first sequence (the rows) and the one starting at position j of the second sequence
+   * (the columns) have at least 'threshold' identical states. With a window of 1, this is
+   * the plain dot plot of ExSequence. With threshold == window, this is the plot of the
+   * exact k-mer matches, with k = window.
+   *
+   * The columns sequence is stored as one bit mask per state, so that the matches of row i
+   * are the mask of the state at position i of the rows sequence. The number of matches
+   * in each window is kept in bit-sliced counters (one bit plane per bit of the count),
+   * and updated from one row to the next along the diagonals: the counters are shifted by one
+   * column, the matches leaving the window are subtracted, and the matches entering it are added.
+   * Each row hence costs a few operations per 64 columns, whatever the window size.
+   *
+   * This is still quadratic in the length of the sequences. Plots of exact k-mer matches (threshold == window)
+   * are usually sparse: when the windows of both sequences share few k-mers, forEachDot() and getBitmap()
+   * hash the windows of the columns, and each row only visits the columns with the same hash.
+   *
+   * States are compared by their codes, as Sequence::getChar would: two identical ambiguity
+   * codes are a match, and so are two gaps.
+   */
+  class DotPlot
+  {
+  private:
+    enum { MAX_PLANES = 32 };
+    std::vector<int> rows_;
+    std::vector<int> columns_;
+    size_t nbColumns_;
+    size_t window_;
+    size_t threshold_;
+    size_t nbPlanes_;
+    size_t padding_;   //Columns are stored with window - 1 empty columns on the left.
+    size_t words_;     //Number of words per row.
+    int minState_;
+    //For each state, indexed by state - minState_: the columns where it appears,
+    //the same shifted by one column to the right, and shifted by window - 1 columns to the left.
+    std::vector< std::vector<uint64_t> > masks_;
+    std::vector< std::vector<uint64_t> > leaving_;
+    std::vector< std::vector<uint64_t> > entering_;
+    std::vector<uint64_t> empty_;
+
+    /*
+     * The windows of the columns, hashed and chained in increasing order, and the hash of each window of the rows.
+     * Chains store column + 1, and end with 0.
+     */
+    struct KmerTable
+    {
+      std::vector<size_t> heads;
+      std::vector<size_t> next;
+      std::vector<uint32_t> rowHashes;
+    };
+
+  public:
+    /**
+     * @param rows      The sequence displayed vertically.
+     * @param columns   The sequence displayed horizontally.
+     * @param window    The size of the window.
+     * @param threshold The minimum number of matches in a window. 0 means the window size.
+     * @throw AlphabetMismatchException If the sequences do not have the same alphabet.
+     * @throw Exception If the threshold is larger than the window.
+     */
+    DotPlot(const Sequence& rows, const Sequence& columns, size_t window = 1, size_t threshold = 0) :
+      rows_(), columns_(), nbColumns_(0), window_(0), threshold_(0), nbPlanes_(0), padding_(0), words_(0), minState_(0),
+      masks_(), leaving_(), entering_(), empty_()
+    {
+      if (rows.getAlphabet()->getAlphabetType() != columns.getAlphabet()->getAlphabetType())
+        throw AlphabetMismatchException("DotPlot. Sequences must have the same alphabet.", rows.getAlphabet(), columns.getAlphabet());
+      init_(rows.getContent(), columns.getContent(), window, threshold);
+    }
+
+    /**
+     * @param rows      The states of the sequence displayed vertically.
+     * @param columns   The states of the sequence displayed horizontally.
+     * @param window    The size of the window.
+     * @param threshold The minimum number of matches in a window. 0 means the window size.
+     */
+    DotPlot(const std::vector<int>& rows, const std::vector<int>& columns, size_t window = 1, size_t threshold = 0) :
+      rows_(), columns_(), nbColumns_(0), window_(0), threshold_(0), nbPlanes_(0), padding_(0), words_(0), minState_(0),
+      masks_(), leaving_(), entering_(), empty_()
+    {
+      init_(rows, columns, window, threshold);
+    }
+
+  public:
+    size_t getWindowSize() const { return window_; }
+    size_t getThreshold() const { return threshold_; }
+
+    /**
+     * @return The number of rows of the plot: the number of windows in the first sequence.
+     */
+    size_t getNumberOfRows() const { return rows_.size() >= window_ ? rows_.size() - window_ + 1 : 0; }
+
+    /**
+     * @return The number of columns of the plot: the number of windows in the second sequence.
+     */
+    size_t getNumberOfColumns() const { return nbColumns_ >= window_ ? nbColumns_ - window_ + 1 : 0; }
+
+    /**
+     * @return The number of 64 bits words needed to store a row of the plot.
+     */
+    size_t getNumberOfWordsPerRow() const { return (getNumberOfColumns() + 63) / 64; }
+
+    /**
+     * @brief Compute rows [begin, end) of the plot, on the calling thread.
+     *
+     * @param begin The first row.
+     * @param end   The last row (excluded).
+     * @param f     A function called as f(i, bits) for each row i, where bits has getNumberOfWordsPerRow() words,
+     *              and bit j % 64 of word j / 64 is set if there is a dot at (i, j). The buffer is reused for the next row.
+     */
+    template<class F>
+    void computeRows(size_t begin, size_t end, F f) const
+    {
+      end = std::min(end, getNumberOfRows());
+      if (begin >= end)
+        return;
+      size_t outWords = getNumberOfWordsPerRow();
+      std::vector<uint64_t> planes(nbPlanes_ * words_, 0);
+      std::vector<uint64_t> shifted(words_);
+      std::vector<uint64_t> ge(words_);
+      std::vector<uint64_t> row(outWords + 1, 0);
+
+      //Counters of the first row: the sum of the matches of each position of the window, shifted to its diagonal.
+      for (size_t t = 0; t < window_; ++t)
+      {
+        shiftDown_(getMask_(masks_, rows_[begin + t]), t, &shifted[0], words_);
+        add_(planes, &shifted[0]);
+      }
+
+      compare_(planes, &ge[0]);
+      for (size_t i = begin; ; ++i)
+      {
+        shiftDown_(&ge[0], padding_, &row[0], outWords);
+        clearTail_(&row[0]);
+        f(i, static_cast<const uint64_t*>(&row[0]));
+        if (i + 1 == end)
+          break;
+        next_(planes, getMask_(leaving_, rows_[i]), getMask_(entering_, rows_[i + window_]), &ge[0]);
+      }
+    }
+
+    /**
+     * @brief Call f(i, j) for each dot of the plot, row by row, in increasing order.
+     *
+     * Blocks of rows are computed in parallel, and their dots are passed to f on the calling thread,
+     * so that f does not need to be thread-safe. Only the dots of one block per thread are kept in memory.
+     *
+     * @param f         The function to call.
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     * @param blockSize The number of rows per block.
+     * @return The number of dots.
+     */
+    template<class F>
+    size_t forEachDot(F f, unsigned int nbThreads = 0, size_t blockSize = 1024) const
+    {
+      size_t nbRows = getNumberOfRows();
+      blockSize = std::max(blockSize, static_cast<size_t>(1));
+      KmerTable table;
+      bool sparse = buildKmerTable_(table);
+      ThreadPool pool(nbThreads);
+      size_t nbBlocks = pool.getNumberOfThreads();
+      std::vector< std::vector< std::pair<size_t, size_t> > > dots(nbBlocks);
+      size_t nbDots = 0;
+      for (size_t first = 0; first < nbRows; first += nbBlocks * blockSize)
+      {
+        pool.parallelFor(nbBlocks, [&](size_t b0, size_t b1) {
+          for (size_t b = b0; b < b1; ++b)
+          {
+            dots[b].clear();
+            size_t begin = first + b * blockSize;
+            size_t end = std::min(begin + blockSize, nbRows);
+            if (sparse)
+              forEachKmerMatch_(table, begin, end, [&](size_t i, size_t j) { dots[b].push_back(std::make_pair(i, j)); });
+            else
+              computeRows(begin, end, [&](size_t i, const uint64_t* bits) {
+                forEachBit_(bits, getNumberOfWordsPerRow(), [&](size_t j) { dots[b].push_back(std::make_pair(i, j)); });
+              });
+          }
+        }, 1);
+        for (size_t b = 0; b < nbBlocks; ++b)
+        {
+          for (size_t k = 0; k < dots[b].size(); ++k)
+            f(dots[b][k].first, dots[b][k].second);
+          nbDots += dots[b].size();
+        }
+      }
+      return nbDots;
+    }
+
+    /**
+     * @brief Compute a bitmap of the plot, possibly reduced.
+     *
+     * With a scale s > 1, each pixel stands for a block of s x s cells, and is set if one of them has a dot.
+     * Pixels are stored row by row, 8 pixels per byte with the leftmost pixel in the most significant bit,
+     * and each row padded to a whole byte, as in the binary PBM format.
+     *
+     * @param bitmap    [out] The bitmap. It is resized if needed.
+     * @param width     [out] The number of pixels per row.
+     * @param height    [out] The number of rows.
+     * @param scale     The number of cells per pixel, in each direction.
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     */
+    void getBitmap(std::vector<unsigned char>& bitmap, size_t& width, size_t& height, size_t scale = 1, unsigned int nbThreads = 0) const
+    {
+      scale = std::max(scale, static_cast<size_t>(1));
+      size_t nbRows = getNumberOfRows();
+      width = (getNumberOfColumns() + scale - 1) / scale;
+      height = (nbRows + scale - 1) / scale;
+      size_t rowBytes = (width + 7) / 8;
+      bitmap.assign(rowBytes * height, 0);
+      if (bitmap.empty())
+        return;
+      size_t nbWords = getNumberOfWordsPerRow();
+      KmerTable table;
+      bool sparse = buildKmerTable_(table);
+      ThreadPool pool(nbThreads);
+      //Each task fills whole rows of pixels, so that no pixel is written by two threads:
+      pool.parallelFor(height, [&](size_t p0, size_t p1) {
+        if (sparse)
+        {
+          forEachKmerMatch_(table, p0 * scale, std::min(p1 * scale, nbRows), [&](size_t i, size_t j) {
+            unsigned char* pixels = &bitmap[(i / scale) * rowBytes];
+            size_t x = j / scale;
+            pixels[x / 8] = static_cast<unsigned char>(pixels[x / 8] | (0x80 >> (x % 8)));
+          });
+          return;
+        }
+        computeRows(p0 * scale, p1 * scale, [&](size_t i, const uint64_t* bits) {
+          unsigned char* pixels = &bitmap[(i / scale) * rowBytes];
+          if (scale == 1)
+          {
+            //Reverse the order of the bits in each byte:
+            for (size_t b = 0; b < rowBytes; ++b)
+              pixels[b] = static_cast<unsigned char>(pixels[b] | reverseBits_(static_cast<unsigned char>(bits[b / 8] >> (8 * (b % 8)))));
+          }
+          else
+            forEachBit_(bits, nbWords, [&](size_t j) {
+              size_t x = j / scale;
+              pixels[x / 8] = static_cast<unsigned char>(pixels[x / 8] | (0x80 >> (x % 8)));
+            });
+        });
+      });
+    }
+
+    /**
+     * @brief Write the plot as a binary PBM image (P4), which most image viewers can display.
+     *
+     * @see getBitmap for the meaning of the arguments.
+     */
+    void writePbm(std::ostream& out, size_t scale = 1, unsigned int nbThreads = 0) const
+    {
+      std::vector<unsigned char> bitmap;
+      size_t width, height;
+      getBitmap(bitmap, width, height, scale, nbThreads);
+      out << "P4" << std::endl << width << " " << height << std::endl;
+      if (!bitmap.empty())
+        out.write(reinterpret_cast<const char*>(&bitmap[0]), static_cast<std::streamsize>(bitmap.size()));
+    }
+
+  private:
+    void init_(const std::vector<int>& rows, const std::vector<int>& columns, size_t window, size_t threshold)
+    {
+      if (window == 0)
+        throw Exception("DotPlot. The window size must be at least 1.");
+      if (threshold > window)
+        throw Exception("DotPlot. The threshold can't be larger than the window size.");
+      if ((window >> (MAX_PLANES - 1)) != 0)
+        throw Exception("DotPlot. The window is too large.");
+      rows_ = rows;
+      columns_ = columns;
+      nbColumns_ = columns.size();
+      window_ = window;
+      threshold_ = (threshold == 0 ? window : threshold);
+      nbPlanes_ = 0;
+      for (size_t w = window; w > 0; w >>= 1)
+        ++nbPlanes_;
+      padding_ = window - 1;
+      words_ = std::max((nbColumns_ + padding_ + 63) / 64, static_cast<size_t>(1));
+      empty_.assign(words_, 0);
+
+      if (columns.empty())
+        return;
+      minState_ = *std::min_element(columns.begin(), columns.end());
+      int maxState = *std::max_element(columns.begin(), columns.end());
+      size_t nbStates = static_cast<size_t>(maxState - minState_ + 1);
+      masks_.assign(nbStates, std::vector<uint64_t>());
+      leaving_.assign(nbStates, std::vector<uint64_t>());
+      entering_.assign(nbStates, std::vector<uint64_t>());
+      for (size_t j = 0; j < nbColumns_; ++j)
+      {
+        std::vector<uint64_t>& mask = masks_[static_cast<size_t>(columns[j] - minState_)];
+        if (mask.empty())
+          mask.assign(words_, 0);
+        size_t b = j + padding_;
+        mask[b / 64] |= static_cast<uint64_t>(1) << (b % 64);
+      }
+      for (size_t s = 0; s < nbStates; ++s)
+      {
+        if (masks_[s].empty())
+          continue;
+        leaving_[s].assign(words_, 0);
+        shiftUp_(&masks_[s][0], 1, &leaving_[s][0]);
+        entering_[s].assign(words_, 0);
+        shiftDown_(&masks_[s][0], window_ - 1, &entering_[s][0], words_);
+      }
+    }
+
+    /*
+     * Build the hash table of the windows of the columns, if the plot is one of exact k-mer matches.
+     * The number of pairs of windows with the same hash is counted first: the table is only built if checking
+     * these pairs costs less than the bit-parallel rows, which is not the case for short or repeated k-mers.
+     * @return True if the table was built.
+     */
+    bool buildKmerTable_(KmerTable& table) const
+    {
+      size_t nbRows = getNumberOfRows();
+      size_t nbColumns = getNumberOfColumns();
+      if (threshold_ != window_ || nbRows == 0 || nbColumns == 0)
+        return false;
+      unsigned int bits = 10;
+      while ((static_cast<size_t>(1) << bits) < nbColumns && bits < 26)
+        ++bits;
+      std::vector<uint32_t> columnHashes;
+      hashWindows_(columns_, nbColumns, bits, columnHashes);
+      hashWindows_(rows_, nbRows, bits, table.rowHashes);
+      std::vector<size_t> counts(static_cast<size_t>(1) << bits, 0);
+      for (size_t j = 0; j < nbColumns; ++j)
+        counts[columnHashes[j]]++;
+      double pairs = 0;
+      for (size_t i = 0; i < nbRows; ++i)
+        pairs += static_cast<double>(counts[table.rowHashes[i]]);
+      if (pairs * static_cast<double>(window_) > static_cast<double>(nbRows) * static_cast<double>(words_ * nbPlanes_))
+        return false;
+      //Columns are inserted from the last one, so that each chain is in increasing order:
+      table.heads.assign(counts.size(), 0);
+      table.next.assign(nbColumns, 0);
+      for (size_t j = nbColumns; j-- > 0; )
+      {
+        table.next[j] = table.heads[columnHashes[j]];
+        table.heads[columnHashes[j]] = j + 1;
+      }
+      return true;
+    }
+
+    /*
+     * Polynomial hash of all windows of the first n + window_ - 1 states, rolled from one window to the next,
+     * and mixed to keep its 'bits' most significant bits.
+     */
+    void hashWindows_(const std::vector<int>& states, size_t n, unsigned int bits, std::vector<uint32_t>& hashes) const
+    {
+      const uint64_t base = 0x100000001B3ULL;
+      uint64_t power = 1; //base^(window_ - 1)
+      for (size_t t = 1; t < window_; ++t)
+        power *= base;
+      uint64_t h = 0;
+      for (size_t t = 0; t + 1 < window_; ++t)
+        h = h * base + static_cast<uint64_t>(states[t]) + 1;
+      hashes.resize(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        h = h * base + static_cast<uint64_t>(states[i + window_ - 1]) + 1;
+        hashes[i] = static_cast<uint32_t>((h * 0x9E3779B97F4A7C15ULL) >> (64 - bits));
+        h -= (static_cast<uint64_t>(states[i]) + 1) * power;
+      }
+    }
+
+    /*
+     * Call f(i, j) for each exact match of rows [begin, end), in increasing order.
+     */
+    template<class G>
+    void forEachKmerMatch_(const KmerTable& table, size_t begin, size_t end, G g) const
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        std::vector<int>::const_iterator window = rows_.begin() + static_cast<ptrdiff_t>(i);
+        for (size_t c = table.heads[table.rowHashes[i]]; c != 0; c = table.next[c - 1])
+          if (std::equal(window, window + static_cast<ptrdiff_t>(window_), columns_.begin() + static_cast<ptrdiff_t>(c - 1)))
+            g(i, c - 1);
+      }
+    }
+
+    const uint64_t* getMask_(const std::vector< std::vector<uint64_t> >& masks, int state) const
+    {
+      size_t s = static_cast<size_t>(static_cast<unsigned int>(state - minState_));
+      if (s >= masks.size() || masks[s].empty())
+        return &empty_[0];
+      return &masks[s][0];
+    }
+
+    /*
+     * out[j] = in[j + shift], for the first nbOut words of out. Bits beyond the input are 0.
+     */
+    void shiftDown_(const uint64_t* in, size_t shift, uint64_t* out, size_t nbOut) const
+    {
+      size_t w = shift / 64;
+      unsigned int b = static_cast<unsigned int>(shift % 64);
+      for (size_t q = 0; q < nbOut; ++q)
+      {
+        uint64_t low = (q + w < words_) ? in[q + w] : 0;
+        uint64_t high = (q + w + 1 < words_) ? in[q + w + 1] : 0;
+        out[q] = (b == 0) ? low : ((low >> b) | (high << (64 - b)));
+      }
+    }
+
+    /*
+     * out[j] = in[j - shift], with 0 for j < shift.
+     */
+    void shiftUp_(const uint64_t* in, size_t shift, uint64_t* out) const
+    {
+      size_t w = shift / 64;
+      unsigned int b = static_cast<unsigned int>(shift % 64);
+      for (size_t q = words_; q-- > 0; )
+      {
+        uint64_t high = (q >= w) ? in[q - w] : 0;
+        uint64_t low = (q >= w + 1) ? in[q - w - 1] : 0;
+        out[q] = (b == 0) ? high : ((high << b) | (low >> (64 - b)));
+      }
+    }
+
+    /*
+     * Bit-sliced addition of a vector of bits to the counters, with carry propagation.
+     * Planes are interleaved: bit plane l of word q is planes[q * nbPlanes_ + l].
+     */
+    void add_(std::vector<uint64_t>& planes, const uint64_t* bits) const
+    {
+      for (size_t q = 0; q < words_; ++q)
+      {
+        uint64_t* p = &planes[q * nbPlanes_];
+        uint64_t carry = bits[q];
+        for (size_t l = 0; l < nbPlanes_; ++l)
+        {
+          uint64_t next = p[l] & carry;
+          p[l] ^= carry;
+          carry = next;
+        }
+      }
+    }
+
+    /*
+     * Move the counters to the next row, in a single pass over the words: shift them by one column,
+     * subtract the matches leaving the windows, add the ones entering them, and compare with the threshold.
+     * The usual numbers of planes are compiled separately, so that the loops over the planes are unrolled.
+     */
+    void next_(std::vector<uint64_t>& planes, const uint64_t* leaving, const uint64_t* entering, uint64_t* ge) const
+    {
+      switch (nbPlanes_)
+      {
+      case 1: return next_<1>(planes, leaving, entering, ge);
+      case 2: return next_<2>(planes, leaving, entering, ge);
+      case 3: return next_<3>(planes, leaving, entering, ge);
+      case 4: return next_<4>(planes, leaving, entering, ge);
+      case 5: return next_<5>(planes, leaving, entering, ge);
+      case 6: return next_<6>(planes, leaving, entering, ge);
+      default: return next_<0>(planes, leaving, entering, ge);
+      }
+    }
+
+    /*
+     * L is the number of planes, or 0 if it is only known at run time.
+     */
+    template<size_t L>
+    void next_(std::vector<uint64_t>& planes, const uint64_t* leaving, const uint64_t* entering, uint64_t* ge) const
+    {
+      size_t nbPlanes = (L == 0 ? nbPlanes_ : L);
+      uint64_t previous[MAX_PLANES] = { 0 };
+      for (size_t q = 0; q < words_; ++q)
+      {
+        uint64_t* p = &planes[q * nbPlanes];
+        for (size_t l = 0; l < nbPlanes; ++l)
+        {
+          uint64_t current = p[l];
+          p[l] = (current << 1) | (previous[l] >> 63);
+          previous[l] = current;
+        }
+        //No early exit on a null carry: the loops are faster without branches.
+        uint64_t borrow = leaving[q];
+        for (size_t l = 0; l < nbPlanes; ++l)
+        {
+          uint64_t next = ~p[l] & borrow;
+          p[l] ^= borrow;
+          borrow = next;
+        }
+        uint64_t carry = entering[q];
+        for (size_t l = 0; l < nbPlanes; ++l)
+        {
+          uint64_t next = p[l] & carry;
+          p[l] ^= carry;
+          carry = next;
+        }
+        ge[q] = compareWord_(p);
+      }
+    }
+
+    /*
+     * Bit-sliced comparison of the counters with the threshold.
+     */
+    void compare_(const std::vector<uint64_t>& planes, uint64_t* ge) const
+    {
+      for (size_t q = 0; q < words_; ++q)
+        ge[q] = compareWord_(&planes[q * nbPlanes_]);
+    }
+
+    /*
+     * Comparison of the counters of one word, from the most significant plane.
+     */
+    uint64_t compareWord_(const uint64_t* p) const
+    {
+      uint64_t greater = 0;
+      uint64_t equal = ~static_cast<uint64_t>(0);
+      for (size_t l = nbPlanes_; l-- > 0; )
+      {
+        if ((threshold_ >> l) & 1)
+          equal &= p[l];
+        else
+        {
+          greater |= equal & p[l];
+          equal &= ~p[l];
+        }
+      }
+      return greater | equal;
+    }
+
+    /*
+     * Clear the bits beyond the last column of the plot.
+     */
+    void clearTail_(uint64_t* row) const
+    {
+      size_t nbCols = getNumberOfColumns();
+      size_t nbWords = getNumberOfWordsPerRow();
+      if (nbCols % 64 != 0)
+        row[nbWords - 1] &= (static_cast<uint64_t>(1) << (nbCols % 64)) - 1;
+    }
+
+    template<class G>
+    static void forEachBit_(const uint64_t* bits, size_t nbWords, G g)
+    {
+      for (size_t q = 0; q < nbWords; ++q)
+      {
+        uint64_t word = bits[q];
+        while (word != 0)
+        {
+          g(q * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+          word &= word - 1;
+        }
+      }
+    }
+
+    static unsigned char reverseBits_(unsigned char b)
+    {
+      b = static_cast<unsigned char>(((b & 0xF0) >> 4) | ((b & 0x0F) << 4));
+      b = static_cast<unsigned char>(((b & 0xCC) >> 2) | ((b & 0x33) << 2));
+      b = static_cast<unsigned char>(((b & 0xAA) >> 1) | ((b & 0x55) << 1));
+      return b;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_DOTPLOT_H_
@@ -0,0 +1,219 @@
+/*
+ * File: ExDotPlot.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 23:40 2026
+ *
+ * Dot plots of long sequences, computed 64 cells at a time.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <fstream> /* to write the images. */
+#include <random> /* to simulate sequences. */
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Sequence.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/Text/TextTools.h>
+
+/*
+ * And the dot plot engine, in this directory:
+ */
+#include "DotPlot.h"
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * The dot plot of ExSequence, written character by character.
+ * We use it to check the output of the DotPlot class.
+ */
+string naiveDotPlot(const Sequence& rows, const Sequence& columns)
+{
+  string plot;
+  for (size_t i = 0; i < rows.size(); i++) {
+    for (size_t j = 0; j < columns.size(); j++) {
+      if (rows.getChar(i) == columns.getChar(j))
+        plot += rows.getChar(i);
+      else
+        plot += ".";
+    }
+    plot += "\n";
+  }
+  return plot;
+}
+
+/*
+ * The same plot, with the DotPlot class. Each row is given as 64 bits words:
+ * bit j % 64 of word j / 64 is set if there is a dot in column j.
+ */
+string bitDotPlot(const Sequence& rows, const Sequence& columns)
+{
+  DotPlot dotPlot(rows, columns);
+  string plot;
+  dotPlot.computeRows(0, dotPlot.getNumberOfRows(), [&](size_t i, const uint64_t* bits) {
+    for (size_t j = 0; j < dotPlot.getNumberOfColumns(); j++) {
+      if ((bits[j / 64] >> (j % 64)) & 1)
+        plot += rows.getChar(i);
+      else
+        plot += ".";
+    }
+    plot += "\n";
+  });
+  return plot;
+}
+
+/*
+ * A random DNA sequence.
+ */
+BasicSequence randomSequence(const string& name, size_t length, mt19937& rng)
+{
+  const char* nucleotides = "ACGT";
+  uniform_int_distribution<int> nucleotide(0, 3);
+  string s(length, 'A');
+  for (size_t i = 0; i < length; i++)
+    s[i] = nucleotides[nucleotide(rng)];
+  return BasicSequence(name, s, &AlphabetTools::DNA_ALPHABET);
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * The sequence of ExSequence, plotted against itself:
+     */
+    BasicSequence sequence("My first sequence", "GATTACAATGATTACATGGT", &AlphabetTools::DNA_ALPHABET);
+    string plot = bitDotPlot(sequence, sequence);
+    cout << plot;
+    cout << "Same plot as character by character? " << (plot == naiveDotPlot(sequence, sequence) ? "yes" : "no") << endl;
+
+    /*
+     * A dot plot with single positions is very noisy on DNA sequences: one cell out of four has a dot.
+     * A window and a threshold filter the noise: here, a dot means that the 4 positions starting at i
+     * and at j have at least 3 identical nucleotides. The plot then has 3 rows and columns less.
+     * With a threshold equal to the window (the default), dots are the exact k-mer matches.
+     */
+    DotPlot filtered(sequence, sequence, 4, 3);
+    cout << "Window of " << filtered.getWindowSize() << ", threshold of " << filtered.getThreshold() << ":" << endl;
+    filtered.computeRows(0, filtered.getNumberOfRows(), [&](size_t /* row */, const uint64_t* bits) {
+      for (size_t j = 0; j < filtered.getNumberOfColumns(); j++)
+        cout << (((bits[j / 64] >> (j % 64)) & 1) ? "*" : ".");
+      cout << endl;
+    });
+
+    /*
+     * Dots can also be listed, which is handy when there are only a few of them.
+     * Here are all the exact matches of 7 nucleotides:
+     */
+    DotPlot matches(sequence, sequence, 7);
+    size_t nbMatches = matches.forEachDot([&](size_t i, size_t j) {
+      if (i != j)
+        cout << "Match of " << matches.getWindowSize() << " at " << (i + 1) << " and " << (j + 1) << ": "
+             << sequence.toString().substr(i, matches.getWindowSize()) << endl;
+    });
+    cout << nbMatches << " matches, including the diagonal." << endl;
+
+    /*
+     * Now let's plot two long sequences: a random one, and a copy of it where a segment was reversed,
+     * and another one duplicated, with a few mutations.
+     */
+    size_t length = 1000000; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
+    mt19937 rng(42);
+    BasicSequence seq1 = randomSequence("seq1", length, rng);
+    string s2 = seq1.toString();
+    std::reverse(s2.begin() + static_cast<ptrdiff_t>(length / 5), s2.begin() + static_cast<ptrdiff_t>(2 * length / 5));
+    s2 = s2.substr(0, 3 * length / 5) + s2.substr(length / 2, length / 10) + s2.substr(3 * length / 5);
+    uniform_int_distribution<size_t> position(0, s2.size() - 1);
+    for (size_t k = 0; k < s2.size() / 20; k++)
+      s2[position(rng)] = 'A';
+    BasicSequence seq2("seq2", s2, &AlphabetTools::DNA_ALPHABET);
+
+    /*
+     * The full plot has 10^12 cells, way too much for an image, so each pixel will stand for
+     * a square of 1000 x 1000 cells, and will be black if one of them has a dot.
+     * Exact matches of 20 nucleotides keep the similar segments, between their mutations, and are rare
+     * between random sequences: such a plot is sparse, and only the windows with the same hash are compared.
+     * Rows are shared between threads (0 means all available cores).
+     */
+    DotPlot big(seq1, seq2, 20);
+    ApplicationTools::startTimer();
+    ofstream image("dotplot.pbm", ios::out | ios::binary);
+    big.writePbm(image, 1000, 0);
+    image.close();
+    ApplicationTools::displayTime("Time used to compute the plot:");
+    cout << "Plot written to dotplot.pbm" << endl;
+
+    /*
+     * A threshold below the window size also shows the segments with many mutations,
+     * here with 28 identical nucleotides out of 32. Every cell is then computed, which takes
+     * a time proportional to the product of the lengths: we only plot the first 100 kb of each sequence.
+     * WATCHOUT!!! with 1 Mb sequences, this takes about 10 minutes on a single core.
+     */
+    size_t shortLength = 100000;
+    BasicSequence start1("start1", seq1.toString().substr(0, shortLength), &AlphabetTools::DNA_ALPHABET);
+    BasicSequence start2("start2", s2.substr(0, shortLength), &AlphabetTools::DNA_ALPHABET);
+    DotPlot thresholded(start1, start2, 32, 28);
+    ApplicationTools::startTimer();
+    ofstream thresholdedImage("dotplot_threshold.pbm", ios::out | ios::binary);
+    thresholded.writePbm(thresholdedImage, 100, 0);
+    thresholdedImage.close();
+    ApplicationTools::displayTime("Time used to compute the plot:");
+    cout << "Plot written to dotplot_threshold.pbm" << endl;
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
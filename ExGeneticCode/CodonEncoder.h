@@ -0,0 +1,293 @@
+/*
+ * File: CodonEncoder.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 23:10 2026
+ *
+ * Direct conversions between nucleotide states and codon states.
+ */
+
+#ifndef _CODONENCODER_H_
+#define _CODONENCODER_H_
+
+#include "PackedSequence.h" /* from ExPackedSequence */
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Alphabet/CodonAlphabet.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/SequenceExceptions.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Conversion of nucleotide states to codon states and back, without going through strings.
+   *
+   * Creating a codon sequence from a nucleotide one usually means decoding the nucleotides
+   * to a string, and parsing it again three characters at a time. Here, the codon state is computed
+   * directly from the nucleotide states, as 16 * a + 4 * b + c, which is the coding used by
+   * CodonAlphabet (this is checked when the encoder is created).
+   *
+   * A codon made of three gaps is a gap. A codon with a gap and a nucleotide, or with an ambiguous
+   * nucleotide, is the unknown codon. Decoding does the reverse: a gap gives three gaps,
+   * and the unknown codon gives three unknown nucleotides.
+   */
+  class CodonEncoder
+  {
+  private:
+    enum { PACKED_BLOCK = 3 * 1024 };
+    const CodonAlphabet* codonAlphabet_;
+    const Alphabet* nucleicAlphabet_;
+    int gap_;
+    int unknown_;
+    int nucleicUnknown_;
+
+  public:
+    /**
+     * @param codonAlphabet The codon alphabet to use.
+     * @throw Exception If the codon alphabet does not use the 16 * a + 4 * b + c coding.
+     */
+    explicit CodonEncoder(const CodonAlphabet* codonAlphabet) :
+      codonAlphabet_(codonAlphabet),
+      nucleicAlphabet_(codonAlphabet->getNucleicAlphabet()),
+      gap_(codonAlphabet->getGapCharacterCode()),
+      unknown_(codonAlphabet->getUnknownCharacterCode()),
+      nucleicUnknown_(codonAlphabet->getNucleicAlphabet()->getUnknownCharacterCode())
+    {
+      for (int a = 0; a < 4; ++a)
+        for (int b = 0; b < 4; ++b)
+          for (int c = 0; c < 4; ++c)
+            if (codonAlphabet->getCodon(a, b, c) != 16 * a + 4 * b + c)
+              throw Exception("CodonEncoder. Unsupported coding of the codon alphabet.");
+    }
+
+  public:
+    const CodonAlphabet* getCodonAlphabet() const { return codonAlphabet_; }
+    const Alphabet* getNucleicAlphabet() const { return nucleicAlphabet_; }
+
+    /**
+     * @return The codon state of three nucleotide states.
+     */
+    int getCodon(int a, int b, int c) const
+    {
+      //Negative states have their high bits set, so a single test checks that the three states are resolved:
+      if (((a | b | c) & ~3) == 0)
+        return (a << 4) | (b << 2) | c;
+      return (a == -1 && b == -1 && c == -1) ? gap_ : unknown_;
+    }
+
+    /**
+     * @brief Encode a buffer of nucleotide states.
+     *
+     * @param states The nucleotide states.
+     * @param n      The number of nucleotide states, a multiple of 3.
+     * @param out    [out] The codon states. It must have room for n / 3 states.
+     * @throw BadSizeException If n is not a multiple of 3.
+     */
+    void encode(const int* states, size_t n, int* out) const
+    {
+      BPP_INSTRUMENT_SCOPE(ENCODE);
+      BPP_INSTRUMENT_COUNT(ENCODE, n);
+      checkSize_(n);
+      for (size_t k = 0, i = 0; i < n; ++k, i += 3)
+        out[k] = getCodon(states[i], states[i + 1], states[i + 2]);
+    }
+
+    /**
+     * @brief Encode a vector of nucleotide states into a vector of codon states, which is resized if needed.
+     */
+    void encode(const std::vector<int>& states, std::vector<int>& out) const
+    {
+      out.resize(states.size() / 3);
+      if (!states.empty())
+        encode(&states[0], states.size(), &out[0]);
+    }
+
+    /**
+     * @brief Encode packed nucleotide states.
+     *
+     * States are unpacked by blocks of a few thousands, so that the full unpacked sequence is never in memory.
+     */
+    void encode(const PackedStates& states, std::vector<int>& out) const
+    {
+      size_t n = states.size();
+      checkSize_(n);
+      out.resize(n / 3);
+      std::vector<int> block(std::min(n, static_cast<size_t>(PACKED_BLOCK)));
+      for (size_t begin = 0; begin < n; begin += PACKED_BLOCK)
+      {
+        size_t end = std::min(begin + static_cast<size_t>(PACKED_BLOCK), n);
+        states.decode(begin, end, &block[0]);
+        encode(&block[0], end - begin, &out[begin / 3]);
+      }
+    }
+
+    /**
+     * @return A new codon sequence, with the same name as the nucleotide sequence.
+     * @throw AlphabetMismatchException If the sequence does not have the nucleic alphabet of the codon alphabet.
+     */
+    Sequence* encode(const Sequence& sequence) const
+    {
+      checkAlphabet_(sequence.getAlphabet(), nucleicAlphabet_, "CodonEncoder::encode");
+      std::vector<int> codons;
+      encode(sequence.getContent(), codons);
+      return new BasicSequence(sequence.getName(), codons, codonAlphabet_);
+    }
+
+    /**
+     * @return A new codon sequence from a packed nucleotide sequence.
+     */
+    Sequence* encode(const PackedSequence& sequence) const
+    {
+      checkAlphabet_(sequence.getAlphabet(), nucleicAlphabet_, "CodonEncoder::encode");
+      std::vector<int> codons;
+      encode(sequence.getStates(), codons);
+      return new BasicSequence(sequence.getName(), codons, codonAlphabet_);
+    }
+
+    /**
+     * @return A new container with the codon sequences, in the same order.
+     */
+    VectorSequenceContainer* encode(const OrderedSequenceContainer& sequences) const
+    {
+      checkAlphabet_(sequences.getAlphabet(), nucleicAlphabet_, "CodonEncoder::encode");
+      VectorSequenceContainer* codonSequences = new VectorSequenceContainer(codonAlphabet_);
+      std::vector<int> codons;
+      try
+      {
+        for (size_t i = 0; i < sequences.getNumberOfSequences(); ++i)
+        {
+          const Sequence& sequence = sequences.getSequence(i);
+          encode(sequence.getContent(), codons);
+          codonSequences->addSequence(BasicSequence(sequence.getName(), codons, codonAlphabet_), false);
+        }
+      }
+      catch (...)
+      {
+        delete codonSequences;
+        throw;
+      }
+      return codonSequences;
+    }
+
+    /**
+     * @brief Encode an alignment of nucleotides into an alignment of codons.
+     *
+     * Rows are encoded into a codon matrix, from which the sites are built directly.
+     *
+     * @return A new VectorSiteContainer, with one site per codon.
+     * @throw SequenceNotAlignedException If sequences do not all have the same length.
+     */
+    VectorSiteContainer* encodeAlignment(const OrderedSequenceContainer& sequences) const
+    {
+      checkAlphabet_(sequences.getAlphabet(), nucleicAlphabet_, "CodonEncoder::encodeAlignment");
+      size_t nbSeq = sequences.getNumberOfSequences();
+      size_t nbSites = nbSeq > 0 ? sequences.getSequence(0).size() : 0;
+      checkSize_(nbSites);
+      size_t nbCodons = nbSites / 3;
+      std::vector<int> matrix(nbSeq * nbCodons); //row-major
+      for (size_t i = 0; i < nbSeq; ++i)
+      {
+        const Sequence& sequence = sequences.getSequence(i);
+        if (sequence.size() != nbSites)
+          throw SequenceNotAlignedException("CodonEncoder::encodeAlignment. Sequences must all have the same length.", &sequence);
+        if (nbCodons > 0)
+          encode(&sequence.getContent()[0], nbSites, &matrix[i * nbCodons]);
+      }
+      BPP_INSTRUMENT_SCOPE(TRANSPOSE);
+      BPP_INSTRUMENT_COUNT(TRANSPOSE, nbSeq * nbCodons);
+      VectorSiteContainer* sites = new VectorSiteContainer(sequences.getSequencesNames(), codonAlphabet_);
+      try
+      {
+        std::vector<int> column(nbSeq);
+        for (size_t j = 0; j < nbCodons; ++j)
+        {
+          for (size_t i = 0; i < nbSeq; ++i)
+            column[i] = matrix[i * nbCodons + j];
+          sites->addSite(Site(column, codonAlphabet_, static_cast<int>(j + 1)), false);
+        }
+      }
+      catch (...)
+      {
+        delete sites;
+        throw;
+      }
+      return sites;
+    }
+
+    /**
+     * @brief Decode a buffer of codon states.
+     *
+     * @param codons The codon states.
+     * @param n      The number of codon states.
+     * @param out    [out] The nucleotide states. It must have room for 3 * n states.
+     * @throw BadIntException If a state is not a codon state.
+     */
+    void decode(const int* codons, size_t n, int* out) const
+    {
+      for (size_t k = 0; k < n; ++k, out += 3)
+      {
+        int codon = codons[k];
+        if ((codon & ~63) == 0)
+        {
+          out[0] = codon >> 4;
+          out[1] = (codon >> 2) & 3;
+          out[2] = codon & 3;
+        }
+        else if (codon == gap_ || codon == unknown_)
+        {
+          out[0] = out[1] = out[2] = (codon == gap_ ? -1 : nucleicUnknown_);
+        }
+        else
+          throw BadIntException(codon, "CodonEncoder::decode. Not a codon state.", codonAlphabet_);
+      }
+    }
+
+    /**
+     * @brief Decode a vector of codon states into a vector of nucleotide states, which is resized if needed.
+     */
+    void decode(const std::vector<int>& codons, std::vector<int>& out) const
+    {
+      out.resize(3 * codons.size());
+      if (!codons.empty())
+        decode(&codons[0], codons.size(), &out[0]);
+    }
+
+    /**
+     * @return A new nucleotide sequence, with the same name as the codon sequence.
+     * @throw AlphabetMismatchException If the sequence does not have the codon alphabet.
+     */
+    Sequence* decode(const Sequence& sequence) const
+    {
+      checkAlphabet_(sequence.getAlphabet(), codonAlphabet_, "CodonEncoder::decode");
+      std::vector<int> states;
+      decode(sequence.getContent(), states);
+      return new BasicSequence(sequence.getName(), states, nucleicAlphabet_);
+    }
+
+  private:
+    static void checkSize_(size_t n)
+    {
+      if (n % 3 != 0)
+        throw BadSizeException("CodonEncoder. The number of nucleotides is not a multiple of 3.", n, n - n % 3);
+    }
+
+    static void checkAlphabet_(const Alphabet* alphabet, const Alphabet* expected, const std::string& method)
+    {
+      if (alphabet->getAlphabetType() != expected->getAlphabetType())
+        throw AlphabetMismatchException(method, expected, alphabet);
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_CODONENCODER_H_
@@ -0,0 +1,360 @@
+/*
+ * File: CompiledGeneticCode.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 21:30 2026
+ *
+ * Genetic codes compiled into lookup tables, for the translation of whole sequences.
+ */
+
+#ifndef _COMPILEDGENETICCODE_H_
+#define _COMPILEDGENETICCODE_H_
+
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Alphabet/CodonAlphabet.h>
+#include <Bpp/Seq/GeneticCode/GeneticCode.h>
+#include <Bpp/Seq/NucleicAcidsReplication.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A GeneticCode compiled into a lookup table indexed by nucleotide triples.
+   *
+   * Nucleotide states from -1 (gap) to 14 (N) are stored on 4 bits each, so that a triplet (a, b, c)
+   * has index ((a + 1) << 8) | ((b + 1) << 4) | (c + 1) in a table of 4096 entries.
+   * For each entry, the table stores the amino acid and the stop/start flags of the codon.
+   * Codons with ambiguity codes are resolved when all their possible codons agree:
+   * for instance, GGN is translated to glycine, TAR is a stop codon, and ATN is the unknown amino acid.
+   * Codons with a gap are translated to a gap if they are only made of gaps, to the unknown amino acid otherwise.
+   *
+   * A second table gives, for the same index, the translation of the reverse complement of the triplet.
+   * The reverse frames are hence translated by reading the sequence backwards, without building
+   * its reverse complement.
+   *
+   * The GeneticCode is only called when the tables are built. Translating a sequence
+   * then needs no string and no codon Sequence object.
+   */
+  class CompiledGeneticCode
+  {
+  public:
+    /**
+     * @brief Code used for stop codons in the translated buffers.
+     */
+    enum { STOP = -2 };
+
+    /**
+     * @brief Flags of a triplet.
+     */
+    enum
+    {
+      FLAG_STOP = 1,
+      FLAG_START = 2,
+      FLAG_ALT_START = 4
+    };
+
+  private:
+    enum { TABLE_SIZE = 4096 };
+    const GeneticCode* geneticCode_;
+    const Alphabet* target_;
+    int8_t forward_[TABLE_SIZE];
+    int8_t reverse_[TABLE_SIZE];
+    uint8_t forwardFlags_[TABLE_SIZE];
+    uint8_t reverseFlags_[TABLE_SIZE];
+
+  public:
+    /**
+     * @param geneticCode The genetic code to compile. It must remain valid as long as this object is used.
+     * @throw Exception If the genetic code is not defined on a nucleotide codon alphabet.
+     */
+    explicit CompiledGeneticCode(const GeneticCode& geneticCode) :
+      geneticCode_(&geneticCode),
+      target_(geneticCode.getTargetAlphabet()),
+      forward_(),
+      reverse_(),
+      forwardFlags_(),
+      reverseFlags_()
+    {
+      const CodonAlphabet* codonAlphabet = dynamic_cast<const CodonAlphabet*>(geneticCode.getSourceAlphabet());
+      if (!codonAlphabet)
+        throw Exception("CompiledGeneticCode. The genetic code must be defined on a codon alphabet.");
+      const Alphabet* nucleotides = codonAlphabet->getNucleicAlphabet();
+      NucleicAcidsReplication replication(nucleotides, nucleotides);
+
+      //Resolved states and complement of each nucleotide state, indexed by state + 1:
+      std::vector< std::vector<int> > resolved(16);
+      std::vector<int> complement(16, -1);
+      for (int state = 0; state < 15; ++state)
+      {
+        resolved[static_cast<size_t>(state + 1)] = nucleotides->getAlias(state);
+        complement[static_cast<size_t>(state + 1)] = replication.translate(state);
+      }
+
+      for (int a = -1; a < 15; ++a)
+      {
+        for (int b = -1; b < 15; ++b)
+        {
+          for (int c = -1; c < 15; ++c)
+          {
+            size_t i = index_(a, b, c);
+            compile_(*codonAlphabet, resolved, a, b, c, forward_[i], forwardFlags_[i]);
+            int ra = complement[static_cast<size_t>(c + 1)];
+            int rb = complement[static_cast<size_t>(b + 1)];
+            int rc = complement[static_cast<size_t>(a + 1)];
+            compile_(*codonAlphabet, resolved, ra, rb, rc, reverse_[i], reverseFlags_[i]);
+          }
+        }
+      }
+    }
+
+  public:
+    const GeneticCode* getGeneticCode() const { return geneticCode_; }
+    const Alphabet* getTargetAlphabet() const { return target_; }
+
+    /**
+     * @return The amino acid coded by a triplet of nucleotide states, or STOP.
+     * @throw BadIntException If a state is not a nucleotide state.
+     */
+    int translate(int a, int b, int c) const
+    {
+      return forward_[checkedIndex_(a, b, c)];
+    }
+
+    /**
+     * @return The flags (FLAG_STOP, FLAG_START, FLAG_ALT_START) of a triplet of nucleotide states.
+     * @throw BadIntException If a state is not a nucleotide state.
+     */
+    int getFlags(int a, int b, int c) const
+    {
+      return forwardFlags_[checkedIndex_(a, b, c)];
+    }
+
+    bool isStop(int a, int b, int c) const { return (getFlags(a, b, c) & FLAG_STOP) != 0; }
+    bool isStart(int a, int b, int c) const { return (getFlags(a, b, c) & FLAG_START) != 0; }
+    bool isAltStart(int a, int b, int c) const { return (getFlags(a, b, c) & FLAG_ALT_START) != 0; }
+
+    /**
+     * @return The number of complete codons in a given frame of a sequence of length n.
+     *
+     * @param n     The length of the nucleotide sequence.
+     * @param frame The frame: 1, 2 or 3 for the forward strand, -1, -2 or -3 for the reverse strand.
+     */
+    static size_t getNumberOfCodons(size_t n, int frame)
+    {
+      size_t offset = static_cast<size_t>(frame > 0 ? frame - 1 : -frame - 1);
+      return n > offset ? (n - offset) / 3 : 0;
+    }
+
+    /**
+     * @brief Translate one frame of a buffer of nucleotide states.
+     *
+     * Frame f > 0 starts at position f - 1 of the buffer. Frame -f is frame f of the reverse complement:
+     * its first codon is the reverse complement of positions [n - f - 2, n - f].
+     *
+     * @param states The nucleotide states.
+     * @param n      The number of states.
+     * @param frame  The frame: 1, 2, 3, -1, -2 or -3.
+     * @param out    [out] The amino acids, with STOP for stop codons. It must have room for getNumberOfCodons(n, frame) states.
+     * @param flags  [out] If not null, the flags of each codon.
+     * @return The number of codons translated.
+     * @throw BadIntException If the frame is invalid, or if a state is not a nucleotide state. The output is then only partially filled.
+     */
+    size_t translateFrame(const int* states, size_t n, int frame, int* out, uint8_t* flags = 0) const
+    {
+      if (frame == 0 || frame < -3 || frame > 3)
+        throw BadIntException(frame, "CompiledGeneticCode::translateFrame. Invalid frame.");
+      BPP_INSTRUMENT_SCOPE(TRANSLATE);
+      size_t nbCodons = getNumberOfCodons(n, frame);
+      BPP_INSTRUMENT_COUNT(TRANSLATE, nbCodons);
+      if (frame > 0)
+      {
+        const int* p = states + (frame - 1);
+        for (size_t k = 0; k < nbCodons; ++k, p += 3)
+        {
+          size_t i = checkedIndex_(p[0], p[1], p[2]);
+          out[k] = forward_[i];
+          if (flags)
+            flags[k] = forwardFlags_[i];
+        }
+      }
+      else if (nbCodons > 0)
+      {
+        //Codons are read from the end of the buffer, and looked up in the reverse complement table:
+        const int* p = states + n - static_cast<size_t>(-frame) - 2;
+        for (size_t k = 0; k < nbCodons; ++k, p -= 3)
+        {
+          size_t i = checkedIndex_(p[0], p[1], p[2]);
+          out[k] = reverse_[i];
+          if (flags)
+            flags[k] = reverseFlags_[i];
+        }
+      }
+      return nbCodons;
+    }
+
+    /**
+     * @brief Translate one frame of a vector of nucleotide states into another one, which is resized if needed.
+     */
+    void translateFrame(const std::vector<int>& states, int frame, std::vector<int>& out) const
+    {
+      out.resize(getNumberOfCodons(states.size(), frame));
+      if (!out.empty())
+        translateFrame(&states[0], states.size(), frame, &out[0]);
+    }
+
+    /**
+     * @brief Translate one frame of a nucleotide sequence.
+     *
+     * Protein alphabets have no stop state: stop codons are translated to the unknown amino acid.
+     * Use translateFrame on buffers to locate them.
+     *
+     * @param sequence The nucleotide sequence.
+     * @param frame    The frame: 1, 2, 3, -1, -2 or -3.
+     * @return A new sequence, with the protein alphabet of the genetic code, and the same name as the input sequence.
+     * @throw AlphabetException If the sequence is not a nucleotide sequence.
+     */
+    Sequence* translate(const Sequence& sequence, int frame = 1) const
+    {
+      if (!AlphabetTools::isNucleicAlphabet(sequence.getAlphabet()))
+        throw AlphabetException("CompiledGeneticCode::translate. Sequence is not a nucleotide sequence.", sequence.getAlphabet());
+      std::vector<int> protein;
+      translateFrame(sequence.getContent(), frame, protein);
+      int unknown = target_->getUnknownCharacterCode();
+      for (size_t k = 0; k < protein.size(); ++k)
+      {
+        if (protein[k] == STOP)
+          protein[k] = unknown;
+      }
+      return new BasicSequence(sequence.getName(), protein, target_);
+    }
+
+    /**
+     * @brief Translate all sequences of a container in three or six frames.
+     *
+     * A single buffer is used for all translations.
+     *
+     * @param sequences  The nucleotide sequences.
+     * @param sixFrames  Whether the reverse frames should be translated too.
+     * @return A new container, with for each input sequence, its translations in frames 1, 2, 3 (and -1, -2, -3),
+     * named after the sequence with the suffix "_frame+1", "_frame+2"... Stop codons are translated as in translate().
+     */
+    VectorSequenceContainer* translate(const OrderedSequenceContainer& sequences, bool sixFrames = true) const
+    {
+      if (!AlphabetTools::isNucleicAlphabet(sequences.getAlphabet()))
+        throw AlphabetException("CompiledGeneticCode::translate. Container does not contain nucleotide sequences.", sequences.getAlphabet());
+      VectorSequenceContainer* proteins = new VectorSequenceContainer(target_);
+      std::vector<int> protein;
+      int unknown = target_->getUnknownCharacterCode();
+      try
+      {
+        for (size_t i = 0; i < sequences.getNumberOfSequences(); ++i)
+        {
+          const Sequence& sequence = sequences.getSequence(i);
+          for (int f = 0; f < (sixFrames ? 6 : 3); ++f)
+          {
+            int frame = (f < 3 ? f + 1 : 2 - f);
+            translateFrame(sequence.getContent(), frame, protein);
+            for (size_t k = 0; k < protein.size(); ++k)
+            {
+              if (protein[k] == STOP)
+                protein[k] = unknown;
+            }
+            std::string name = sequence.getName() + "_frame" + (frame > 0 ? "+" : "-") + TextTools::toString(frame > 0 ? frame : -frame);
+            proteins->addSequence(BasicSequence(name, protein, target_), false);
+          }
+        }
+      }
+      catch (...)
+      {
+        delete proteins;
+        throw;
+      }
+      return proteins;
+    }
+
+  private:
+    static size_t index_(int a, int b, int c)
+    {
+      return (static_cast<size_t>(a + 1) << 8) | (static_cast<size_t>(b + 1) << 4) | static_cast<size_t>(c + 1);
+    }
+
+    /*
+     * States from -1 to 14 become 0 to 15 when shifted: any other state gives a value >= 16 once cast to unsigned,
+     * so that a single comparison checks the three states.
+     */
+    size_t checkedIndex_(int a, int b, int c) const
+    {
+      unsigned int ua = static_cast<unsigned int>(a + 1);
+      unsigned int ub = static_cast<unsigned int>(b + 1);
+      unsigned int uc = static_cast<unsigned int>(c + 1);
+      if ((ua | ub | uc) >= 16)
+      {
+        int bad = (ua >= 16 ? a : (ub >= 16 ? b : c));
+        throw BadIntException(bad, "CompiledGeneticCode. Not a nucleotide state.");
+      }
+      return (static_cast<size_t>(ua) << 8) | (static_cast<size_t>(ub) << 4) | static_cast<size_t>(uc);
+    }
+
+    /*
+     * Translate all resolved codons of an ambiguous triplet, and keep what they have in common.
+     */
+    void compile_(const CodonAlphabet& codonAlphabet, const std::vector< std::vector<int> >& resolved,
+        int a, int b, int c, int8_t& aa, uint8_t& flags) const
+    {
+      flags = 0;
+      if (a == -1 || b == -1 || c == -1)
+      {
+        aa = static_cast<int8_t>(a == -1 && b == -1 && c == -1 ? -1 : target_->getUnknownCharacterCode());
+        return;
+      }
+      const std::vector<int>& ra = resolved[static_cast<size_t>(a + 1)];
+      const std::vector<int>& rb = resolved[static_cast<size_t>(b + 1)];
+      const std::vector<int>& rc = resolved[static_cast<size_t>(c + 1)];
+      int result = 0;
+      bool first = true;
+      bool agree = true;
+      uint8_t common = FLAG_STOP | FLAG_START | FLAG_ALT_START;
+      for (size_t i = 0; i < ra.size(); ++i)
+      {
+        for (size_t j = 0; j < rb.size(); ++j)
+        {
+          for (size_t k = 0; k < rc.size(); ++k)
+          {
+            int codon = codonAlphabet.getCodon(ra[i], rb[j], rc[k]);
+            uint8_t f = 0;
+            int t = STOP;
+            if (geneticCode_->isStop(codon))
+              f |= FLAG_STOP;
+            else
+              t = geneticCode_->translate(codon);
+            if (geneticCode_->isStart(codon))
+              f |= FLAG_START;
+            if (geneticCode_->isAltStart(codon))
+              f |= FLAG_ALT_START;
+            common &= f;
+            if (first)
+              result = t;
+            else if (t != result)
+              agree = false;
+            first = false;
+          }
+        }
+      }
+      aa = static_cast<int8_t>(agree ? result : target_->getUnknownCharacterCode());
+      flags = common; //a triplet can only be a stop if all its codons are stops, in which case they agree.
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_COMPILEDGENETICCODE_H_
@@ -17,6 +17,8 @@
  * From the STL:
  */
 #include <iostream> /* to be able to output stuff in the terminal. */
+#include <random> /* to simulate a genome. */
+#include <vector>
 
 /*
  * We'll use the standard template library namespace:
@@ -28,6 +30,19 @@ using namespace std;
  */
 #include <Bpp/Seq/Alphabet/AlphabetTools.h>
 #include <Bpp/Seq/GeneticCode/MoldMitochondrialGeneticCode.h>
+#include <Bpp/Seq/Sequence.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * And the compiled genetic codes and codon encoder, in this directory:
+ */
+#include "CompiledGeneticCode.h"
+#include "CodonEncoder.h"
+#include "Instrumentation.h" /* from ExBenchmark */
 
 /*
  * All Bio++ functions are also in a namespace, so we'll use it:
@@ -85,6 +100,116 @@ int main(int args, char ** argv)
       cout << "--------------+---------------+---------------+--------------" << endl;
     }
 
+    /*
+     * Each codon above was built as a string, and parsed by the codon alphabet before being translated.
+     * A CompiledGeneticCode calls the genetic code once for every possible triplet of nucleotide states,
+     * and then translates directly from the nucleotide codes. Let's check that it agrees with the genetic code:
+     */
+    CompiledGeneticCode cgc(*gc);
+    bool identical = true;
+    for (int pos1 = 0; pos1 < 4; ++pos1) {
+      for (int pos2 = 0; pos2 < 4; ++pos2) {
+        for (int pos3 = 0; pos3 < 4; ++pos3) {
+          int i = ca->getCodon(pos1, pos2, pos3);
+          if (gc->isStop(i))
+            identical = identical && cgc.isStop(pos1, pos2, pos3);
+          else
+            identical = identical && !cgc.isStop(pos1, pos2, pos3) && cgc.translate(pos1, pos2, pos3) == gc->translate(i);
+          identical = identical && (gc->isStart(i) == cgc.isStart(pos1, pos2, pos3)) && (gc->isAltStart(i) == cgc.isAltStart(pos1, pos2, pos3));
+        }
+      }
+    }
+    cout << "Does the compiled code agree with the genetic code? " << (identical ? "yes" : "no") << endl;
+
+    /*
+     * Ambiguous codons are translated when all their possible codons agree:
+     */
+    cout << "GGN: " << gc->getTargetAlphabet()->intToChar(cgc.translate(nt->charToInt("G"), nt->charToInt("G"), nt->charToInt("N"))) << endl;
+    cout << "ATN: " << gc->getTargetAlphabet()->intToChar(cgc.translate(nt->charToInt("A"), nt->charToInt("T"), nt->charToInt("N"))) << endl;
+
+    /*
+     * Whole sequences are translated in any of the six frames, without building their reverse complement:
+     */
+    BasicSequence sequence("My first sequence", "ATGGATTACAATGATTACATGGTTAG", nt);
+    for (int frame = 1; frame <= 3; ++frame) {
+      Sequence* protein = cgc.translate(sequence, frame);
+      cout << "Frame +" << frame << ": " << protein->toString() << endl;
+      delete protein;
+      protein = cgc.translate(sequence, -frame);
+      cout << "Frame -" << frame << ": " << protein->toString() << endl;
+      delete protein;
+    }
+
+    /*
+     * Let's compare with the codon by codon approach on a random genome, in the first frame only:
+     */
+    size_t genomeLength = 3000000; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
+    mt19937 rng(42);
+    uniform_int_distribution<int> nucleotide(0, 3);
+    vector<int> genome(genomeLength);
+    for (size_t i = 0; i < genomeLength; ++i)
+      genome[i] = nucleotide(rng);
+
+    size_t nbStops = 0;
+    ApplicationTools::startTimer();
+    for (size_t i = 0; i + 2 < genomeLength; i += 3) {
+      string s = nt->intToChar(genome[i]) + nt->intToChar(genome[i + 1]) + nt->intToChar(genome[i + 2]);
+      if (gc->isStop(s))
+        nbStops++;
+      else
+        gc->translate(ca->charToInt(s));
+    }
+    ApplicationTools::displayTime("Time used for one frame, codon by codon:");
+
+    size_t nbStopsCompiled = 0;
+    vector<int> protein(CompiledGeneticCode::getNumberOfCodons(genomeLength, 1));
+    ApplicationTools::startTimer();
+    for (int frame = -3; frame <= 3; ++frame) {
+      if (frame == 0)
+        continue;
+      size_t n = cgc.translateFrame(&genome[0], genomeLength, frame, &protein[0]);
+      if (frame == 1) {
+        for (size_t k = 0; k < n; ++k)
+          nbStopsCompiled += (protein[k] == CompiledGeneticCode::STOP ? 1 : 0);
+      }
+    }
+    ApplicationTools::displayTime("Time used for six frames, with the compiled code:");
+    cout << "Number of stop codons in the first frame: " << nbStops << " / " << nbStopsCompiled << endl;
+
+    /*
+     * Codon sequences, as in ExSequence, are usually created from the string of a nucleotide sequence,
+     * which is parsed three characters at a time. The CodonEncoder computes the codon states directly
+     * from the nucleotide states, and back:
+     */
+    CodonEncoder encoder(ca);
+    BasicSequence nucleotides("Some codons", "ATGGAT---TANNNNTTA", nt);
+    Sequence* codons = encoder.encode(nucleotides);
+    cout << "Codons     : " << codons->toString() << endl;
+    Sequence* decoded = encoder.decode(*codons);
+    cout << "Nucleotides: " << decoded->toString() << endl;
+    delete codons;
+    delete decoded;
+
+    /*
+     * Let's compare both approaches on the random genome:
+     */
+    BasicSequence genomeSequence("Genome", genome, nt);
+    ApplicationTools::startTimer();
+    Sequence* parsed = new BasicSequence(genomeSequence.getName(), genomeSequence.toString(), ca);
+    ApplicationTools::displayTime("Time used to create the codon sequence from a string:");
+    ApplicationTools::startTimer();
+    Sequence* encoded = encoder.encode(genomeSequence);
+    ApplicationTools::displayTime("Time used to create the codon sequence with the encoder:");
+    cout << "Same codons? " << (parsed->getContent() == encoded->getContent() ? "yes" : "no") << endl;
+    delete parsed;
+    delete encoded;
+
+    /*
+     * With 'make INSTRUMENTATION=1', the translations and encodings above are also counted,
+     * with the number of codons processed and the memory allocated:
+     */
+    Instrumentation::display();
+
   } catch(Exception& e) {
     cerr << e.what() << endl;
   }
@@ -0,0 +1,243 @@
+/*
+ * File: ExKmerIndex.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 00:20 2026
+ *
+ * Looking for sequences by their content, with a k-mer index.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <map> /* to count k-mers the naive way. */
+#include <random> /* to simulate a genome. */
+#include <string>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/Text/TextTools.h>
+
+/*
+ * And the k-mer index, in this directory:
+ */
+#include "KmerIndex.h"
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * The occurrences of all k-mers, found the naive way by scanning the text of the sequences.
+ * K-mers with a gap or an ambiguous nucleotide are skipped, as in the index.
+ * We use it to check the content of the index.
+ */
+map< string, vector<KmerHit> > naiveKmers(const OrderedSequenceContainer& sequences, size_t k)
+{
+  map< string, vector<KmerHit> > kmers;
+  for (size_t i = 0; i < sequences.getNumberOfSequences(); i++)
+  {
+    string text = sequences.getSequence(i).toString();
+    for (size_t j = 0; j + k <= text.size(); j++)
+    {
+      string kmer = text.substr(j, k);
+      if (kmer.find_first_not_of("ACGT") == string::npos)
+      {
+        KmerHit hit = { static_cast<uint32_t>(i), static_cast<uint32_t>(j) };
+        kmers[kmer].push_back(hit);
+      }
+    }
+  }
+  return kmers;
+}
+
+bool sameSeeds(const vector<SeedHit>& seeds1, const vector<SeedHit>& seeds2)
+{
+  if (seeds1.size() != seeds2.size())
+    return false;
+  for (size_t i = 0; i < seeds1.size(); i++)
+    if (seeds1[i].queryPosition != seeds2[i].queryPosition || seeds1[i].sequence != seeds2[i].sequence || seeds1[i].position != seeds2[i].position)
+      return false;
+  return true;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * Containers give access to sequences by name or by position only.
+     * To find where a given word appears, we index all the words of size k (the k-mers) of the sequences.
+     * Here, k = 12, and the index is built on all available cores:
+     */
+    Fasta fasReader;
+    OrderedSequenceContainer* sequences = fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    KmerIndex index(*sequences, 12);
+    cout << "The index has " << index.getNumberOfKmers() << " distinct " << index.getKmerSize() << "-mers, ";
+    cout << "with " << index.getNumberOfHits() << " occurrences." << endl;
+
+    /*
+     * Let's check that the index finds the same occurrences as a naive scan of the sequences:
+     */
+    map< string, vector<KmerHit> > kmers = naiveKmers(*sequences, index.getKmerSize());
+    bool sameIndex = (kmers.size() == index.getNumberOfKmers());
+    size_t nbNaiveHits = 0;
+    vector<KmerHit> indexHits;
+    for (map< string, vector<KmerHit> >::iterator it = kmers.begin(); it != kmers.end(); it++)
+    {
+      index.getHits(it->first, indexHits);
+      sameIndex = sameIndex && indexHits.size() == it->second.size();
+      for (size_t i = 0; sameIndex && i < indexHits.size(); i++)
+        sameIndex = indexHits[i].sequence == it->second[i].sequence && indexHits[i].position == it->second[i].position;
+      nbNaiveHits += it->second.size();
+    }
+    sameIndex = sameIndex && nbNaiveHits == index.getNumberOfHits();
+    cout << "Same occurrences as a naive scan? " << (sameIndex ? "yes" : "no") << endl;
+
+    /*
+     * Where does a k-mer appear? K-mers containing gaps are not indexed, so positions refer to the aligned sequences.
+     */
+    string kmer = sequences->getSequence(0).toString().substr(100, 12);
+    vector<KmerHit> hits;
+    if (kmer.find('-') == string::npos)
+    {
+      index.getHits(kmer, hits);
+      cout << kmer << " appears " << hits.size() << " times:" << endl;
+      for (size_t i = 0; i < hits.size(); i++)
+        cout << "  " << index.getSequenceName(hits[i].sequence) << " at position " << (hits[i].position + 1) << endl;
+    }
+
+    /*
+     * A whole sequence can also be looked for. Each of its k-mers (the seeds) is searched in the index,
+     * and all their occurrences are reported. Here we only count them per sequence:
+     */
+    const Sequence& query = sequences->getSequence(sequences->getNumberOfSequences() - 1);
+    vector<SeedHit> seeds;
+    size_t nbSeeds = index.query(query, seeds);
+    vector<size_t> shared(index.getNumberOfSequences(), 0);
+    for (size_t i = 0; i < seeds.size(); i++)
+      shared[seeds[i].sequence]++;
+    cout << query.getName() << " has " << nbSeeds << " seeds. Shared seeds with:" << endl;
+    for (size_t i = 0; i < shared.size(); i++)
+      cout << "  " << index.getSequenceName(i) << ": " << shared[i] << endl;
+    delete sequences;
+
+    /*
+     * On large sets of sequences, building the index takes a while.
+     * The index can be saved to a file, and mapped in memory later on: nothing is read or rebuilt then.
+     * Let's try with a simulated genome. Only the minimizers are indexed this time:
+     * the k-mers with the smallest hash value in each window of 10 consecutive k-mers.
+     * This makes the index about 5 times smaller, and any match of at least 10 + 21 - 1 = 30 nucleotides
+     * is still found by query().
+     */
+    size_t nbChromosomes = 8;
+    size_t chromosomeLength = 2000000; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
+    const char* nucleotides = "ACGT";
+    mt19937 rng(42);
+    uniform_int_distribution<int> nucleotide(0, 3);
+    VectorSequenceContainer genome(&AlphabetTools::DNA_ALPHABET);
+    for (size_t c = 0; c < nbChromosomes; c++)
+    {
+      string chromosome(chromosomeLength, 'A');
+      for (size_t i = 0; i < chromosomeLength; i++)
+        chromosome[i] = nucleotides[nucleotide(rng)];
+      genome.addSequence(BasicSequence("chr" + TextTools::toString(c + 1), chromosome, &AlphabetTools::DNA_ALPHABET), false);
+    }
+
+    /*
+     * We will look for reads taken from chromosome 3, and compare the seeds found before and after the index is saved:
+     */
+    vector<BasicSequence> reads;
+    for (size_t i = 0; i < 100; i++)
+      reads.push_back(BasicSequence("read" + TextTools::toString(i + 1), genome.getSequence(2).toString().substr(123456 + i * 1000, 150), &AlphabetTools::DNA_ALPHABET));
+
+    ApplicationTools::startTimer();
+    KmerIndex* genomeIndex = new KmerIndex(genome, 21, 10);
+    ApplicationTools::displayTime("Time used to build the index:");
+    vector< vector<SeedHit> > builtSeeds(reads.size());
+    for (size_t i = 0; i < reads.size(); i++)
+      genomeIndex->query(reads[i], builtSeeds[i]);
+    genomeIndex->write("genome.kmers");
+    delete genomeIndex;
+
+    ApplicationTools::startTimer();
+    genomeIndex = KmerIndex::load("genome.kmers");
+    ApplicationTools::displayTime("Time used to load the index:");
+    ApplicationTools::displayResult("Number of indexed minimizers", genomeIndex->getNumberOfHits());
+    bool sameQueries = true;
+    bool allFound = true;
+    for (size_t i = 0; i < reads.size(); i++)
+    {
+      genomeIndex->query(reads[i], seeds);
+      sameQueries = sameQueries && sameSeeds(seeds, builtSeeds[i]);
+      //Each read has at least one seed at its true location:
+      bool found = false;
+      for (size_t j = 0; j < seeds.size(); j++)
+        found = found || (seeds[j].sequence == 2 && seeds[j].position == 123456 + i * 1000 + seeds[j].queryPosition);
+      allFound = allFound && found;
+    }
+    cout << "Same seeds after loading the index? " << (sameQueries ? "yes" : "no") << endl;
+    cout << "All reads found at their location? " << (allFound ? "yes" : "no") << endl;
+
+    /*
+     * Here are the seeds of the first read:
+     */
+    genomeIndex->query(reads[0], seeds);
+    for (size_t i = 0; i < seeds.size(); i++)
+      cout << "Seed at position " << (seeds[i].queryPosition + 1) << " of the read found in "
+           << genomeIndex->getSequenceName(seeds[i].sequence) << " at position " << (seeds[i].position + 1) << endl;
+    delete genomeIndex;
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
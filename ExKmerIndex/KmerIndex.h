@@ -0,0 +1,684 @@
+/*
+ * File: KmerIndex.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 00:20 2026
+ *
+ * A hashed index of the k-mers of a set of nucleotide sequences, which can be saved and memory-mapped.
+ */
+
+#ifndef _KMERINDEX_H_
+#define _KMERINDEX_H_
+
+#include "ThreadPool.h" /* from ExParallelFasta */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bpp
+{
+  /**
+   * @brief An occurrence of a k-mer in the indexed sequences.
+   */
+  struct KmerHit
+  {
+    uint32_t sequence; //Index of the sequence in the container.
+    uint32_t position; //Position of the first nucleotide of the k-mer, starting at 0.
+  };
+
+  /**
+   * @brief A seed shared by a query sequence and an indexed sequence.
+   */
+  struct SeedHit
+  {
+    size_t queryPosition;
+    size_t sequence;
+    size_t position;
+  };
+
+  /**
+   * @brief Index of the k-mers of a set of DNA or RNA sequences.
+   *
+   * K-mers are encoded with 2 bits per nucleotide (so k is at most 32), with a rolling code
+   * updated at each position. K-mers containing a gap or an ambiguous nucleotide are not indexed.
+   *
+   * With a window w > 1, only the minimizers are indexed: in each run of w consecutive k-mers,
+   * the one with the smallest hash value. This divides the size of the index by about (w + 1) / 2,
+   * and two sequences sharing at least w + k - 1 consecutive nucleotides still share a minimizer,
+   * which query() will find. With w = 1, all k-mers are indexed.
+   *
+   * The occurrences of all k-mers are stored in a single array, grouped by k-mer. The k-mers are
+   * in an open-addressing hash table, split into buckets according to the high bits of their hash value,
+   * so that buckets are sorted and filled in parallel. All data are flat arrays without pointers:
+   * an index can be written to a file, and mapped back in memory without any parsing with load().
+   * The file is only valid on machines with the same endianness.
+   */
+  class KmerIndex
+  {
+  private:
+    struct Slot
+    {
+      uint64_t key;
+      uint64_t begin;
+      uint64_t count; //0 for empty slots.
+    };
+
+    struct Header
+    {
+      char magic[8];
+      uint32_t version;
+      uint32_t kmerSize;
+      uint32_t window;
+      uint32_t alphabet; //0 for DNA, 1 for RNA.
+      uint64_t nbSequences;
+      uint64_t nbBuckets;
+      uint64_t nbSlots;
+      uint64_t nbKmers;
+      uint64_t nbHits;
+      uint64_t nbNameChars;
+    };
+
+    enum { VERSION = 1 };
+
+    unsigned int kmerSize_;
+    unsigned int window_;
+    const Alphabet* alphabet_;
+    size_t nbSequences_;
+    size_t nbBuckets_;
+    unsigned int bucketBits_;
+    size_t nbSlots_;
+    size_t nbKmers_;
+    size_t nbHits_;
+    size_t nbNameChars_;
+
+    //The arrays of the index, either owned by the vectors below, or in the mapped file:
+    const uint64_t* bucketOffsets_;
+    const Slot* slots_;
+    const KmerHit* hits_;
+    const uint64_t* lengths_;
+    const uint64_t* nameOffsets_;
+    const char* nameChars_;
+
+    std::vector<uint64_t> bucketOffsetsData_;
+    std::vector<Slot> slotsData_;
+    std::vector<KmerHit> hitsData_;
+    std::vector<uint64_t> lengthsData_;
+    std::vector<uint64_t> nameOffsetsData_;
+    std::vector<char> nameCharsData_;
+
+    void* map_;
+    size_t mapSize_;
+
+  public:
+    /**
+     * @brief Build the index of a set of sequences.
+     *
+     * @param sequences The sequences to index, with a DNA or RNA alphabet.
+     * @param kmerSize  The size of the k-mers, between 1 and 32.
+     * @param window    The number of consecutive k-mers from which a minimizer is chosen. 1 means all k-mers are indexed.
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     * @throw AlphabetException If the alphabet is not a DNA or RNA alphabet.
+     * @throw Exception If the parameters are invalid, or sequences are too long.
+     */
+    KmerIndex(const OrderedSequenceContainer& sequences, unsigned int kmerSize, unsigned int window = 1, unsigned int nbThreads = 0) :
+      kmerSize_(kmerSize), window_(window), alphabet_(sequences.getAlphabet()),
+      nbSequences_(sequences.getNumberOfSequences()), nbBuckets_(0), bucketBits_(0), nbSlots_(0), nbKmers_(0), nbHits_(0), nbNameChars_(0),
+      bucketOffsets_(0), slots_(0), hits_(0), lengths_(0), nameOffsets_(0), nameChars_(0),
+      bucketOffsetsData_(), slotsData_(), hitsData_(), lengthsData_(), nameOffsetsData_(), nameCharsData_(),
+      map_(0), mapSize_(0)
+    {
+      if (!AlphabetTools::isDNAAlphabet(alphabet_) && !AlphabetTools::isRNAAlphabet(alphabet_))
+        throw AlphabetException("KmerIndex. Only DNA and RNA sequences can be indexed.", alphabet_);
+      if (kmerSize_ == 0 || kmerSize_ > 32)
+        throw Exception("KmerIndex. The size of the k-mers must be between 1 and 32.");
+      if (window_ == 0)
+        throw Exception("KmerIndex. The window must contain at least one k-mer.");
+      if (nbSequences_ > 0xFFFFFFFFu)
+        throw Exception("KmerIndex. Too many sequences.");
+      build_(sequences, nbThreads);
+    }
+
+    ~KmerIndex()
+    {
+      if (map_)
+        ::munmap(map_, mapSize_);
+    }
+
+  private:
+    KmerIndex() :
+      kmerSize_(0), window_(0), alphabet_(0),
+      nbSequences_(0), nbBuckets_(0), bucketBits_(0), nbSlots_(0), nbKmers_(0), nbHits_(0), nbNameChars_(0),
+      bucketOffsets_(0), slots_(0), hits_(0), lengths_(0), nameOffsets_(0), nameChars_(0),
+      bucketOffsetsData_(), slotsData_(), hitsData_(), lengthsData_(), nameOffsetsData_(), nameCharsData_(),
+      map_(0), mapSize_(0)
+    {}
+
+    KmerIndex(const KmerIndex&);
+    KmerIndex& operator=(const KmerIndex&);
+
+  public:
+    unsigned int getKmerSize() const { return kmerSize_; }
+    unsigned int getWindowSize() const { return window_; }
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t getNumberOfSequences() const { return nbSequences_; }
+
+    /**
+     * @return The number of distinct k-mers in the index.
+     */
+    size_t getNumberOfKmers() const { return nbKmers_; }
+
+    /**
+     * @return The total number of occurrences in the index.
+     */
+    size_t getNumberOfHits() const { return nbHits_; }
+
+    /**
+     * @return The name of the ith indexed sequence.
+     */
+    std::string getSequenceName(size_t i) const
+    {
+      checkSequence_(i);
+      return std::string(nameChars_ + nameOffsets_[i], nameChars_ + nameOffsets_[i + 1]);
+    }
+
+    /**
+     * @return The length of the ith indexed sequence.
+     */
+    size_t getSequenceLength(size_t i) const
+    {
+      checkSequence_(i);
+      return static_cast<size_t>(lengths_[i]);
+    }
+
+    /**
+     * @return The 2 bits code of a k-mer.
+     * @throw BadSizeException If the k-mer does not have the size of the index.
+     * @throw BadCharException If the k-mer contains a character which is not A, C, G or T (U).
+     */
+    uint64_t getCode(const std::string& kmer) const
+    {
+      if (kmer.size() != kmerSize_)
+        throw BadSizeException("KmerIndex::getCode. Wrong k-mer size.", kmer.size(), kmerSize_);
+      uint64_t code = 0;
+      for (size_t i = 0; i < kmer.size(); ++i)
+      {
+        int state = alphabet_->charToInt(kmer.substr(i, 1));
+        if (state < 0 || state > 3)
+          throw BadCharException(kmer.substr(i, 1), "KmerIndex::getCode. Only resolved nucleotides are allowed.", alphabet_);
+        code = (code << 2) | static_cast<uint64_t>(state);
+      }
+      return code;
+    }
+
+    /**
+     * @return The k-mer corresponding to a 2 bits code.
+     */
+    std::string getKmer(uint64_t code) const
+    {
+      std::string kmer(kmerSize_, ' ');
+      for (size_t i = kmerSize_; i > 0; --i, code >>= 2)
+        kmer[i - 1] = alphabet_->intToChar(static_cast<int>(code & 3))[0];
+      return kmer;
+    }
+
+    /**
+     * @brief Find the occurrences of a k-mer.
+     *
+     * The occurrences are sorted by sequence and position. They point inside the index, and remain valid
+     * as long as the index exists.
+     *
+     * @param code   The 2 bits code of the k-mer.
+     * @param nbHits [out] The number of occurrences.
+     * @return A pointer to the first occurrence, or 0 if the k-mer is not in the index.
+     */
+    const KmerHit* findHits(uint64_t code, size_t& nbHits) const
+    {
+      nbHits = 0;
+      if (nbBuckets_ == 0)
+        return 0;
+      uint64_t h = hash_(code);
+      size_t b = static_cast<size_t>(h >> (64 - bucketBits_));
+      const Slot* slots = slots_ + bucketOffsets_[b];
+      size_t capacity = static_cast<size_t>(bucketOffsets_[b + 1] - bucketOffsets_[b]);
+      if (capacity == 0)
+        return 0;
+      for (size_t s = static_cast<size_t>(h) & (capacity - 1); slots[s].count != 0; s = (s + 1) & (capacity - 1))
+      {
+        if (slots[s].key == code)
+        {
+          nbHits = static_cast<size_t>(slots[s].count);
+          return hits_ + slots[s].begin;
+        }
+      }
+      return 0;
+    }
+
+    /**
+     * @brief Get the occurrences of a k-mer.
+     *
+     * With a window larger than 1, only the k-mers which were selected as minimizers have occurrences.
+     *
+     * @param kmer The k-mer.
+     * @param hits [out] The occurrences. The previous content is erased.
+     */
+    void getHits(const std::string& kmer, std::vector<KmerHit>& hits) const
+    {
+      size_t nbHits;
+      const KmerHit* first = findHits(getCode(kmer), nbHits);
+      hits.assign(first, first + nbHits);
+    }
+
+    /**
+     * @brief Find the seeds of a query sequence in the index.
+     *
+     * Seeds are the k-mers of the query (or its minimizers, with the same window as the index),
+     * and each occurrence of a seed in the index is reported.
+     *
+     * @param query          The query sequence.
+     * @param hits           [out] The seeds found, sorted by query position. The previous content is erased.
+     * @param maxOccurrences Seeds with more occurrences in the index are ignored, to skip repeats. 0 means no limit.
+     * @return The number of seeds of the query.
+     * @throw AlphabetMismatchException If the query does not have the alphabet of the index.
+     */
+    size_t query(const Sequence& query, std::vector<SeedHit>& hits, size_t maxOccurrences = 0) const
+    {
+      if (query.getAlphabet()->getAlphabetType() != alphabet_->getAlphabetType())
+        throw AlphabetMismatchException("KmerIndex::query", alphabet_, query.getAlphabet());
+      hits.clear();
+      const std::vector<int>& content = query.getContent();
+      size_t nbSeeds = 0;
+      if (content.empty())
+        return 0;
+      forEachSeed_(&content[0], content.size(), [&](uint64_t code, size_t pos) {
+        ++nbSeeds;
+        size_t nbHits;
+        const KmerHit* first = findHits(code, nbHits);
+        if (maxOccurrences > 0 && nbHits > maxOccurrences)
+          return;
+        for (size_t k = 0; k < nbHits; ++k)
+        {
+          SeedHit hit = { pos, first[k].sequence, first[k].position };
+          hits.push_back(hit);
+        }
+      });
+      return nbSeeds;
+    }
+
+    /**
+     * @brief Write the index to a file, which can be mapped again with load().
+     *
+     * @param path The file to write.
+     * @throw IOException If the file can't be written.
+     */
+    void write(const std::string& path) const
+    {
+      std::ofstream out(path.c_str(), std::ios::out | std::ios::binary);
+      if (!out)
+        throw IOException("KmerIndex::write. Can't open file " + path);
+      Header header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, "BPPKMERS", 8);
+      header.version = VERSION;
+      header.kmerSize = kmerSize_;
+      header.window = window_;
+      header.alphabet = AlphabetTools::isRNAAlphabet(alphabet_) ? 1 : 0;
+      header.nbSequences = nbSequences_;
+      header.nbBuckets = nbBuckets_;
+      header.nbSlots = nbSlots_;
+      header.nbKmers = nbKmers_;
+      header.nbHits = nbHits_;
+      header.nbNameChars = nbNameChars_;
+      out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      write_(out, bucketOffsets_, nbBuckets_ + 1);
+      write_(out, slots_, nbSlots_);
+      write_(out, hits_, nbHits_);
+      write_(out, lengths_, nbSequences_);
+      write_(out, nameOffsets_, nbSequences_ + 1);
+      write_(out, nameChars_, nbNameChars_);
+      out.close();
+      if (!out)
+        throw IOException("KmerIndex::write. Error while writing file " + path);
+    }
+
+    /**
+     * @brief Map an index written with write().
+     *
+     * Nothing is read from the file at this point: pages are loaded by the system when queries need them.
+     *
+     * @param path The file to map.
+     * @return A new KmerIndex object, which keeps the file mapped until it is destroyed.
+     * @throw IOException If the file can't be mapped, or is not a valid index.
+     */
+    static KmerIndex* load(const std::string& path)
+    {
+      int fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        throw IOException("KmerIndex::load. Can't open file " + path);
+      struct stat st;
+      if (::fstat(fd, &st) != 0)
+      {
+        ::close(fd);
+        throw IOException("KmerIndex::load. Can't stat file " + path);
+      }
+      size_t size = static_cast<size_t>(st.st_size);
+      if (size < sizeof(Header))
+      {
+        ::close(fd);
+        throw IOException("KmerIndex::load. Not a k-mer index: " + path);
+      }
+      void* map = ::mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if (map == MAP_FAILED)
+        throw IOException("KmerIndex::load. Can't map file " + path);
+      ::madvise(map, size, MADV_RANDOM);
+
+      KmerIndex* index = new KmerIndex();
+      index->map_ = map;
+      index->mapSize_ = size;
+      const char* data = static_cast<const char*>(map);
+      Header header;
+      std::memcpy(&header, data, sizeof(header));
+      size_t expected = sizeof(Header)
+        + (header.nbBuckets + 1) * sizeof(uint64_t) + header.nbSlots * sizeof(Slot) + header.nbHits * sizeof(KmerHit)
+        + (2 * header.nbSequences + 1) * sizeof(uint64_t) + header.nbNameChars;
+      if (std::memcmp(header.magic, "BPPKMERS", 8) != 0 || header.version != VERSION || expected != size)
+      {
+        delete index;
+        throw IOException("KmerIndex::load. Not a valid k-mer index: " + path);
+      }
+      index->kmerSize_ = header.kmerSize;
+      index->window_ = header.window;
+      index->alphabet_ = (header.alphabet == 1 ? static_cast<const Alphabet*>(&AlphabetTools::RNA_ALPHABET) : static_cast<const Alphabet*>(&AlphabetTools::DNA_ALPHABET));
+      index->nbSequences_ = static_cast<size_t>(header.nbSequences);
+      index->nbBuckets_ = static_cast<size_t>(header.nbBuckets);
+      index->bucketBits_ = getBucketBits_(index->nbBuckets_);
+      index->nbSlots_ = static_cast<size_t>(header.nbSlots);
+      index->nbKmers_ = static_cast<size_t>(header.nbKmers);
+      index->nbHits_ = static_cast<size_t>(header.nbHits);
+      index->nbNameChars_ = static_cast<size_t>(header.nbNameChars);
+      data += sizeof(Header);
+      index->bucketOffsets_ = reinterpret_cast<const uint64_t*>(data);
+      data += (index->nbBuckets_ + 1) * sizeof(uint64_t);
+      index->slots_ = reinterpret_cast<const Slot*>(data);
+      data += index->nbSlots_ * sizeof(Slot);
+      index->hits_ = reinterpret_cast<const KmerHit*>(data);
+      data += index->nbHits_ * sizeof(KmerHit);
+      index->lengths_ = reinterpret_cast<const uint64_t*>(data);
+      data += index->nbSequences_ * sizeof(uint64_t);
+      index->nameOffsets_ = reinterpret_cast<const uint64_t*>(data);
+      data += (index->nbSequences_ + 1) * sizeof(uint64_t);
+      index->nameChars_ = data;
+      return index;
+    }
+
+  private:
+    /*
+     * Bijective mixing of the bits of a k-mer code (the finalizer of MurmurHash3),
+     * used both to place k-mers in the table and to choose the minimizers.
+     */
+    static uint64_t hash_(uint64_t x)
+    {
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33;
+      return x;
+    }
+
+    static unsigned int getBucketBits_(size_t nbBuckets)
+    {
+      unsigned int bits = 0;
+      while ((static_cast<size_t>(1) << bits) < nbBuckets)
+        ++bits;
+      return bits;
+    }
+
+    void checkSequence_(size_t i) const
+    {
+      if (i >= nbSequences_)
+        throw IndexOutOfBoundsException("KmerIndex. Bad sequence index.", i, 0, nbSequences_ - 1);
+    }
+
+    template<class T>
+    static void write_(std::ofstream& out, const T* data, size_t n)
+    {
+      if (n > 0)
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n * sizeof(T)));
+    }
+
+    /*
+     * Call f(code, position) for each seed of a sequence: all k-mers with resolved nucleotides,
+     * or only their minimizers if the window is larger than 1.
+     * Minimizers are chosen within runs of resolved nucleotides. A run with less than 'window' k-mers
+     * still gives its smallest k-mer.
+     */
+    template<class F>
+    void forEachSeed_(const int* states, size_t n, F f) const
+    {
+      uint64_t mask = (kmerSize_ == 32 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << (2 * kmerSize_)) - 1);
+      uint64_t code = 0;
+      size_t valid = 0;
+      if (window_ == 1)
+      {
+        for (size_t i = 0; i < n; ++i)
+        {
+          int state = states[i];
+          if (state & ~3)
+          {
+            valid = 0;
+            continue;
+          }
+          code = ((code << 2) | static_cast<uint64_t>(state)) & mask;
+          if (++valid >= kmerSize_)
+            f(code, i + 1 - kmerSize_);
+        }
+        return;
+      }
+
+      struct Candidate
+      {
+        uint64_t hash;
+        uint64_t code;
+        size_t position;
+        size_t rank; //Index of the k-mer in the run.
+      };
+      std::deque<Candidate> candidates; //Increasing hash values.
+      size_t nbKmers = 0;              //Number of k-mers in the current run.
+      size_t last = static_cast<size_t>(-1);
+      for (size_t i = 0; i <= n; ++i)
+      {
+        if (i == n || (states[i] & ~3))
+        {
+          //End of a run too short to fill a window:
+          if (nbKmers > 0 && nbKmers < window_)
+            f(candidates.front().code, candidates.front().position);
+          candidates.clear();
+          nbKmers = 0;
+          valid = 0;
+          continue;
+        }
+        code = ((code << 2) | static_cast<uint64_t>(states[i])) & mask;
+        if (++valid < kmerSize_)
+          continue;
+        Candidate c = { hash_(code), code, i + 1 - kmerSize_, nbKmers++ };
+        while (!candidates.empty() && candidates.back().hash > c.hash)
+          candidates.pop_back();
+        candidates.push_back(c);
+        if (candidates.front().rank + window_ < nbKmers)
+          candidates.pop_front();
+        if (nbKmers >= window_ && candidates.front().position != last)
+        {
+          last = candidates.front().position;
+          f(candidates.front().code, last);
+        }
+      }
+    }
+
+    void build_(const OrderedSequenceContainer& sequences, unsigned int nbThreads)
+    {
+      ThreadPool pool(nbThreads);
+
+      //Names and lengths:
+      lengthsData_.resize(nbSequences_);
+      nameOffsetsData_.assign(1, 0);
+      for (size_t i = 0; i < nbSequences_; ++i)
+      {
+        const Sequence& sequence = sequences.getSequence(i);
+        if (sequence.size() > 0xFFFFFFFFu)
+          throw Exception("KmerIndex. Sequence " + sequence.getName() + " is too long.");
+        lengthsData_[i] = sequence.size();
+        const std::string& name = sequence.getName();
+        nameCharsData_.insert(nameCharsData_.end(), name.begin(), name.end());
+        nameOffsetsData_.push_back(nameCharsData_.size());
+      }
+
+      //Seeds are listed twice: once to count them, then to store them, each sequence at its own offset.
+      //Entries are (k-mer code, sequence << 32 | position).
+      std::vector<uint64_t> offsets(nbSequences_ + 1, 0);
+      pool.parallelFor(nbSequences_, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+          const std::vector<int>& content = sequences.getSequence(i).getContent();
+          size_t count = 0;
+          if (!content.empty())
+            forEachSeed_(&content[0], content.size(), [&](uint64_t, size_t) { ++count; });
+          offsets[i + 1] = count;
+        }
+      });
+      for (size_t i = 0; i < nbSequences_; ++i)
+        offsets[i + 1] += offsets[i];
+      size_t nbEntries = static_cast<size_t>(offsets[nbSequences_]);
+      std::vector< std::pair<uint64_t, uint64_t> > entries(nbEntries);
+      pool.parallelFor(nbSequences_, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+          const std::vector<int>& content = sequences.getSequence(i).getContent();
+          size_t k = static_cast<size_t>(offsets[i]);
+          if (!content.empty())
+            forEachSeed_(&content[0], content.size(), [&](uint64_t code, size_t pos) {
+              entries[k++] = std::make_pair(code, (static_cast<uint64_t>(i) << 32) | pos);
+            });
+        }
+      });
+
+      //Entries are distributed into buckets according to the high bits of the hash value of their k-mer,
+      //so that each bucket is then processed independently.
+      nbBuckets_ = 64;
+      while (nbBuckets_ < (1 << 16) && (nbBuckets_ * 4096 < nbEntries || nbBuckets_ < 8 * pool.getNumberOfThreads()))
+        nbBuckets_ *= 2;
+      bucketBits_ = getBucketBits_(nbBuckets_);
+      size_t nbChunks = pool.getNumberOfThreads();
+      size_t chunkSize = (nbEntries + nbChunks - 1) / nbChunks;
+      std::vector<size_t> counts(nbChunks * nbBuckets_, 0);
+      pool.parallelFor(nbChunks, [&](size_t c0, size_t c1) {
+        for (size_t c = c0; c < c1; ++c)
+        {
+          size_t* count = &counts[c * nbBuckets_];
+          for (size_t k = c * chunkSize; k < std::min((c + 1) * chunkSize, nbEntries); ++k)
+            ++count[hash_(entries[k].first) >> (64 - bucketBits_)];
+        }
+      }, 1);
+      std::vector<size_t> entryOffsets(nbBuckets_ + 1, 0);
+      size_t total = 0;
+      for (size_t b = 0; b < nbBuckets_; ++b)
+      {
+        entryOffsets[b] = total;
+        for (size_t c = 0; c < nbChunks; ++c)
+        {
+          size_t count = counts[c * nbBuckets_ + b];
+          counts[c * nbBuckets_ + b] = total;
+          total += count;
+        }
+      }
+      entryOffsets[nbBuckets_] = total;
+      std::vector< std::pair<uint64_t, uint64_t> > sorted(nbEntries);
+      pool.parallelFor(nbChunks, [&](size_t c0, size_t c1) {
+        for (size_t c = c0; c < c1; ++c)
+        {
+          size_t* next = &counts[c * nbBuckets_];
+          for (size_t k = c * chunkSize; k < std::min((c + 1) * chunkSize, nbEntries); ++k)
+            sorted[next[hash_(entries[k].first) >> (64 - bucketBits_)]++] = entries[k];
+        }
+      }, 1);
+      std::vector< std::pair<uint64_t, uint64_t> >().swap(entries);
+
+      //Each bucket is sorted, and gets a hash table at least twice as large as its number of k-mers:
+      std::vector<size_t> nbKmers(nbBuckets_, 0);
+      pool.parallelFor(nbBuckets_, [&](size_t b0, size_t b1) {
+        for (size_t b = b0; b < b1; ++b)
+        {
+          std::sort(sorted.begin() + static_cast<std::ptrdiff_t>(entryOffsets[b]), sorted.begin() + static_cast<std::ptrdiff_t>(entryOffsets[b + 1]));
+          for (size_t k = entryOffsets[b]; k < entryOffsets[b + 1]; ++k)
+            if (k == entryOffsets[b] || sorted[k].first != sorted[k - 1].first)
+              ++nbKmers[b];
+        }
+      });
+      bucketOffsetsData_.assign(nbBuckets_ + 1, 0);
+      nbKmers_ = 0;
+      for (size_t b = 0; b < nbBuckets_; ++b)
+      {
+        size_t capacity = 0;
+        if (nbKmers[b] > 0)
+          for (capacity = 2; capacity < 2 * nbKmers[b]; capacity *= 2) {}
+        bucketOffsetsData_[b + 1] = bucketOffsetsData_[b] + capacity;
+        nbKmers_ += nbKmers[b];
+      }
+      nbSlots_ = static_cast<size_t>(bucketOffsetsData_[nbBuckets_]);
+      Slot empty = { 0, 0, 0 };
+      slotsData_.assign(nbSlots_, empty);
+      hitsData_.resize(nbEntries);
+      pool.parallelFor(nbBuckets_, [&](size_t b0, size_t b1) {
+        for (size_t b = b0; b < b1; ++b)
+        {
+          Slot* slots = slotsData_.empty() ? 0 : &slotsData_[bucketOffsetsData_[b]];
+          size_t capacity = static_cast<size_t>(bucketOffsetsData_[b + 1] - bucketOffsetsData_[b]);
+          Slot* current = 0;
+          for (size_t k = entryOffsets[b]; k < entryOffsets[b + 1]; ++k)
+          {
+            uint64_t key = sorted[k].first;
+            if (k == entryOffsets[b] || key != sorted[k - 1].first)
+            {
+              size_t s = static_cast<size_t>(hash_(key)) & (capacity - 1);
+              while (slots[s].count != 0)
+                s = (s + 1) & (capacity - 1);
+              current = &slots[s];
+              current->key = key;
+              current->begin = k;
+            }
+            ++current->count;
+            hitsData_[k].sequence = static_cast<uint32_t>(sorted[k].second >> 32);
+            hitsData_[k].position = static_cast<uint32_t>(sorted[k].second);
+          }
+        }
+      });
+      nbHits_ = nbEntries;
+      nbNameChars_ = nameCharsData_.size();
+
+      bucketOffsets_ = &bucketOffsetsData_[0];
+      slots_ = slotsData_.empty() ? 0 : &slotsData_[0];
+      hits_ = hitsData_.empty() ? 0 : &hitsData_[0];
+      lengths_ = lengthsData_.empty() ? 0 : &lengthsData_[0];
+      nameOffsets_ = &nameOffsetsData_[0];
+      nameChars_ = nameCharsData_.empty() ? 0 : &nameCharsData_[0];
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_KMERINDEX_H_
@@ -0,0 +1,277 @@
+/*
+ * File: ExMultipleAlignment.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 06:20 2026
+ *
+ * Scoring a multiple alignment, building its consensus and comparing all its sequences.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/AlphabetIndex/DefaultNucleotideScore.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+#include <Bpp/Seq/Container/SiteContainerTools.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * The scoring and identity classes, in this directory, and synthetic alignments from ExBenchmark:
+ */
+#include "MultipleAlignmentScore.h"
+#include "IdentityMatrix.h"
+#include "SyntheticAlignment.h" /* from ExBenchmark */
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * The sum-of-pairs score as it is usually written: all pairs of sequences, site by site.
+ */
+double naiveSumOfPairs(const SiteContainer& sites, const AlphabetIndex2& index, double gap)
+{
+  double score = 0;
+  for (size_t j = 0; j < sites.getNumberOfSites(); j++)
+  {
+    const Site& site = sites.getSite(j);
+    for (size_t a = 0; a < site.size(); a++)
+    {
+      for (size_t b = a + 1; b < site.size(); b++)
+      {
+        bool gapA = sites.getAlphabet()->isGap(site[a]);
+        bool gapB = sites.getAlphabet()->isGap(site[b]);
+        if (gapA && gapB)
+          continue;
+        score += (gapA || gapB) ? gap : index.getIndex(site[a], site[b]);
+      }
+    }
+  }
+  return score;
+}
+
+/*
+ * The consensus as described in MultipleAlignmentScore::getConsensus, computed sequence by sequence at each site.
+ */
+string naiveConsensus(const SiteContainer& sites, double threshold, double maxGapFraction)
+{
+  const Alphabet* alphabet = sites.getAlphabet();
+  size_t nbStates = alphabet->getSize();
+  vector<int> consensus(sites.getNumberOfSites());
+  for (size_t j = 0; j < sites.getNumberOfSites(); j++)
+  {
+    const Site& site = sites.getSite(j);
+    vector<double> weights(nbStates, 0.);
+    double total = 0.;
+    size_t nbGaps = 0;
+    for (size_t i = 0; i < site.size(); i++)
+    {
+      if (alphabet->isGap(site[i]))
+      {
+        nbGaps++;
+        continue;
+      }
+      vector<int> alias = alphabet->getAlias(site[i]);
+      if (alias.size() == nbStates)
+        continue;
+      for (size_t a = 0; a < alias.size(); a++)
+        weights[static_cast<size_t>(alias[a])] += 1. / static_cast<double>(alias.size());
+      total += 1.;
+    }
+    if (static_cast<double>(nbGaps) > maxGapFraction * static_cast<double>(site.size()))
+      consensus[j] = alphabet->getGapCharacterCode();
+    else if (total == 0.)
+      consensus[j] = alphabet->getUnknownCharacterCode();
+    else
+    {
+      //States by decreasing weight, then by increasing code:
+      vector< pair<double, int> > ranked;
+      for (size_t x = 0; x < nbStates; x++)
+        if (weights[x] > 0.)
+          ranked.push_back(make_pair(-weights[x], static_cast<int>(x)));
+      sort(ranked.begin(), ranked.end());
+      vector<int> kept;
+      double covered = 0.;
+      for (size_t k = 0; k < ranked.size() && covered < threshold * total * (1. - 1e-12); k++)
+      {
+        kept.push_back(ranked[k].second);
+        covered -= ranked[k].first;
+      }
+      sort(kept.begin(), kept.end());
+      consensus[j] = (kept.size() == 1 ? kept[0] : alphabet->getGeneric(kept));
+    }
+  }
+  return BasicSequence("consensus", consensus, alphabet).toString();
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * The sum-of-pairs score of an alignment adds the scores of all pairs of sequences, at all sites.
+     * A pair of residues is scored with an AlphabetIndex2, a residue against a gap with a fixed penalty,
+     * and two gaps are not scored. Computed pair by pair, it costs n(n-1)/2 lookups per site.
+     * MultipleAlignmentScore only counts the states of each site, and then scores pairs of states:
+     * with the counts c_x, the score of a site is sum_x c_x(c_x-1)/2 s(x,x) + sum_{x<y} c_x c_y s(x,y)
+     * plus (number of residues) x (number of gaps) x penalty.
+     */
+    Fasta fasReader;
+    unique_ptr<OrderedSequenceContainer> sequences(fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET));
+    VectorSiteContainer sites(*sequences);
+    DefaultNucleotideScore scoring(&AlphabetTools::DNA_ALPHABET);
+    MultipleAlignmentScore sop(sites, scoring, -5.);
+    double naiveScore = naiveSumOfPairs(sites, scoring, -5.);
+    cout << "Sum-of-pairs score: " << sop.getScore() << endl;
+    cout << "Computed pair by pair: " << naiveScore << endl;
+    cout << "Same score? " << (abs(sop.getScore() - naiveScore) <= 1e-9 * max(1., abs(naiveScore)) ? "yes" : "no") << endl;
+    for (size_t j = 0; j < 10; j++)
+      cout << "Site " << (j + 1) << ": " << sites.getSite(j).toString() << " score=" << sop.getSiteScore(j) << endl;
+
+    /*
+     * From a VectorSiteContainer, the states are counted site by site. From an AlignedSequenceContainer,
+     * they are counted along the sequences, by blocks of sites. Both give the same counts:
+     */
+    AlignedSequenceContainer aligned(*sequences);
+    MultipleAlignmentScore sopFromSequences(aligned, scoring, -5.);
+    bool sameCounts = (sopFromSequences.getSiteScores() == sop.getSiteScores());
+    vector<int> states = AlphabetTools::DNA_ALPHABET.getSupportedInts();
+    for (size_t j = 0; j < sites.getNumberOfSites(); j++)
+      for (size_t k = 0; k < states.size(); k++)
+        sameCounts = sameCounts && sopFromSequences.getCount(j, states[k]) == sop.getCount(j, states[k]);
+    cout << "Same counts from sequences and from sites? " << (sameCounts ? "yes" : "no") << endl;
+
+    /*
+     * The counts also give the consensus. At each site, getConsensus keeps the most frequent states until they
+     * cover the given fraction of the residues, and returns the code of this set of states: with a threshold of 1,
+     * a site with A and G gives R. A smaller threshold ignores rare states:
+     */
+    unique_ptr<Sequence> strict(sop.getConsensus(1.));
+    unique_ptr<Sequence> majority(sop.getConsensus(0.5));
+    unique_ptr<const Sequence> bppConsensus(SiteContainerTools::getConsensus(sites));
+    cout << "Strict consensus:   " << strict->toString().substr(0, 60) << endl;
+    cout << "50% consensus:      " << majority->toString().substr(0, 60) << endl;
+    cout << "SiteContainerTools: " << bppConsensus->toString().substr(0, 60) << endl;
+    bool sameConsensus = strict->toString() == naiveConsensus(sites, 1., 0.5)
+                      && majority->toString() == naiveConsensus(sites, 0.5, 0.5)
+                      && unique_ptr<Sequence>(sopFromSequences.getConsensus(0.5))->toString() == majority->toString();
+    cout << "Same consensus sequences when computed site by site? " << (sameConsensus ? "yes" : "no") << endl;
+
+    /*
+     * Now we compare all sequences with each other. IdentityMatrix gives the fraction of identical states,
+     * over the sites where both sequences have a resolved state, the same as SiteContainerTools::computeSimilarity
+     * with the SIMILARITY_NOGAP option, and unresolved states counted as gaps:
+     */
+    IdentityMatrix identities(sites);
+    IdentityMatrix identitiesFromSequences(aligned);
+    cout << "Identities computed with " << SimdSupport::getName(identities.getSimdLevel()) << " instructions." << endl;
+    bool same = true;
+    for (size_t i = 0; i < sites.getNumberOfSequences(); i++)
+    {
+      for (size_t k = i + 1; k < sites.getNumberOfSequences(); k++)
+      {
+        double similarity = SiteContainerTools::computeSimilarity(sites.getSequence(i), sites.getSequence(k), false, SiteContainerTools::SIMILARITY_NOGAP, true);
+        if (abs(similarity - identities.getIdentity(i, k)) > 1e-12
+            || identities.getNumberOfIdenticalSites(i, k) != identitiesFromSequences.getNumberOfIdenticalSites(i, k)
+            || identities.getNumberOfComparedSites(i, k) != identitiesFromSequences.getNumberOfComparedSites(i, k))
+          same = false;
+      }
+    }
+    cout << "Distance between " << identities.getSequencesNames()[0] << " and " << identities.getSequencesNames()[1] << ": " << identities.getDistance(0, 1) << endl;
+    cout << "Same identities as SiteContainerTools? " << (same ? "yes" : "no") << endl;
+
+    /*
+     * Let's see how both scale, on a larger synthetic alignment:
+     */
+    unique_ptr<VectorSequenceContainer> synthetic(SyntheticAlignment::generate(2000, 10000, &AlphabetTools::DNA_ALPHABET)); /* WATCHOUT!!! reduce these numbers if this is too slow on your computer! */
+    AlignedSequenceContainer align(*synthetic);
+
+    ApplicationTools::startTimer();
+    MultipleAlignmentScore largeSop(align, scoring, -5.);
+    ApplicationTools::displayTime("Time used for the sum-of-pairs score:");
+    cout << "Score: " << largeSop.getScore() << endl;
+
+    /*
+     * The 2 millions pairs of sequences are compared 64 sites at a time, or 256 with AVX2.
+     * Try with more or less threads:
+     */
+    for (unsigned int nbThreads = 1; nbThreads <= 8; nbThreads *= 2)
+    {
+      ApplicationTools::startTimer();
+      IdentityMatrix largeIdentities(align, nbThreads);
+      ApplicationTools::displayTime("Time used for the identity matrix with " + TextTools::toString(nbThreads) + " thread(s):");
+    }
+    ApplicationTools::startTimer();
+    IdentityMatrix scalarIdentities(align, 1, SIMD_SCALAR);
+    ApplicationTools::displayTime("Time used for the identity matrix with 1 thread, without SIMD:");
+
+    /*
+     * The cost grows with the number of pairs: 10,000 sequences make 50 millions pairs, 25 times more than above.
+     * With AVX2, this takes about 18 s on a single core, and a few seconds on all cores.
+     * WATCHOUT!!! this needs about 2 GB of memory, for the alignment and the two matrices of counts.
+     */
+    synthetic.reset(SyntheticAlignment::generate(10000, 10000, &AlphabetTools::DNA_ALPHABET));
+    unique_ptr<AlignedSequenceContainer> hugeAlign(new AlignedSequenceContainer(*synthetic));
+    synthetic.reset();
+    ApplicationTools::startTimer();
+    IdentityMatrix hugeIdentities(*hugeAlign);
+    ApplicationTools::displayTime("Time used for the identity matrix of 10,000 sequences, with all threads:");
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
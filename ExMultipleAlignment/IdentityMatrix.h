@@ -0,0 +1,294 @@
+/*
+ * File: IdentityMatrix.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 05:50 2026
+ *
+ * Identities and p-distances between all the sequences of an alignment, on bit-packed states.
+ */
+
+#ifndef _IDENTITYMATRIX_H_
+#define _IDENTITYMATRIX_H_
+
+#include "SimdSupport.h" /* from ExAlignment */
+#include "ThreadPool.h" /* from ExParallelFasta */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Container/SiteContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Identities and p-distances between all pairs of sequences of an alignment.
+   *
+   * The identity of two sequences is the number of sites where they have the same state, divided by the number
+   * of sites where both have a resolved state: sites with a gap or an unresolved state in either sequence are
+   * ignored (pairwise deletion). The p-distance is 1 - identity. Pairs without any comparable site get NaN.
+   *
+   * Sequences are first packed into bit planes: for each block of 64 sites, one word tells which sites have a
+   * resolved state, and B words give the B bits of these states (B = 2 for nucleotides, 5 for proteins).
+   * For a pair of sequences and a block of 64 sites, the comparable sites are then the bits set in both 'resolved' words,
+   * and the identical sites the comparable ones where no bit plane differs: both numbers are popcounts,
+   * so that two sequences are compared 64 sites at a time (256 with AVX2).
+   *
+   * Pairs are processed by tiles of TILE_SIZE x TILE_SIZE sequences, and the sites of a tile by chunks small
+   * enough for the planes of both groups of sequences to stay in cache. Tiles are distributed to the threads with work stealing.
+   */
+  class IdentityMatrix
+  {
+  private:
+    std::vector<std::string> names_;
+    size_t n_;
+    size_t nbSites_;
+    std::vector<uint32_t> compared_;
+    std::vector<uint32_t> identical_;
+    SimdLevel level_;
+
+    /*
+     * Planes are interleaved by groups of GROUP_WORDS words (256 sites): the 'resolved' words of the group come first,
+     * then the words of each bit plane. A chunk of sites holds at most CHUNK_WORDS words of each sequence.
+     */
+    enum { TILE_SIZE = 32, GROUP_WORDS = 4, CHUNK_WORDS = 256 };
+
+  public:
+    /**
+     * @param sites     The alignment.
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     * @param level     The instruction set to use.
+     */
+    IdentityMatrix(const SiteContainer& sites, unsigned int nbThreads = 0, SimdLevel level = SimdSupport::getBestLevel()) :
+      names_(sites.getSequencesNames()),
+      n_(sites.getNumberOfSequences()),
+      nbSites_(n_ > 0 ? sites.getNumberOfSites() : 0),
+      compared_(n_ * n_, 0),
+      identical_(n_ * n_, 0),
+      level_(SimdSupport::getSupportedLevel(level))
+    {
+      unsigned int nbStates = sites.getAlphabet()->getSize();
+      unsigned int nbBits = 1;
+      while ((1U << nbBits) < nbStates)
+        ++nbBits;
+      size_t nbPlanes = nbBits + 1;
+      size_t nbGroups = (nbSites_ + 64 * GROUP_WORDS - 1) / (64 * GROUP_WORDS);
+      size_t stride = nbGroups * nbPlanes * GROUP_WORDS;
+      std::vector<uint64_t> planes(n_ * stride, 0);
+
+      ThreadPool pool(nbThreads);
+      const VectorSequenceContainer* sequences = dynamic_cast<const VectorSequenceContainer*>(&sites);
+      if (sequences)
+      {
+        pool.parallelFor(n_, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+          {
+            const std::vector<int>& content = sequences->getSequence(i).getContent();
+            for (size_t j = 0; j < nbSites_; ++j)
+              pack_(&planes[i * stride], j, content[j], nbStates, nbPlanes);
+          }
+        });
+      }
+      else
+      {
+        //Site objects are requested sequentially, as some containers build them on demand:
+        std::vector<const int*> columns(nbSites_);
+        for (size_t j = 0; j < nbSites_; ++j)
+          columns[j] = &sites.getSite(j).getContent()[0];
+        //Each task fills whole groups of sites, so that tasks never write the same words:
+        pool.parallelFor(nbGroups, [&](size_t firstGroup, size_t lastGroup) {
+          size_t end = std::min(lastGroup * 64 * GROUP_WORDS, nbSites_);
+          for (size_t j = firstGroup * 64 * GROUP_WORDS; j < end; ++j)
+            for (size_t i = 0; i < n_; ++i)
+              pack_(&planes[i * stride], j, columns[j][i], nbStates, nbPlanes);
+        });
+      }
+      compare_(pool, planes, stride, nbGroups, nbPlanes);
+    }
+
+  public:
+    size_t getNumberOfSequences() const { return n_; }
+    size_t getNumberOfSites() const { return nbSites_; }
+    const std::vector<std::string>& getSequencesNames() const { return names_; }
+    SimdLevel getSimdLevel() const { return level_; }
+
+    /**
+     * @return The number of sites where sequences i and j both have a resolved state.
+     */
+    uint32_t getNumberOfComparedSites(size_t i, size_t j) const { return compared_[i * n_ + j]; }
+
+    /**
+     * @return The number of sites where sequences i and j have the same resolved state.
+     */
+    uint32_t getNumberOfIdenticalSites(size_t i, size_t j) const { return identical_[i * n_ + j]; }
+
+    /**
+     * @return The identity of sequences i and j, or NaN if they have no comparable site.
+     */
+    double getIdentity(size_t i, size_t j) const
+    {
+      uint32_t c = compared_[i * n_ + j];
+      return c > 0 ? static_cast<double>(identical_[i * n_ + j]) / static_cast<double>(c) : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    /**
+     * @return The p-distance between sequences i and j, or NaN if they have no comparable site.
+     */
+    double getDistance(size_t i, size_t j) const { return 1. - getIdentity(i, j); }
+
+    /**
+     * @return The dense identity matrix, row-major.
+     */
+    std::vector<double> getIdentities() const
+    {
+      std::vector<double> identities(n_ * n_);
+      for (size_t i = 0; i < n_; ++i)
+        for (size_t j = 0; j < n_; ++j)
+          identities[i * n_ + j] = getIdentity(i, j);
+      return identities;
+    }
+
+    /**
+     * @return The dense p-distance matrix, row-major.
+     */
+    std::vector<double> getDistances() const
+    {
+      std::vector<double> distances(n_ * n_);
+      for (size_t i = 0; i < n_; ++i)
+        for (size_t j = 0; j < n_; ++j)
+          distances[i * n_ + j] = getDistance(i, j);
+      return distances;
+    }
+
+  private:
+    static void pack_(uint64_t* planes, size_t site, int state, unsigned int nbStates, size_t nbPlanes)
+    {
+      if (state < 0 || static_cast<unsigned int>(state) >= nbStates)
+        return;
+      size_t w = site / 64;
+      uint64_t* group = planes + (w / GROUP_WORDS) * nbPlanes * GROUP_WORDS + w % GROUP_WORDS;
+      uint64_t bit = static_cast<uint64_t>(1) << (site % 64);
+      group[0] |= bit;
+      for (size_t p = 1; p < nbPlanes; ++p)
+        if ((static_cast<unsigned int>(state) >> (p - 1)) & 1)
+          group[p * GROUP_WORDS] |= bit;
+    }
+
+    /*
+     * Count the compared and identical sites of two sequences, in groups [0, nbGroups) of their planes.
+     */
+    static void countScalar_(const uint64_t* a, const uint64_t* b, size_t nbGroups, size_t nbPlanes, uint64_t& compared, uint64_t& identical)
+    {
+      for (size_t g = 0; g < nbGroups; ++g, a += nbPlanes * GROUP_WORDS, b += nbPlanes * GROUP_WORDS)
+      {
+        for (size_t k = 0; k < GROUP_WORDS; ++k)
+        {
+          uint64_t valid = a[k] & b[k];
+          uint64_t diff = 0;
+          for (size_t p = 1; p < nbPlanes; ++p)
+            diff |= a[p * GROUP_WORDS + k] ^ b[p * GROUP_WORDS + k];
+          compared += static_cast<uint64_t>(__builtin_popcountll(valid));
+          identical += static_cast<uint64_t>(__builtin_popcountll(valid & ~diff));
+        }
+      }
+    }
+
+#ifdef BPP_SIMD_X86
+    /*
+     * Popcounts of 256 bits words are computed on their bytes, with a lookup table of the counts of 4 bits values
+     * (the count of a byte is the sum of the counts of its two halves), then summed in four 64 bits lanes.
+     */
+    BPP_TARGET_AVX2
+    static inline __m256i popcount256_(__m256i x)
+    {
+      const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                             0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+      const __m256i low = _mm256_set1_epi8(0x0f);
+      __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(x, low)),
+                                       _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(x, 4), low)));
+      return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+    }
+
+    BPP_TARGET_AVX2
+    static void countAvx2_(const uint64_t* a, const uint64_t* b, size_t nbGroups, size_t nbPlanes, uint64_t& compared, uint64_t& identical)
+    {
+      __m256i c = _mm256_setzero_si256();
+      __m256i s = _mm256_setzero_si256();
+      for (size_t g = 0; g < nbGroups; ++g, a += nbPlanes * GROUP_WORDS, b += nbPlanes * GROUP_WORDS)
+      {
+        __m256i valid = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));
+        __m256i diff = _mm256_setzero_si256();
+        for (size_t p = 1; p < nbPlanes; ++p)
+          diff = _mm256_or_si256(diff, _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + p * GROUP_WORDS)),
+                                                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + p * GROUP_WORDS))));
+        c = _mm256_add_epi64(c, popcount256_(valid));
+        s = _mm256_add_epi64(s, popcount256_(_mm256_andnot_si256(diff, valid)));
+      }
+      uint64_t lanes[4];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), c);
+      compared += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), s);
+      identical += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+#endif
+
+    void count_(const uint64_t* a, const uint64_t* b, size_t nbGroups, size_t nbPlanes, uint64_t& compared, uint64_t& identical) const
+    {
+#ifdef BPP_SIMD_X86
+      if (level_ == SIMD_AVX2)
+        return countAvx2_(a, b, nbGroups, nbPlanes, compared, identical);
+#endif
+      countScalar_(a, b, nbGroups, nbPlanes, compared, identical);
+    }
+
+    void compare_(ThreadPool& pool, const std::vector<uint64_t>& planes, size_t stride, size_t nbGroups, size_t nbPlanes)
+    {
+      size_t nbTiles = (n_ + TILE_SIZE - 1) / TILE_SIZE;
+      //Tile pairs (I, J >= I) are numbered row by row. rowStart[I] is the number of the pair (I, I):
+      std::vector<size_t> rowStart(nbTiles + 1, 0);
+      for (size_t t = 0; t < nbTiles; ++t)
+        rowStart[t + 1] = rowStart[t] + (nbTiles - t);
+      size_t groupsPerChunk = std::max(static_cast<size_t>(CHUNK_WORDS) / (nbPlanes * GROUP_WORDS), static_cast<size_t>(1));
+      const uint64_t* data = planes.empty() ? 0 : &planes[0];
+
+      pool.parallelForStealing(rowStart[nbTiles], [&](size_t begin, size_t end, size_t) {
+        std::vector<uint64_t> compared(TILE_SIZE * TILE_SIZE), identical(TILE_SIZE * TILE_SIZE);
+        for (size_t p = begin; p < end; ++p)
+        {
+          size_t ti = static_cast<size_t>(std::upper_bound(rowStart.begin(), rowStart.end(), p) - rowStart.begin()) - 1;
+          size_t tj = ti + (p - rowStart[ti]);
+          size_t i0 = ti * TILE_SIZE, i1 = std::min(i0 + TILE_SIZE, n_);
+          size_t j0 = tj * TILE_SIZE, j1 = std::min(j0 + TILE_SIZE, n_);
+          std::fill(compared.begin(), compared.end(), 0);
+          std::fill(identical.begin(), identical.end(), 0);
+          for (size_t g0 = 0; g0 < nbGroups; g0 += groupsPerChunk)
+          {
+            size_t chunk = std::min(groupsPerChunk, nbGroups - g0);
+            size_t offset = g0 * nbPlanes * GROUP_WORDS;
+            for (size_t i = i0; i < i1; ++i)
+              for (size_t j = (ti == tj ? i : j0); j < j1; ++j)
+              {
+                size_t k = (i - i0) * TILE_SIZE + (j - j0);
+                count_(data + i * stride + offset, data + j * stride + offset, chunk, nbPlanes, compared[k], identical[k]);
+              }
+          }
+          for (size_t i = i0; i < i1; ++i)
+            for (size_t j = (ti == tj ? i : j0); j < j1; ++j)
+            {
+              size_t k = (i - i0) * TILE_SIZE + (j - j0);
+              compared_[i * n_ + j] = compared_[j * n_ + i] = static_cast<uint32_t>(compared[k]);
+              identical_[i * n_ + j] = identical_[j * n_ + i] = static_cast<uint32_t>(identical[k]);
+            }
+        }
+      });
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_IDENTITYMATRIX_H_
@@ -0,0 +1,341 @@
+/*
+ * File: MultipleAlignmentScore.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 05:50 2026
+ *
+ * Sum-of-pairs scores and consensus of a multiple alignment, computed from the state counts of its sites.
+ */
+
+#ifndef _MULTIPLEALIGNMENTSCORE_H_
+#define _MULTIPLEALIGNMENTSCORE_H_
+
+#include "ThreadPool.h" /* from ExParallelFasta */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/AlphabetIndex/AlphabetIndex2.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Container/SiteContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Sum-of-pairs scores and consensus of all the sites of a multiple alignment.
+   *
+   * The sum-of-pairs score of a site is the sum, over all pairs of sequences, of the score of their two states:
+   * - two residues (including unresolved states) are scored with a symmetric AlphabetIndex2, for instance DefaultNucleotideScore,
+   * - a residue and a gap score 'gap',
+   * - two gaps score 0.
+   * The score of the alignment is the sum of the scores of its sites.
+   *
+   * Scores are not computed pair by pair: the states of each site are counted first, and if state x occurs c_x times,
+   * the score of the site is sum_{x < y} c_x c_y s(x, y) + sum_x c_x (c_x - 1) / 2 s(x, x) + R G gap,
+   * with R residues and G gaps. This costs O(n) per site for the counts, plus the square of the number of
+   * distinct states, instead of O(n^2).
+   *
+   * The counts are computed as in SiteStatistics: by blocks of consecutive sites from the sequences of an
+   * AlignedSequenceContainer (or any alignment derived from VectorSequenceContainer), or site by site from other containers.
+   * Blocks of sites are processed in parallel. The counts are kept, and the consensus is computed from them on demand.
+   */
+  class MultipleAlignmentScore
+  {
+  private:
+    const Alphabet* alphabet_;
+    size_t nbSequences_;
+    size_t nbSites_;
+    size_t nbCodes_;
+    size_t nbSlots_;
+    std::vector<uint32_t> counts_;
+    std::vector<double> matrix_;
+    double gap_;
+    std::vector<double> scores_;
+    double score_;
+
+    enum { BLOCK_SIZE = 256 };
+
+  public:
+    /**
+     * @param sites     The alignment.
+     * @param index     The scores of pairs of residues.
+     * @param gap       The score of a residue aligned with a gap.
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     * @throw AlphabetMismatchException If the alignment and the index do not share the same alphabet.
+     * @throw BadIntException If the alignment contains a state which is not supported by the index.
+     */
+    MultipleAlignmentScore(const SiteContainer& sites, const AlphabetIndex2& index, double gap, unsigned int nbThreads = 0) :
+      alphabet_(sites.getAlphabet()),
+      nbSequences_(sites.getNumberOfSequences()),
+      nbSites_(sites.getNumberOfSequences() > 0 ? sites.getNumberOfSites() : 0),
+      nbCodes_(0), nbSlots_(0), counts_(), matrix_(), gap_(gap), scores_(), score_(0.)
+    {
+      if (alphabet_->getAlphabetType() != index.getAlphabet()->getAlphabetType())
+        throw AlphabetMismatchException("MultipleAlignmentScore. Alignment and index do not match.", alphabet_, index.getAlphabet());
+      std::vector<int> codes = alphabet_->getSupportedInts();
+      int maxCode = 0;
+      for (size_t i = 0; i < codes.size(); ++i)
+        maxCode = std::max(maxCode, codes[i]);
+      nbCodes_ = static_cast<size_t>(maxCode) + 1;
+      nbSlots_ = nbCodes_ + 1;
+      fillMatrix_(index, codes);
+
+      counts_.assign(nbSites_ * nbSlots_, 0);
+      scores_.assign(nbSites_, 0.);
+      ThreadPool pool(nbSequences_ * nbSites_ < 1000000 ? 1 : nbThreads);
+      const VectorSequenceContainer* sequences = dynamic_cast<const VectorSequenceContainer*>(&sites);
+      if (sequences)
+      {
+        std::vector<const int*> rows(nbSequences_);
+        for (size_t i = 0; i < nbSequences_; ++i)
+          rows[i] = (nbSites_ > 0 ? &sequences->getSequence(i).getContent()[0] : 0);
+        countRows_(pool, rows);
+      }
+      else
+      {
+        //Site objects are requested sequentially, as some containers build them on demand:
+        std::vector<const int*> columns(nbSites_);
+        for (size_t j = 0; j < nbSites_; ++j)
+          columns[j] = &sites.getSite(j).getContent()[0];
+        countColumns_(pool, columns);
+      }
+      computeScores_(pool);
+    }
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t getNumberOfSequences() const { return nbSequences_; }
+    size_t getNumberOfSites() const { return nbSites_; }
+
+    /**
+     * @return The sum-of-pairs score of the alignment.
+     */
+    double getScore() const { return score_; }
+
+    /**
+     * @return The sum-of-pairs score of a site.
+     */
+    double getSiteScore(size_t siteIndex) const { return scores_[siteIndex]; }
+
+    /**
+     * @return The sum-of-pairs scores of all sites.
+     */
+    const std::vector<double>& getSiteScores() const { return scores_; }
+
+    /**
+     * @return The number of occurrences of a state (the gap included) at a site.
+     */
+    uint32_t getCount(size_t siteIndex, int state) const
+    {
+      size_t slot = static_cast<size_t>(state + 1);
+      return slot < nbSlots_ ? counts_[siteIndex * nbSlots_ + slot] : 0;
+    }
+
+    /**
+     * @brief Compute the consensus of the alignment.
+     *
+     * At each site, resolved states are weighted by their counts. An ambiguous state adds to each of the states it stands for,
+     * with a weight of 1 / (number of these states), and states which stand for all resolved states (as N) are ignored.
+     * States are then taken by decreasing weight, until their total weight reaches 'threshold' times the total weight of the site,
+     * and the consensus is the state standing for all of them: for nucleotides and proteins, an IUPAC ambiguity code.
+     * With a threshold of 1, all observed states are kept. With a very low threshold, only the most frequent state is kept.
+     *
+     * @param threshold      The fraction of the weight of a site which must be covered by its consensus, in ]0, 1].
+     * @param maxGapFraction Sites with more gaps than this fraction have a gap in the consensus.
+     * @param name           The name of the consensus sequence.
+     * @return A new sequence, with one state per site. Sites with neither gaps nor informative states get the unknown state.
+     * @throw Exception If the threshold is not in ]0, 1].
+     */
+    Sequence* getConsensus(double threshold = 1., double maxGapFraction = 0.5, const std::string& name = "consensus") const
+    {
+      if (!(threshold > 0. && threshold <= 1.))
+        throw Exception("MultipleAlignmentScore::getConsensus. Threshold must be in ]0, 1].");
+      size_t nbStates = alphabet_->getSize();
+      //The resolved states each code stands for:
+      std::vector< std::vector<int> > aliases(nbCodes_);
+      for (size_t c = 0; c < nbCodes_; ++c)
+      {
+        int code = static_cast<int>(c);
+        if (!alphabet_->isIntInAlphabet(code) || alphabet_->isGap(code))
+          continue;
+        std::vector<int> alias = alphabet_->getAlias(code);
+        if (alias.size() < nbStates)
+          aliases[c] = alias;
+      }
+      std::vector<int> consensus(nbSites_);
+      std::vector<double> weights(nbStates);
+      std::vector< std::pair<double, int> > ranked;
+      std::vector<int> kept;
+      double n = static_cast<double>(nbSequences_);
+      for (size_t j = 0; j < nbSites_; ++j)
+      {
+        const uint32_t* c = &counts_[j * nbSlots_];
+        if (static_cast<double>(c[0]) > maxGapFraction * n)
+        {
+          consensus[j] = alphabet_->getGapCharacterCode();
+          continue;
+        }
+        std::fill(weights.begin(), weights.end(), 0.);
+        double total = 0.;
+        for (size_t code = 0; code < nbCodes_; ++code)
+        {
+          const std::vector<int>& alias = aliases[code];
+          if (c[code + 1] == 0 || alias.empty())
+            continue;
+          double w = static_cast<double>(c[code + 1]) / static_cast<double>(alias.size());
+          for (size_t a = 0; a < alias.size(); ++a)
+            weights[static_cast<size_t>(alias[a])] += w;
+          total += static_cast<double>(c[code + 1]);
+        }
+        if (total == 0.)
+        {
+          consensus[j] = alphabet_->getUnknownCharacterCode();
+          continue;
+        }
+        ranked.clear();
+        for (size_t s = 0; s < nbStates; ++s)
+          if (weights[s] > 0.)
+            ranked.push_back(std::make_pair(-weights[s], static_cast<int>(s)));
+        std::sort(ranked.begin(), ranked.end());
+        kept.clear();
+        double covered = 0.;
+        //A small tolerance, so that rounding errors do not add a state when the threshold is exactly reached:
+        for (size_t k = 0; k < ranked.size() && covered < threshold * total * (1. - 1e-12); ++k)
+        {
+          kept.push_back(ranked[k].second);
+          covered -= ranked[k].first;
+        }
+        std::sort(kept.begin(), kept.end());
+        consensus[j] = (kept.size() == 1 ? kept[0] : alphabet_->getGeneric(kept));
+      }
+      return new BasicSequence(name, consensus, alphabet_);
+    }
+
+  private:
+    /*
+     * Scores of all pairs of non-gap codes. Pairs for which the index throws an exception are set to NaN,
+     * and are only rejected if they occur in the alignment.
+     */
+    void fillMatrix_(const AlphabetIndex2& index, const std::vector<int>& codes)
+    {
+      matrix_.assign(nbCodes_ * nbCodes_, std::numeric_limits<double>::quiet_NaN());
+      for (size_t a = 0; a < codes.size(); ++a)
+      {
+        if (codes[a] < 0 || alphabet_->isGap(codes[a]))
+          continue;
+        for (size_t b = 0; b < codes.size(); ++b)
+        {
+          if (codes[b] < 0 || alphabet_->isGap(codes[b]))
+            continue;
+          try
+          {
+            matrix_[static_cast<size_t>(codes[a]) * nbCodes_ + static_cast<size_t>(codes[b])] = index.getIndex(codes[a], codes[b]);
+          }
+          catch (Exception& e)
+          {
+          }
+        }
+      }
+    }
+
+    /*
+     * Counters are stored by code: counters[(x + 1) * stride + b] counts the occurrences of code x at position b of a block,
+     * the gap (-1) being in slot 0.
+     */
+    void countRows_(ThreadPool& pool, const std::vector<const int*>& rows)
+    {
+      size_t nbBlocks = (nbSites_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+      pool.parallelFor(nbBlocks, [&](size_t firstBlock, size_t lastBlock) {
+        size_t blockSize = BLOCK_SIZE;
+        std::vector<uint32_t> counters(nbSlots_ * blockSize);
+        for (size_t block = firstBlock; block < lastBlock; ++block)
+        {
+          size_t j0 = block * blockSize;
+          size_t width = std::min(blockSize, nbSites_ - j0);
+          std::fill(counters.begin(), counters.end(), 0);
+          for (size_t i = 0; i < nbSequences_; ++i)
+          {
+            const int* states = rows[i] + j0;
+            for (size_t b = 0; b < width; ++b)
+              counters[static_cast<size_t>(states[b] + 1) * blockSize + b]++;
+          }
+          for (size_t b = 0; b < width; ++b)
+            for (size_t s = 0; s < nbSlots_; ++s)
+              counts_[(j0 + b) * nbSlots_ + s] = counters[s * blockSize + b];
+        }
+      });
+    }
+
+    void countColumns_(ThreadPool& pool, const std::vector<const int*>& columns)
+    {
+      pool.parallelFor(nbSites_, [&](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; ++j)
+        {
+          uint32_t* c = &counts_[j * nbSlots_];
+          const int* states = columns[j];
+          for (size_t i = 0; i < nbSequences_; ++i)
+            c[static_cast<size_t>(states[i] + 1)]++;
+        }
+      }, 64);
+    }
+
+    void computeScores_(ThreadPool& pool)
+    {
+      std::vector<size_t> unsupported(nbSites_, nbCodes_);
+      pool.parallelFor(nbSites_, [&](size_t begin, size_t end) {
+        std::vector<size_t> present;
+        for (size_t j = begin; j < end; ++j)
+        {
+          uint32_t gaps = counts_[j * nbSlots_];
+          const uint32_t* c = &counts_[j * nbSlots_ + 1];
+          present.clear();
+          double residues = 0.;
+          for (size_t x = 0; x < nbCodes_; ++x)
+          {
+            if (c[x] > 0)
+            {
+              present.push_back(x);
+              residues += static_cast<double>(c[x]);
+            }
+          }
+          double s = residues * static_cast<double>(gaps) * gap_;
+          for (size_t k = 0; k < present.size() && unsupported[j] == nbCodes_; ++k)
+          {
+            size_t x = present[k];
+            double cx = static_cast<double>(c[x]);
+            for (size_t l = k; l < present.size(); ++l)
+            {
+              size_t y = present[l];
+              double sxy = matrix_[x * nbCodes_ + y];
+              if (std::isnan(sxy))
+              {
+                unsupported[j] = (std::isnan(matrix_[x * nbCodes_ + x]) ? x : y);
+                break;
+              }
+              s += (l == k ? cx * (cx - 1.) / 2. : cx * static_cast<double>(c[y])) * sxy;
+            }
+          }
+          scores_[j] = s;
+        }
+      }, 1024);
+      for (size_t j = 0; j < nbSites_; ++j)
+      {
+        if (unsupported[j] < nbCodes_)
+          throw BadIntException(static_cast<int>(unsupported[j]), "MultipleAlignmentScore. State not supported by the index, at site " + TextTools::toString(j + 1), alphabet_);
+        score_ += scores_[j];
+      }
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_MULTIPLEALIGNMENTSCORE_H_
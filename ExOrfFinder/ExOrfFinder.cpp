@@ -0,0 +1,218 @@
+/*
+ * File: ExOrfFinder.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 22:05 2026
+ *
+ * Finding open reading frames in the six frames of whole genomes.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <fstream> /* to write the simulated genome and the proteins. */
+#include <random> /* to simulate a genome. */
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Alphabet/CodonAlphabet.h>
+#include <Bpp/Seq/GeneticCode/StandardGeneticCode.h>
+#include <Bpp/Seq/NucleicAcidsReplication.h>
+#include <Bpp/Seq/Sequence.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+#include <Bpp/Text/TextTools.h>
+
+/*
+ * And the ORF finder, in this directory:
+ */
+#include "OrfFinder.h"
+#include "Instrumentation.h" /* from ExBenchmark */
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * The classical way to find ORFs, as in ExSequence and ExGeneticCode:
+ * the reverse strand is built with a transliterator, each frame is recoded with a codon alphabet,
+ * and codons are tested one by one. We only count ORFs here, to check the results of the OrfFinder.
+ */
+size_t countOrfs(const Sequence& sequence, const GeneticCode& gc, size_t minimumLength)
+{
+  const CodonAlphabet* ca = dynamic_cast<const CodonAlphabet*>(gc.getSourceAlphabet());
+  NucleicAcidsReplication replication(sequence.getAlphabet(), sequence.getAlphabet());
+  Sequence* complement = replication.translate(sequence);
+  string reverse = complement->toString();
+  std::reverse(reverse.begin(), reverse.end());
+  delete complement;
+  string strands[2] = { sequence.toString(), reverse };
+
+  size_t nbOrfs = 0;
+  for (size_t s = 0; s < 2; s++)
+  {
+    for (size_t offset = 0; offset < 3; offset++)
+    {
+      size_t length = (strands[s].size() - offset) / 3 * 3;
+      Sequence* codons = new BasicSequence("frame", strands[s].substr(offset, length), ca);
+      bool inOrf = false;
+      size_t first = 0;
+      for (size_t k = 0; k < codons->size(); k++)
+      {
+        int codon = codons->getValue(k);
+        if (!inOrf && gc.isStart(codon))
+        {
+          inOrf = true;
+          first = k;
+        }
+        if (gc.isStop(codon))
+        {
+          if (inOrf && k - first >= minimumLength)
+            nbOrfs++;
+          inOrf = false;
+        }
+      }
+      delete codons;
+    }
+  }
+  return nbOrfs;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    StandardGeneticCode gc(&AlphabetTools::DNA_ALPHABET);
+
+    /*
+     * An OrfFinder is created with a genetic code, a minimum ORF length (in amino acids),
+     * and a number of threads (0 means all available cores):
+     */
+    OrfFinder finder(gc, 3);
+    BasicSequence sequence("My first sequence", "CCATGGATTACAATGATTACATGGTTAGGCCTAACCATCCAT", &AlphabetTools::DNA_ALPHABET);
+    vector<Orf> orfs;
+    finder.findOrfs(sequence, orfs);
+    for (size_t i = 0; i < orfs.size(); i++)
+    {
+      Sequence* protein = finder.getProtein(orfs[i]);
+      cout << protein->getName() << ": " << protein->toString() << endl;
+      delete protein;
+    }
+    cout << "Same number of ORFs as codon by codon? " << (orfs.size() == countOrfs(sequence, gc, 3) ? "yes" : "no") << endl;
+
+    /*
+     * Let's simulate a small genome with a few chromosomes, and save it to a Fasta file.
+     */
+    string genomeFile = "genome.fasta";
+    size_t nbChromosomes = 8;
+    size_t chromosomeLength = 2000000; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
+    const char* nucleotides = "ACGT";
+    mt19937 rng(42);
+    uniform_int_distribution<int> nucleotide(0, 3);
+    ofstream genome(genomeFile.c_str());
+    string line(60, 'A');
+    for (size_t c = 0; c < nbChromosomes; c++)
+    {
+      genome << ">chr" << (c + 1) << endl;
+      for (size_t i = 0; i < chromosomeLength; i += line.size())
+      {
+        line.resize(min(static_cast<size_t>(60), chromosomeLength - i));
+        for (size_t j = 0; j < line.size(); j++)
+          line[j] = nucleotides[nucleotide(rng)];
+        genome << line << endl;
+      }
+    }
+    genome.close();
+
+    /*
+     * ORFs are found while reading the file. Only a batch of records is encoded at a time,
+     * and ORFs are passed to a function as soon as they are found, here to write the proteins.
+     * Let's only keep ORFs of at least 100 amino acids:
+     */
+    finder.setMinimumLength(100);
+    finder.setBatchLength(4000000);
+    ofstream proteins("orfs.fasta");
+    const Alphabet* protein = gc.getTargetAlphabet();
+    size_t longest = 0;
+    ApplicationTools::startTimer();
+    size_t nbOrfs = finder.findOrfs(genomeFile, &AlphabetTools::DNA_ALPHABET, [&](const Orf& orf) {
+      proteins << ">" << orf.sequenceName << "_frame" << (orf.frame > 0 ? "+" : "") << orf.frame << "_" << (orf.begin + 1) << "-" << orf.end << endl;
+      for (size_t k = 0; k < orf.protein.size(); k++)
+        proteins << protein->intToChar(orf.protein[k]);
+      proteins << endl;
+      longest = max(longest, orf.getLength());
+    });
+    ApplicationTools::displayTime("Time used to find ORFs in the genome:");
+    proteins.close();
+    cout << nbOrfs << " ORFs found, the longest one has " << longest << " amino acids." << endl;
+
+    /*
+     * The work is shared by chromosomes and frames. Let's see how it scales with the number of threads,
+     * without storing the proteins this time:
+     */
+    finder.storeProteins(false);
+    for (unsigned int nbThreads = 1; nbThreads <= 8; nbThreads *= 2)
+    {
+      finder.setNumberOfThreads(nbThreads);
+      ApplicationTools::startTimer();
+      finder.findOrfs(genomeFile, &AlphabetTools::DNA_ALPHABET, [](const Orf&) {});
+      ApplicationTools::displayTime("Time used with " + TextTools::toString(nbThreads) + " thread(s):");
+    }
+
+    /*
+     * How much of this time is translation, and how much is reading the file?
+     * Build with 'make INSTRUMENTATION=1' to get the answer:
+     */
+    Instrumentation::display();
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,370 @@
+/*
+ * File: OrfFinder.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 22:05 2026
+ *
+ * Detection of open reading frames in the six frames of nucleotide sequences.
+ */
+
+#ifndef _ORFFINDER_H_
+#define _ORFFINDER_H_
+
+#include "CompiledGeneticCode.h" /* from ExGeneticCode */
+#include "MappedFasta.h" /* from ExContainer */
+#include "ThreadPool.h" /* from ExParallelFasta */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Text/TextTools.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief An open reading frame.
+   *
+   * Coordinates are 0-based, half-open, and always given on the forward strand:
+   * an ORF in a reverse frame covers [begin, end) of the input sequence, and is read from end - 1 to begin.
+   * The stop codon, if any, is included in the coordinates, but not in the protein.
+   */
+  struct Orf
+  {
+    size_t sequenceIndex;
+    std::string sequenceName;
+    int frame;
+    size_t begin;
+    size_t end;
+    bool hasStop;
+    std::vector<int> protein;
+
+    Orf() : sequenceIndex(0), sequenceName(), frame(1), begin(0), end(0), hasStop(false), protein() {}
+
+    /**
+     * @return The number of amino acids of the ORF, without the stop codon.
+     */
+    size_t getLength() const { return (end - begin) / 3 - (hasStop ? 1 : 0); }
+  };
+
+  /**
+   * @brief Find the open reading frames of nucleotide sequences, in six frames.
+   *
+   * An ORF starts at the first start codon following a stop codon (or the beginning of the frame),
+   * and ends at the next stop codon. Start codons inside an ORF are hence ignored, and only
+   * the longest ORF is reported. ORFs which reach the end of the frame without a stop codon
+   * are reported only if requested.
+   *
+   * Frames are translated with a CompiledGeneticCode, so that neither the reverse complement
+   * nor any codon sequence is built. Sequences, and the six frames of each sequence, are processed
+   * in parallel. Files are read with MappedFasta: only a bounded batch of records is encoded at a time,
+   * and ORFs are passed to a callback in the file order, so that whole genomes are never held in memory.
+   */
+  class OrfFinder
+  {
+  private:
+    CompiledGeneticCode code_;
+    size_t minimumLength_;
+    bool useAltStarts_;
+    bool reportIncomplete_;
+    bool storeProteins_;
+    unsigned int nbThreads_;
+    size_t batchLength_;
+
+  public:
+    /**
+     * @param geneticCode   The genetic code to use. It must remain valid as long as this object is used.
+     * @param minimumLength The minimum number of amino acids of an ORF, without the stop codon.
+     * @param nbThreads     The number of threads to use. 0 means as many as hardware threads.
+     */
+    OrfFinder(const GeneticCode& geneticCode, size_t minimumLength = 100, unsigned int nbThreads = 0) :
+      code_(geneticCode),
+      minimumLength_(minimumLength),
+      useAltStarts_(false),
+      reportIncomplete_(false),
+      storeProteins_(true),
+      nbThreads_(nbThreads),
+      batchLength_(16000000)
+    {}
+
+  public:
+    const CompiledGeneticCode& getCompiledGeneticCode() const { return code_; }
+
+    size_t getMinimumLength() const { return minimumLength_; }
+    void setMinimumLength(size_t minimumLength) { minimumLength_ = minimumLength; }
+
+    /**
+     * @brief Whether alternative start codons can start an ORF. Default is false.
+     */
+    bool useAltStarts() const { return useAltStarts_; }
+    void useAltStarts(bool yn) { useAltStarts_ = yn; }
+
+    /**
+     * @brief Whether ORFs which reach the end of the sequence without a stop codon are reported. Default is false.
+     */
+    bool reportIncomplete() const { return reportIncomplete_; }
+    void reportIncomplete(bool yn) { reportIncomplete_ = yn; }
+
+    /**
+     * @brief Whether the protein sequence of each ORF is stored. Default is true.
+     */
+    bool storeProteins() const { return storeProteins_; }
+    void storeProteins(bool yn) { storeProteins_ = yn; }
+
+    unsigned int getNumberOfThreads() const { return nbThreads_; }
+    void setNumberOfThreads(unsigned int nbThreads) { nbThreads_ = nbThreads; }
+
+    /**
+     * @brief The number of nucleotides encoded at a time when reading a file. Default is 16 million.
+     *
+     * A record longer than this is still encoded at once, alone in its batch.
+     */
+    size_t getBatchLength() const { return batchLength_; }
+    void setBatchLength(size_t batchLength) { batchLength_ = batchLength > 0 ? batchLength : 1; }
+
+    /**
+     * @brief Find the ORFs of a buffer of nucleotide states, in one frame.
+     *
+     * @param states        The nucleotide states.
+     * @param n             The number of states.
+     * @param frame         The frame: 1, 2, 3, -1, -2 or -3.
+     * @param sequenceIndex The index of the sequence, stored in the ORFs.
+     * @param sequenceName  The name of the sequence, stored in the ORFs.
+     * @param orfs          [out] The vector where to append the ORFs found.
+     * @param protein       A buffer for the translated frame.
+     * @param flags         A buffer for the flags of the codons.
+     */
+    void findOrfs(const int* states, size_t n, int frame, size_t sequenceIndex, const std::string& sequenceName,
+        std::vector<Orf>& orfs, std::vector<int>& protein, std::vector<uint8_t>& flags) const
+    {
+      size_t nbCodons = CompiledGeneticCode::getNumberOfCodons(n, frame);
+      protein.resize(nbCodons);
+      flags.resize(nbCodons);
+      if (nbCodons == 0)
+        return;
+      code_.translateFrame(states, n, frame, &protein[0], &flags[0]);
+      uint8_t startMask = static_cast<uint8_t>(CompiledGeneticCode::FLAG_START | (useAltStarts_ ? CompiledGeneticCode::FLAG_ALT_START : 0));
+      bool inOrf = false;
+      size_t first = 0;
+      for (size_t k = 0; k < nbCodons; ++k)
+      {
+        uint8_t f = flags[k];
+        if (!inOrf && (f & startMask))
+        {
+          inOrf = true;
+          first = k;
+        }
+        if (f & CompiledGeneticCode::FLAG_STOP)
+        {
+          if (inOrf && k - first >= minimumLength_)
+            addOrf_(n, frame, sequenceIndex, sequenceName, protein, first, k + 1, true, orfs);
+          inOrf = false;
+        }
+      }
+      if (inOrf && reportIncomplete_ && nbCodons - first >= minimumLength_)
+        addOrf_(n, frame, sequenceIndex, sequenceName, protein, first, nbCodons, false, orfs);
+    }
+
+    /**
+     * @brief Find the ORFs of a nucleotide sequence, in six frames, on the calling thread.
+     *
+     * @param sequence      The sequence.
+     * @param orfs          [out] The vector where to append the ORFs found, frame by frame (1, 2, 3, -1, -2, -3).
+     * @param sequenceIndex The index of the sequence, stored in the ORFs.
+     * @throw AlphabetException If the sequence is not a nucleotide sequence.
+     */
+    void findOrfs(const Sequence& sequence, std::vector<Orf>& orfs, size_t sequenceIndex = 0) const
+    {
+      checkAlphabet_(sequence.getAlphabet());
+      const std::vector<int>& content = sequence.getContent();
+      std::vector<int> protein;
+      std::vector<uint8_t> flags;
+      for (size_t f = 0; f < 6; ++f)
+        findOrfs(content.empty() ? 0 : &content[0], content.size(), getFrame(f), sequenceIndex, sequence.getName(), orfs, protein, flags);
+    }
+
+    /**
+     * @brief Find the ORFs of all sequences of a container, in parallel.
+     *
+     * @param sequences The nucleotide sequences.
+     * @return The ORFs, sequence by sequence and frame by frame.
+     * @throw AlphabetException If the sequences are not nucleotide sequences.
+     */
+    std::vector<Orf> findOrfs(const OrderedSequenceContainer& sequences) const
+    {
+      checkAlphabet_(sequences.getAlphabet());
+      size_t nbSeq = sequences.getNumberOfSequences();
+      //Sequences are only accessed here: some containers (as VectorSiteContainer) rebuild them on each call to getSequence.
+      std::vector<const std::vector<int>*> contents(nbSeq);
+      std::vector<std::string> names(nbSeq);
+      for (size_t i = 0; i < nbSeq; ++i)
+      {
+        const Sequence& sequence = sequences.getSequence(i);
+        contents[i] = &sequence.getContent();
+        names[i] = sequence.getName();
+      }
+      std::vector< std::vector<Orf> > results(nbSeq * 6);
+      ThreadPool pool(nbThreads_);
+      pool.parallelFor(nbSeq * 6, [&](size_t begin, size_t end) {
+        std::vector<int> protein;
+        std::vector<uint8_t> flags;
+        for (size_t t = begin; t < end; ++t)
+        {
+          const std::vector<int>& content = *contents[t / 6];
+          findOrfs(content.empty() ? 0 : &content[0], content.size(), getFrame(t % 6), t / 6, names[t / 6], results[t], protein, flags);
+        }
+      });
+      return merge_(results);
+    }
+
+    /**
+     * @brief Find the ORFs of all sequences of a Fasta file, batch by batch.
+     *
+     * Records are encoded in parallel, a batch of about getBatchLength() nucleotides at a time,
+     * then the six frames of each record are scanned in parallel.
+     *
+     * @param path     The Fasta file to read.
+     * @param alphabet The nucleotide alphabet to use.
+     * @param callback A function called as callback(orf) for each ORF, on the calling thread,
+     * in the order of the file, and frame by frame within each sequence.
+     * @return The number of ORFs found.
+     * @throw AlphabetException If the alphabet is not a nucleotide alphabet.
+     * @throw BadCharException If a character is not in the alphabet.
+     */
+    template<class F>
+    size_t findOrfs(const std::string& path, const Alphabet* alphabet, F callback) const
+    {
+      checkAlphabet_(alphabet);
+      MappedFasta fasta(path);
+      CharacterTable table(alphabet);
+      ThreadPool pool(nbThreads_);
+      size_t nbSeq = fasta.getNumberOfSequences();
+      size_t nbOrfs = 0;
+      std::vector< std::vector<int> > contents;
+      std::vector<std::string> names;
+      std::vector< std::vector<Orf> > results;
+      size_t first = 0;
+      while (first < nbSeq)
+      {
+        //The batch is closed when its raw size reaches the budget:
+        size_t last = first;
+        size_t length = 0;
+        while (last < nbSeq && (last == first || length < batchLength_))
+          length += fasta.getRawLength(last++);
+        size_t batchSize = last - first;
+
+        contents.resize(batchSize);
+        names.resize(batchSize);
+        pool.parallelFor(batchSize, [&](size_t begin, size_t end) {
+          for (size_t i = begin; i < end; ++i)
+          {
+            names[i] = fasta.getName(first + i);
+            fasta.encode(first + i, table, contents[i]);
+          }
+        }, 1);
+
+        results.assign(batchSize * 6, std::vector<Orf>());
+        pool.parallelFor(batchSize * 6, [&](size_t begin, size_t end) {
+          std::vector<int> protein;
+          std::vector<uint8_t> flags;
+          for (size_t t = begin; t < end; ++t)
+          {
+            const std::vector<int>& content = contents[t / 6];
+            findOrfs(content.empty() ? 0 : &content[0], content.size(), getFrame(t % 6), first + t / 6, names[t / 6], results[t], protein, flags);
+          }
+        }, 1);
+
+        for (size_t t = 0; t < results.size(); ++t)
+        {
+          for (size_t k = 0; k < results[t].size(); ++k)
+            callback(results[t][k]);
+          nbOrfs += results[t].size();
+        }
+        first = last;
+      }
+      return nbOrfs;
+    }
+
+    /**
+     * @return The protein sequence of an ORF, named after the sequence, the frame and the coordinates (1-based, inclusive).
+     * @throw Exception If the protein was not stored.
+     */
+    Sequence* getProtein(const Orf& orf) const
+    {
+      if (orf.protein.size() != orf.getLength())
+        throw Exception("OrfFinder::getProtein. The protein sequence of the ORF was not stored.");
+      std::string name = orf.sequenceName + "_frame" + (orf.frame > 0 ? "+" : "-") + TextTools::toString(orf.frame > 0 ? orf.frame : -orf.frame)
+        + "_" + TextTools::toString(orf.begin + 1) + "-" + TextTools::toString(orf.end);
+      return new BasicSequence(name, orf.protein, code_.getTargetAlphabet());
+    }
+
+    /**
+     * @return The frame with index f in [0, 6): 1, 2, 3, -1, -2, -3.
+     */
+    static int getFrame(size_t f)
+    {
+      return f < 3 ? static_cast<int>(f) + 1 : 2 - static_cast<int>(f);
+    }
+
+  private:
+    static void checkAlphabet_(const Alphabet* alphabet)
+    {
+      if (!AlphabetTools::isNucleicAlphabet(alphabet))
+        throw AlphabetException("OrfFinder. Only nucleotide sequences can be scanned.", alphabet);
+    }
+
+    /*
+     * Add the ORF made of codons [first, last) of a frame.
+     */
+    void addOrf_(size_t n, int frame, size_t sequenceIndex, const std::string& sequenceName,
+        const std::vector<int>& protein, size_t first, size_t last, bool hasStop, std::vector<Orf>& orfs) const
+    {
+      orfs.push_back(Orf());
+      Orf& orf = orfs.back();
+      orf.sequenceIndex = sequenceIndex;
+      orf.sequenceName = sequenceName;
+      orf.frame = frame;
+      orf.hasStop = hasStop;
+      if (frame > 0)
+      {
+        orf.begin = static_cast<size_t>(frame - 1) + 3 * first;
+        orf.end = static_cast<size_t>(frame - 1) + 3 * last;
+      }
+      else
+      {
+        //Codon k of frame -f covers [n - f - 3k - 2, n - f - 3k + 1):
+        size_t offset = n - static_cast<size_t>(-frame) + 1;
+        orf.begin = offset - 3 * last;
+        orf.end = offset - 3 * first;
+      }
+      if (storeProteins_)
+        orf.protein.assign(protein.begin() + static_cast<std::ptrdiff_t>(first),
+            protein.begin() + static_cast<std::ptrdiff_t>(hasStop ? last - 1 : last));
+    }
+
+    static std::vector<Orf> merge_(std::vector< std::vector<Orf> >& results)
+    {
+      size_t total = 0;
+      for (size_t t = 0; t < results.size(); ++t)
+        total += results[t].size();
+      std::vector<Orf> orfs;
+      orfs.reserve(total);
+      for (size_t t = 0; t < results.size(); ++t)
+      {
+        for (size_t k = 0; k < results[t].size(); ++k)
+        {
+          orfs.push_back(Orf());
+          std::swap(orfs.back(), results[t][k]);
+        }
+      }
+      return orfs;
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_ORFFINDER_H_
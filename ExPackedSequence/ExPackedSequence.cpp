@@ -0,0 +1,181 @@
+/*
+ * File: ExPackedSequence.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 12:15 2026
+ *
+ * Storing nucleotide sequences and alignments with 2 or 4 bits per position.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * And the packed storage, in this directory:
+ */
+#include "PackedSequence.h"
+#include "Instrumentation.h" /* from ExBenchmark */
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * As we saw in ExSequence, every position of a sequence is stored as an int code,
+     * that is 4 bytes, while there are only 4 nucleotides...
+     * A PackedSequence stores the same information with 2 bits per position,
+     * or 4 bits if the sequence contains gaps or ambiguity codes:
+     */
+    BasicSequence sequence("My first sequence", "GATTACAATGATTACATGGT", &AlphabetTools::DNA_ALPHABET);
+    PackedSequence packed(sequence);
+    cout << packed.getName() << ": " << packed.toString() << " (" << packed.getNumberOfBitsPerState() << " bits per position)" << endl;
+
+    BasicSequence gapped("My second sequence", "GATTAC--TGANTACATGGT", &AlphabetTools::DNA_ALPHABET);
+    PackedSequence packedGapped(gapped);
+    cout << packedGapped.getName() << ": " << packedGapped.toString() << " (" << packedGapped.getNumberOfBitsPerState() << " bits per position)" << endl;
+
+    /*
+     * Positions are accessed as with a Sequence object, and the int codes are unchanged:
+     */
+    for (size_t i = 0; i < 8; i++)
+    {
+      cout << packedGapped.getChar(i) << "\t" << packedGapped.getValue(i) << "\t" << gapped.getValue(i) << endl;
+    }
+
+    /*
+     * A packed sequence is read-only. To modify it, you first need to unpack it:
+     */
+    Sequence* unpacked = packedGapped.toSequence();
+    cout << "Unpacked: " << unpacked->toString() << endl;
+    delete unpacked;
+
+    /*
+     * Alignments can also be packed. A PackedAlignment stores the data per site, as the VectorSiteContainer:
+     */
+    Fasta fasReader;
+    OrderedSequenceContainer* sequences = fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    PackedAlignment packedSites(*sequences);
+    SiteContainer* sites = new VectorSiteContainer(*sequences);
+    SiteContainer* align = new AlignedSequenceContainer(*sequences);
+    cout << "This alignment has " << packedSites.getNumberOfSequences() << " sequences and " << packedSites.getNumberOfSites() << " sites." << endl;
+    cout << "It is stored with " << packedSites.getNumberOfBitsPerState() << " bits per position." << endl;
+    size_t unpackedSize = packedSites.getNumberOfSequences() * packedSites.getNumberOfSites() * sizeof(int);
+    cout << "Memory used by the states: " << packedSites.getMemoryUsage() << " bytes, instead of " << unpackedSize << " bytes." << endl;
+
+    /*
+     * Let's check that the content is the same:
+     */
+    bool identical = true;
+    vector<int> content;
+    for (size_t i = 0; identical && i < sites->getNumberOfSites(); i++)
+    {
+      packedSites.getSiteContent(i, content);
+      identical = (content == sites->getSite(i).getContent());
+    }
+    for (size_t i = 0; identical && i < sequences->getNumberOfSequences(); i++)
+    {
+      packedSites.getSequenceContent(i, content);
+      identical = (content == sequences->getSequence(i).getContent());
+    }
+    cout << "Is the packed alignment identical to the original one? " << (identical ? "yes" : "no") << endl;
+
+    /*
+     * Sites are decoded on demand. The fastest way is to decode them into an existing vector,
+     * which avoids any memory allocation. Let's compare with the containers from ExContainer
+     * (see ExBenchmark for more accurate measures):
+     */
+    unsigned int nrep = 1000; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nrep; j++)
+    {
+      for (size_t i = 0; i < align->getNumberOfSites(); i++)
+        align->getSite(i);
+    }
+    ApplicationTools::displayTime("Total time used for site access in ASC:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nrep; j++)
+    {
+      for (size_t i = 0; i < sites->getNumberOfSites(); i++)
+        sites->getSite(i);
+    }
+    ApplicationTools::displayTime("Total time used for site access in VSC:");
+
+    ApplicationTools::startTimer();
+    for (unsigned int j = 0; j < nrep; j++)
+    {
+      for (size_t i = 0; i < packedSites.getNumberOfSites(); i++)
+        packedSites.getSiteContent(i, content);
+    }
+    ApplicationTools::displayTime("Total time used for site access in PackedAlignment:");
+
+    /*
+     * Packing has a cost too. Build this example with 'make INSTRUMENTATION=1' to see the time spent encoding states:
+     */
+    Instrumentation::display();
+
+    delete sequences;
+    delete sites;
+    delete align;
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,406 @@
+/*
+ * File: PackedSequence.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 12:15 2026
+ *
+ * Compact storage for nucleotide sequences and alignments, using 2 or 4 bits per state.
+ */
+
+#ifndef _PACKEDSEQUENCE_H_
+#define _PACKEDSEQUENCE_H_
+
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/SequenceExceptions.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/Container/OrderedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+
+#include <algorithm>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A vector of nucleotide states stored with 2 or 4 bits per state.
+   *
+   * With 2 bits, only the four resolved states (codes 0 to 3) can be stored.
+   * With 4 bits, all codes of the DNA and RNA alphabets can be stored,
+   * including gaps (-1) and IUPAC ambiguity codes (4 to 14): code c is stored as c + 1.
+   * States are packed in 64 bits words, and never straddle two words.
+   */
+  class PackedStates
+  {
+  private:
+    size_t size_;
+    unsigned int bits_;
+    std::vector<uint64_t> words_;
+
+  public:
+    /**
+     * @param size The number of states.
+     * @param bits The number of bits per state, 2 or 4.
+     */
+    PackedStates(size_t size = 0, unsigned int bits = 4) :
+      size_(size), bits_(bits), words_()
+    {
+      if (bits != 2 && bits != 4)
+        throw Exception("PackedStates: only 2 or 4 bits per state are supported.");
+      words_.resize((size + getStatesPerWord() - 1) / getStatesPerWord(), 0);
+    }
+
+  public:
+    size_t size() const { return size_; }
+    unsigned int getNumberOfBitsPerState() const { return bits_; }
+    size_t getStatesPerWord() const { return 64 / bits_; }
+    const std::vector<uint64_t>& getWords() const { return words_; }
+
+    /**
+     * @return The memory used by the states, in bytes.
+     */
+    size_t getMemoryUsage() const { return words_.size() * sizeof(uint64_t); }
+
+    int get(size_t i) const
+    {
+      size_t k = i % getStatesPerWord();
+      int v = static_cast<int>((words_[i / getStatesPerWord()] >> (k * bits_)) & mask_());
+      return bits_ == 2 ? v : v - 1;
+    }
+
+    void set(size_t i, int state)
+    {
+      uint64_t v = static_cast<uint64_t>(bits_ == 2 ? state : state + 1);
+      size_t k = i % getStatesPerWord();
+      uint64_t& w = words_[i / getStatesPerWord()];
+      w = (w & ~(mask_() << (k * bits_))) | (v << (k * bits_));
+    }
+
+    /**
+     * @brief Decode states [begin, end) into an array, one word at a time.
+     */
+    void decode(size_t begin, size_t end, int* out) const
+    {
+      size_t perWord = getStatesPerWord();
+      int offset = (bits_ == 2 ? 0 : -1);
+      size_t i = begin;
+      while (i < end)
+      {
+        size_t w = i / perWord;
+        size_t k = i % perWord;
+        size_t n = std::min(perWord - k, end - i);
+        uint64_t word = words_[w] >> (k * bits_);
+        for (size_t j = 0; j < n; ++j)
+        {
+          out[j] = static_cast<int>(word & mask_()) + offset;
+          word >>= bits_;
+        }
+        out += n;
+        i += n;
+      }
+    }
+
+    /**
+     * @return The number of bits needed to store the given states: 2 if they are all resolved, 4 otherwise.
+     * @throw BadIntException If a state can't be stored with 4 bits.
+     */
+    static unsigned int getRequiredBits(const std::vector<int>& states)
+    {
+      unsigned int bits = 2;
+      for (size_t i = 0; i < states.size(); ++i)
+      {
+        if (states[i] < -1 || states[i] > 14)
+          throw BadIntException(states[i], "PackedStates::getRequiredBits. State can't be packed.");
+        if (states[i] < 0 || states[i] > 3)
+          bits = 4;
+      }
+      return bits;
+    }
+
+  private:
+    uint64_t mask_() const { return (static_cast<uint64_t>(1) << bits_) - 1; }
+  };
+
+  /**
+   * @brief A read-only nucleotide sequence stored with 2 or 4 bits per state.
+   *
+   * This class mirrors the read methods of the Sequence interface (size, getValue, operator[],
+   * getChar, toString, getName...). It can't implement the interface itself, because
+   * Sequence::getContent() returns a reference to a vector of int, which would require
+   * the full unpacked content to be kept in memory. Use toSequence() to get a BasicSequence.
+   *
+   * The number of bits per state is chosen automatically: 2 bits if the sequence only
+   * has A, C, G and T/U, 4 bits if it has gaps or ambiguity codes.
+   */
+  class PackedSequence
+  {
+  private:
+    std::string name_;
+    const Alphabet* alphabet_;
+    PackedStates states_;
+
+  public:
+    /**
+     * @brief Pack a sequence.
+     *
+     * @throw AlphabetException If the sequence is not a DNA or RNA sequence.
+     */
+    PackedSequence(const Sequence& sequence) :
+      name_(sequence.getName()), alphabet_(sequence.getAlphabet()), states_()
+    {
+      pack_(sequence.getContent());
+    }
+
+    PackedSequence(const std::string& name, const std::vector<int>& content, const Alphabet* alphabet) :
+      name_(name), alphabet_(alphabet), states_()
+    {
+      pack_(content);
+    }
+
+  public:
+    const std::string& getName() const { return name_; }
+    void setName(const std::string& name) { name_ = name; }
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t size() const { return states_.size(); }
+    int getValue(size_t i) const
+    {
+      if (i >= size())
+        throw IndexOutOfBoundsException("PackedSequence::getValue.", i, 0, size() - 1);
+      return states_.get(i);
+    }
+    int operator[](size_t i) const { return states_.get(i); }
+    std::string getChar(size_t i) const { return alphabet_->intToChar(getValue(i)); }
+    unsigned int getNumberOfBitsPerState() const { return states_.getNumberOfBitsPerState(); }
+    const PackedStates& getStates() const { return states_; }
+
+    /**
+     * @return The memory used by the states, in bytes.
+     */
+    size_t getMemoryUsage() const { return states_.getMemoryUsage(); }
+
+    /**
+     * @brief Decode all states into a vector, which is resized if needed.
+     */
+    void getContent(std::vector<int>& content) const
+    {
+      content.resize(size());
+      if (size() > 0)
+        states_.decode(0, size(), &content[0]);
+    }
+
+    std::string toString() const
+    {
+      std::string s;
+      s.reserve(size());
+      for (size_t i = 0; i < size(); ++i)
+        s += alphabet_->intToChar(states_.get(i));
+      return s;
+    }
+
+    /**
+     * @return A new BasicSequence with the unpacked content.
+     */
+    Sequence* toSequence() const
+    {
+      std::vector<int> content;
+      getContent(content);
+      return new BasicSequence(name_, content, alphabet_);
+    }
+
+  private:
+    void pack_(const std::vector<int>& content)
+    {
+      BPP_INSTRUMENT_SCOPE(ENCODE);
+      BPP_INSTRUMENT_COUNT(ENCODE, content.size());
+      if (!AlphabetTools::isNucleicAlphabet(alphabet_))
+        throw AlphabetException("PackedSequence: only DNA and RNA sequences can be packed.", alphabet_);
+      states_ = PackedStates(content.size(), PackedStates::getRequiredBits(content));
+      for (size_t i = 0; i < content.size(); ++i)
+        states_.set(i, content[i]);
+    }
+  };
+
+  /**
+   * @brief A read-only nucleotide alignment stored column-wise with 2 or 4 bits per state.
+   *
+   * This is a packed counterpart of the VectorSiteContainer: each site is stored in a
+   * contiguous block of words, so that site access only reads nbSequences / 16 (or / 32) words.
+   * As for PackedSequence, the SiteContainer interface can't be implemented directly,
+   * because it returns references to unpacked objects. Sites and sequences are hence
+   * decoded on demand, either into existing vectors (no allocation) or into new objects.
+   */
+  class PackedAlignment
+  {
+  private:
+    const Alphabet* alphabet_;
+    std::vector<std::string> names_;
+    size_t nbSites_;
+    unsigned int bits_;
+    size_t wordsPerSite_;
+    std::vector<uint64_t> words_;
+
+  public:
+    /**
+     * @brief Pack an alignment.
+     *
+     * @param sequences A container with aligned DNA or RNA sequences.
+     * @throw SequenceNotAlignedException If sequences do not all have the same length.
+     * @throw AlphabetException If the sequences are not DNA or RNA sequences.
+     */
+    PackedAlignment(const OrderedSequenceContainer& sequences) :
+      alphabet_(sequences.getAlphabet()),
+      names_(sequences.getSequencesNames()),
+      nbSites_(0),
+      bits_(2),
+      wordsPerSite_(0),
+      words_()
+    {
+      if (!AlphabetTools::isNucleicAlphabet(alphabet_))
+        throw AlphabetException("PackedAlignment: only DNA and RNA alignments can be packed.", alphabet_);
+      size_t nbSeq = sequences.getNumberOfSequences();
+      if (nbSeq > 0)
+        nbSites_ = sequences.getSequence(0).size();
+      for (size_t i = 0; i < nbSeq; ++i)
+      {
+        const Sequence& seq = sequences.getSequence(i);
+        if (seq.size() != nbSites_)
+          throw SequenceNotAlignedException("PackedAlignment: sequences must all have the same length.", &seq);
+        if (PackedStates::getRequiredBits(seq.getContent()) == 4)
+          bits_ = 4;
+      }
+      BPP_INSTRUMENT_SCOPE(ENCODE);
+      BPP_INSTRUMENT_COUNT(ENCODE, nbSeq * nbSites_);
+      size_t perWord = 64 / bits_;
+      wordsPerSite_ = (nbSeq + perWord - 1) / perWord;
+      words_.assign(wordsPerSite_ * nbSites_, 0);
+      for (size_t i = 0; i < nbSeq; ++i)
+      {
+        const std::vector<int>& content = sequences.getSequence(i).getContent();
+        uint64_t shift = (i % perWord) * bits_;
+        size_t w = i / perWord;
+        for (size_t j = 0; j < nbSites_; ++j)
+        {
+          uint64_t v = static_cast<uint64_t>(bits_ == 2 ? content[j] : content[j] + 1);
+          words_[j * wordsPerSite_ + w] |= (v << shift);
+        }
+      }
+    }
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t getNumberOfSequences() const { return names_.size(); }
+    size_t getNumberOfSites() const { return nbSites_; }
+    const std::vector<std::string>& getSequencesNames() const { return names_; }
+    unsigned int getNumberOfBitsPerState() const { return bits_; }
+
+    /**
+     * @return The memory used by the states, in bytes.
+     */
+    size_t getMemoryUsage() const { return words_.size() * sizeof(uint64_t); }
+
+    /**
+     * @return The packed states. Site j is stored in words [j * getNumberOfWordsPerSite(), (j + 1) * getNumberOfWordsPerSite()),
+     * sequence i of this site being in bits (i % s) * b to (i % s) * b + b - 1 of word i / s, with b bits per state
+     * and s = 64 / b states per word. Unused bits are set to 0.
+     */
+    const std::vector<uint64_t>& getWords() const { return words_; }
+    size_t getNumberOfWordsPerSite() const { return wordsPerSite_; }
+
+    /**
+     * @return The state of sequence i at site j.
+     */
+    int getState(size_t i, size_t j) const
+    {
+      size_t perWord = 64 / bits_;
+      uint64_t v = (words_[j * wordsPerSite_ + i / perWord] >> ((i % perWord) * bits_)) & mask_();
+      return static_cast<int>(v) - (bits_ == 2 ? 0 : 1);
+    }
+
+    /**
+     * @brief Decode site j into a vector, which is resized if needed.
+     */
+    void getSiteContent(size_t j, std::vector<int>& content) const
+    {
+      if (j >= nbSites_)
+        throw IndexOutOfBoundsException("PackedAlignment::getSiteContent.", j, 0, nbSites_ - 1);
+      size_t nbSeq = names_.size();
+      size_t perWord = 64 / bits_;
+      int offset = (bits_ == 2 ? 0 : -1);
+      content.resize(nbSeq);
+      const uint64_t* site = &words_[j * wordsPerSite_];
+      for (size_t w = 0; w < wordsPerSite_; ++w)
+      {
+        uint64_t word = site[w];
+        size_t n = std::min(perWord, nbSeq - w * perWord);
+        int* out = &content[w * perWord];
+        for (size_t k = 0; k < n; ++k)
+        {
+          out[k] = static_cast<int>(word & mask_()) + offset;
+          word >>= bits_;
+        }
+      }
+    }
+
+    /**
+     * @brief Decode sequence i into a vector, which is resized if needed.
+     */
+    void getSequenceContent(size_t i, std::vector<int>& content) const
+    {
+      if (i >= names_.size())
+        throw IndexOutOfBoundsException("PackedAlignment::getSequenceContent.", i, 0, names_.size() - 1);
+      size_t perWord = 64 / bits_;
+      size_t w = i / perWord;
+      uint64_t shift = (i % perWord) * bits_;
+      int offset = (bits_ == 2 ? 0 : -1);
+      content.resize(nbSites_);
+      for (size_t j = 0; j < nbSites_; ++j)
+        content[j] = static_cast<int>((words_[j * wordsPerSite_ + w] >> shift) & mask_()) + offset;
+    }
+
+    /**
+     * @return A new Site object with the content of site j (positions start at 1).
+     */
+    Site* getSite(size_t j) const
+    {
+      std::vector<int> content;
+      getSiteContent(j, content);
+      return new Site(content, alphabet_, static_cast<int>(j + 1));
+    }
+
+    /**
+     * @return A new Sequence object with the content of sequence i.
+     */
+    Sequence* getSequence(size_t i) const
+    {
+      std::vector<int> content;
+      getSequenceContent(i, content);
+      return new BasicSequence(names_[i], content, alphabet_);
+    }
+
+    /**
+     * @return A new VectorSiteContainer with the unpacked alignment.
+     */
+    VectorSiteContainer* toSiteContainer() const
+    {
+      VectorSiteContainer* sites = new VectorSiteContainer(names_, alphabet_);
+      std::vector<int> content;
+      for (size_t j = 0; j < nbSites_; ++j)
+      {
+        getSiteContent(j, content);
+        sites->addSite(Site(content, alphabet_, static_cast<int>(j + 1)), false);
+      }
+      return sites;
+    }
+
+  private:
+    uint64_t mask_() const { return (static_cast<uint64_t>(1) << bits_) - 1; }
+  };
+
+} //end of namespace bpp.
+
+#endif //_PACKEDSEQUENCE_H_
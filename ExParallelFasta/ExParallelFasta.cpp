@@ -0,0 +1,156 @@
+/*
+ * File: ExParallelFasta.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 10:47 2026
+ *
+ * Reading large Fasta files using several threads.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ * - The file to read can be given as an argument, by default the alignment from ExContainer is used.
+ *   To see a real speedup, try with a larger file, for instance one generated with ExBenchmark:
+ *   cd ../ExBenchmark; ./exbenchmark input.synthetic.sequences=20000 input.synthetic.sites=5000 bench.repetitions=1
+ *   ./exparallelfasta ../ExBenchmark/synthetic.aln.fasta
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <chrono> /* for timings below the second. */
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * And the parallel reader, in this directory:
+ */
+#include "ParallelFasta.h"
+#include "Instrumentation.h" /* from ExBenchmark */
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * A small helper, returning the time (in seconds) needed to load a file with a given number of threads.
+ * We take the best of a few runs, to limit the noise.
+ */
+double timeLoading(const string& path, unsigned int nbThreads)
+{
+  ParallelFasta reader(nbThreads);
+  double best = 0;
+  for (unsigned int rep = 0; rep < 5; rep++)
+  {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    OrderedSequenceContainer* sequences = reader.readSequences(path, &AlphabetTools::DNA_ALPHABET);
+    double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    delete sequences;
+    if (rep == 0 || t < best)
+      best = t;
+  }
+  return best;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    string path = (args > 1 ? argv[1] : "../ExContainer/TIMnuc.aln.fasta");
+
+    /*
+     * The ParallelFasta reader maps the file in memory, and splits it at the record boundaries
+     * (the '>' lines). Blocks of records are then parsed and encoded on several threads,
+     * and the sequences are finally merged in their original order.
+     * The number of threads is given when creating the reader (0 means all available cores):
+     */
+    ParallelFasta parReader(4);
+    OrderedSequenceContainer* sequences = parReader.readSequences(path, &AlphabetTools::DNA_ALPHABET);
+    cout << "This container has " << sequences->getNumberOfSequences() << " sequences." << endl;
+
+    /*
+     * The result is exactly the same as with the serial reader:
+     */
+    Fasta fasReader;
+    OrderedSequenceContainer* reference = fasReader.readSequences(path, &AlphabetTools::DNA_ALPHABET);
+    bool identical = (reference->getNumberOfSequences() == sequences->getNumberOfSequences());
+    for (size_t i = 0; identical && i < reference->getNumberOfSequences(); i++)
+    {
+      identical = (reference->getSequence(i).getName() == sequences->getSequence(i).getName())
+               && (reference->getSequence(i).getContent() == sequences->getSequence(i).getContent());
+    }
+    cout << "Same sequences as with the Fasta reader? " << (identical ? "yes" : "no") << endl;
+    delete reference;
+    delete sequences;
+
+    /*
+     * Alignments can be read too, in which case sites are also built in parallel:
+     */
+    SiteContainer* sites = parReader.readAlignment(path, &AlphabetTools::DNA_ALPHABET);
+    cout << "This alignment has " << sites->getNumberOfSites() << " sites." << endl;
+    delete sites;
+
+    /*
+     * Now let's see how the reading time scales with the number of threads.
+     * Of course, you won't see any gain with more threads than your computer has cores!
+     */
+    ApplicationTools::displayResult("Available hardware threads", ThreadPool::getDefaultNumberOfThreads());
+    double t1 = timeLoading(path, 1);
+    for (unsigned int nbThreads = 1; nbThreads <= 8; nbThreads *= 2)
+    {
+      double t = (nbThreads == 1 ? t1 : timeLoading(path, nbThreads));
+      ApplicationTools::displayResult("Loading with " + TextTools::toString(nbThreads) + " thread(s)",
+          TextTools::toString(t * 1000., 4) + " ms, speedup x" + TextTools::toString(t1 / t, 3));
+    }
+
+    /*
+     * When built with 'make INSTRUMENTATION=1', the reader records how long each thread spent parsing,
+     * encoding and building sites, and how much it allocated. The report also shows how evenly the work was shared:
+     */
+    Instrumentation::display();
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,194 @@
+/*
+ * File: ParallelFasta.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 10:47 2026
+ *
+ * A multi-threaded Fasta reader.
+ */
+
+#ifndef _PARALLELFASTA_H_
+#define _PARALLELFASTA_H_
+
+#include "ThreadPool.h"
+#include "MappedFasta.h" /* from ExContainer */
+#include "SequenceMoveTools.h" /* from ExContainer */
+#include "Instrumentation.h" /* from ExBenchmark */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Site.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Fasta reader parsing and encoding records on several threads.
+   *
+   * The file is memory-mapped and split at record boundaries (header lines) using MappedFasta.
+   * Consecutive blocks of records are then encoded by a pool of threads, and the resulting
+   * sequences are merged in the original file order, so that the output is identical
+   * to the one of the serial readers.
+   */
+  class ParallelFasta
+  {
+  private:
+    unsigned int nbThreads_;
+
+  public:
+    /**
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     */
+    ParallelFasta(unsigned int nbThreads = 0) : nbThreads_(nbThreads) {}
+
+  public:
+    unsigned int getNumberOfThreads() const { return nbThreads_; }
+    void setNumberOfThreads(unsigned int nbThreads) { nbThreads_ = nbThreads; }
+
+    /**
+     * @brief Read all sequences from a file.
+     *
+     * @param path     The Fasta file to read.
+     * @param alphabet The alphabet to use.
+     * @return A new VectorSequenceContainer object.
+     * @throw Exception If two sequences have the same name, or if a character is not in the alphabet.
+     */
+    VectorSequenceContainer* readSequences(const std::string& path, const Alphabet* alphabet) const
+    {
+      BPP_INSTRUMENT_SCOPE(PARSE);
+      MappedFasta fasta(path);
+      CharacterTable table(alphabet);
+      size_t nbSeq = fasta.getNumberOfSequences();
+      BPP_INSTRUMENT_COUNT(PARSE, nbSeq);
+      std::vector<Sequence*> parsed(nbSeq, 0);
+      try
+      {
+        ThreadPool pool(nbThreads_);
+        pool.parallelFor(nbSeq, [&](size_t begin, size_t end) {
+          std::vector<int> content;
+          for (size_t i = begin; i < end; ++i)
+          {
+            fasta.encode(i, table, content);
+            parsed[i] = new MovableSequence(fasta.getName(i), std::move(content), alphabet);
+          }
+        });
+      }
+      catch (...)
+      {
+        deleteAll_(parsed);
+        throw;
+      }
+
+      //Names are checked here, in O(n log n), before anything is merged:
+      std::set<std::string> names;
+      for (size_t i = 0; i < nbSeq; ++i)
+      {
+        if (!names.insert(parsed[i]->getName()).second)
+        {
+          std::string name = parsed[i]->getName();
+          deleteAll_(parsed);
+          throw Exception("ParallelFasta::readSequences. Sequence '" + name + "' already exists in container.");
+        }
+      }
+
+      //Merge in the file order. The parsed sequences are not needed anymore, so their content is moved, not copied:
+      BPP_INSTRUMENT_SCOPE(CLONE);
+      BPP_INSTRUMENT_COUNT(CLONE, nbSeq);
+      std::unique_ptr<VectorSequenceContainer> sequences(new VectorSequenceContainer(alphabet));
+      for (size_t i = 0; i < nbSeq; ++i)
+      {
+        std::unique_ptr<Sequence> sequence(parsed[i]);
+        parsed[i] = 0;
+        try
+        {
+          SequenceMoveTools::addSequence(*sequences, std::move(sequence), false);
+        }
+        catch (...)
+        {
+          deleteAll_(parsed);
+          throw;
+        }
+      }
+      return sequences.release();
+    }
+
+    /**
+     * @brief Read an alignment from a file.
+     *
+     * Rows are encoded in parallel, then sites are built from them in parallel.
+     *
+     * @param path     The Fasta file to read.
+     * @param alphabet The alphabet to use.
+     * @return A new VectorSiteContainer object.
+     * @throw Exception If the sequences do not all have the same length.
+     */
+    VectorSiteContainer* readAlignment(const std::string& path, const Alphabet* alphabet) const
+    {
+      BPP_INSTRUMENT_SCOPE(PARSE);
+      MappedFasta fasta(path);
+      CharacterTable table(alphabet);
+      size_t nbSeq = fasta.getNumberOfSequences();
+      BPP_INSTRUMENT_COUNT(PARSE, nbSeq);
+      std::vector<std::string> names(nbSeq);
+      std::vector<int> firstRow;
+      if (nbSeq > 0)
+        fasta.encode(0, table, firstRow);
+      size_t nbSites = firstRow.size();
+      std::vector<int> matrix(nbSeq * nbSites); //row-major
+
+      ThreadPool pool(nbThreads_);
+      pool.parallelFor(nbSeq, [&](size_t begin, size_t end) {
+        std::vector<int> content;
+        for (size_t i = begin; i < end; ++i)
+        {
+          names[i] = fasta.getName(i);
+          fasta.encode(i, table, content);
+          if (content.size() != nbSites)
+            throw Exception("ParallelFasta::readAlignment. Sequence " + names[i] + " does not have the same length as the previous ones.");
+          std::copy(content.begin(), content.end(), matrix.begin() + static_cast<std::ptrdiff_t>(i * nbSites));
+        }
+      });
+
+      //Sites are owned by the vector, so that they are freed if an exception is thrown:
+      std::vector< std::unique_ptr<Site> > sites(nbSites);
+      pool.parallelFor(nbSites, [&](size_t begin, size_t end) {
+        BPP_INSTRUMENT_SCOPE(TRANSPOSE);
+        BPP_INSTRUMENT_COUNT(TRANSPOSE, nbSeq * (end - begin));
+        std::vector<int> column(nbSeq);
+        for (size_t j = begin; j < end; ++j)
+        {
+          for (size_t i = 0; i < nbSeq; ++i)
+            column[i] = matrix[i * nbSites + j];
+          sites[j].reset(new Site(column, alphabet, static_cast<int>(j + 1)));
+        }
+      });
+
+      std::unique_ptr<VectorSiteContainer> alignment(new VectorSiteContainer(names, alphabet));
+      for (size_t j = 0; j < nbSites; ++j)
+      {
+        alignment->addSite(*sites[j], false);
+        sites[j].reset();
+      }
+      return alignment.release();
+    }
+
+  private:
+    static void deleteAll_(std::vector<Sequence*>& sequences)
+    {
+      for (size_t i = 0; i < sequences.size(); ++i)
+      {
+        delete sequences[i];
+        sequences[i] = 0;
+      }
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_PARALLELFASTA_H_
@@ -0,0 +1,262 @@
+/*
+ * File: ThreadPool.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 10:47 2026
+ *
+ * A minimal pool of worker threads.
+ */
+
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A fixed-size pool of worker threads executing tasks from a shared queue.
+   *
+   * Tasks are submitted with submit(), and wait() blocks until all submitted tasks are done.
+   * If a task throws an exception, the first one is rethrown by wait().
+   * A pool with a single thread executes tasks in the calling thread, in order.
+   */
+  class ThreadPool
+  {
+  private:
+    std::vector<std::thread> workers_;
+    std::deque< std::function<void()> > tasks_;
+    std::mutex mutex_;
+    std::condition_variable taskAvailable_;
+    std::condition_variable allDone_;
+    size_t pending_;
+    bool stop_;
+    std::exception_ptr error_;
+
+  public:
+    /**
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     */
+    ThreadPool(unsigned int nbThreads = 0) :
+      workers_(), tasks_(), mutex_(), taskAvailable_(), allDone_(), pending_(0), stop_(false), error_()
+    {
+      if (nbThreads == 0)
+        nbThreads = getDefaultNumberOfThreads();
+      if (nbThreads > 1)
+      {
+        for (unsigned int i = 0; i < nbThreads; ++i)
+          workers_.push_back(std::thread(&ThreadPool::work_, this));
+      }
+    }
+
+    ~ThreadPool()
+    {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      taskAvailable_.notify_all();
+      for (size_t i = 0; i < workers_.size(); ++i)
+        workers_[i].join();
+    }
+
+  private:
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+
+  public:
+    size_t getNumberOfThreads() const { return std::max(workers_.size(), static_cast<size_t>(1)); }
+
+    /**
+     * @brief Add a task to the queue.
+     */
+    void submit(const std::function<void()>& task)
+    {
+      if (workers_.empty())
+      {
+        run_(task);
+        return;
+      }
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        tasks_.push_back(task);
+        ++pending_;
+      }
+      taskAvailable_.notify_one();
+    }
+
+    /**
+     * @brief Wait until all submitted tasks are done.
+     *
+     * @throw Any exception thrown by a task.
+     */
+    void wait()
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      allDone_.wait(lock, [this]() { return pending_ == 0; });
+      if (error_)
+      {
+        std::exception_ptr error = error_;
+        error_ = std::exception_ptr();
+        std::rethrow_exception(error);
+      }
+    }
+
+    /**
+     * @brief Call f(begin, end) on consecutive ranges covering [0, n), and wait for completion.
+     *
+     * @param n         The total number of items.
+     * @param f         A function processing items in [begin, end).
+     * @param grainSize The maximum number of items per range. 0 means n is split in four ranges per thread.
+     */
+    template<class F>
+    void parallelFor(size_t n, F f, size_t grainSize = 0)
+    {
+      if (grainSize == 0)
+        grainSize = std::max(n / (4 * getNumberOfThreads()), static_cast<size_t>(1));
+      for (size_t begin = 0; begin < n; begin += grainSize)
+      {
+        size_t end = std::min(begin + grainSize, n);
+        submit([=]() { f(begin, end); });
+      }
+      wait();
+    }
+
+    /**
+     * @brief Call f(begin, end, slot) on ranges covering [0, n), with work stealing, and wait for completion.
+     *
+     * [0, n) is first split in one contiguous range per thread. Each thread takes grainSize items
+     * at a time from the front of its own range, and when it is empty, steals the back half of the
+     * largest remaining range. This balances uneven workloads while keeping neighbouring items
+     * on the same thread.
+     *
+     * @param n         The total number of items.
+     * @param f         A function processing items in [begin, end). The slot argument is an index
+     *                  in [0, getNumberOfThreads()) which is never used by two concurrent calls,
+     *                  so that it can be used to access per-thread data.
+     * @param grainSize The number of items processed per call.
+     */
+    template<class F>
+    void parallelForStealing(size_t n, F f, size_t grainSize = 1)
+    {
+      size_t nbSlots = getNumberOfThreads();
+      grainSize = std::max(grainSize, static_cast<size_t>(1));
+      std::vector<StealableRange_> ranges(nbSlots);
+      for (size_t t = 0; t < nbSlots; ++t)
+      {
+        ranges[t].begin = n * t / nbSlots;
+        ranges[t].end = n * (t + 1) / nbSlots;
+      }
+      for (size_t t = 0; t < nbSlots; ++t)
+      {
+        submit([&ranges, &f, t, nbSlots, grainSize]() {
+          StealableRange_& own = ranges[t];
+          while (true)
+          {
+            size_t begin, end;
+            {
+              std::unique_lock<std::mutex> lock(own.mutex);
+              begin = own.begin;
+              end = std::min(begin + grainSize, own.end);
+              own.begin = end;
+            }
+            if (begin < end)
+            {
+              f(begin, end, t);
+              continue;
+            }
+            //Own range is empty, steal from the largest one:
+            size_t victim = nbSlots;
+            size_t largest = 0;
+            for (size_t v = 0; v < nbSlots; ++v)
+            {
+              std::unique_lock<std::mutex> lock(ranges[v].mutex);
+              size_t remaining = ranges[v].end - ranges[v].begin;
+              if (v != t && remaining > largest)
+              {
+                largest = remaining;
+                victim = v;
+              }
+            }
+            if (victim == nbSlots)
+              return;
+            std::unique_lock<std::mutex> victimLock(ranges[victim].mutex, std::defer_lock);
+            std::unique_lock<std::mutex> ownLock(own.mutex, std::defer_lock);
+            std::lock(victimLock, ownLock);
+            size_t remaining = ranges[victim].end - ranges[victim].begin;
+            if (remaining == 0)
+              continue;
+            size_t middle = ranges[victim].end - (remaining + 1) / 2;
+            own.begin = middle;
+            own.end = ranges[victim].end;
+            ranges[victim].end = middle;
+          }
+        });
+      }
+      wait();
+    }
+
+    /**
+     * @return The number of hardware threads, or 1 if unknown.
+     */
+    static unsigned int getDefaultNumberOfThreads()
+    {
+      return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+  private:
+    struct StealableRange_
+    {
+      std::mutex mutex;
+      size_t begin;
+      size_t end;
+      StealableRange_() : mutex(), begin(0), end(0) {}
+    };
+
+    void run_(const std::function<void()>& task)
+    {
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!error_)
+          error_ = std::current_exception();
+      }
+    }
+
+    void work_()
+    {
+      while (true)
+      {
+        std::function<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          taskAvailable_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+          if (stop_ && tasks_.empty())
+            return;
+          task = tasks_.front();
+          tasks_.pop_front();
+        }
+        run_(task);
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          --pending_;
+          if (pending_ == 0)
+            allDone_.notify_all();
+        }
+      }
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_THREADPOOL_H_
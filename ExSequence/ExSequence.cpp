@@ -83,6 +83,7 @@ int main(int args, char ** argv)
       }
       cout << endl;
     }
+    //For long sequences, see the DotPlot class in ExDotPlot, which computes 64 cells at a time.
 
     /*
      * Sequence objects are derived from a more general structure called SymbolList.
@@ -183,6 +184,10 @@ int main(int args, char ** argv)
     }
     delete codonSequence;
     delete codonAlphabet;
+    /*
+     * The sequence was decoded to a string, and parsed again by the codon alphabet.
+     * To convert many sequences, see the CodonEncoder in ExGeneticCode, which works on the codes directly.
+     */
 
     /*
      * To make more complex deparsing/reparsing, you need *Transliterator* objects.
@@ -217,7 +222,11 @@ int main(int args, char ** argv)
     cout << "Translated: " << trSequence->toString() << endl;
     delete trSequence;
     delete transliterator;
-    
+
+    /*
+     * Transliterators are called for each position of the sequence.
+     * To process many sequences, see ExTransliteration, where they are compiled into lookup tables.
+     */
   }
   catch (Exception& e)
   {
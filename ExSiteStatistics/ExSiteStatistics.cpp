@@ -0,0 +1,178 @@
+/*
+ * File: ExSiteStatistics.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 03:40 2026
+ *
+ * Computing statistics on all the sites of an alignment at once.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <map>
+#include <memory>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/SiteTools.h>
+#include <Bpp/Seq/SymbolListTools.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * The statistics, in this directory, and synthetic alignments from ExBenchmark:
+ */
+#include "SiteStatistics.h"
+#include "SyntheticAlignment.h" /* from ExBenchmark */
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * Check that the counts of SiteStatistics are the ones of SymbolListTools, site by site.
+ */
+bool checkCounts(const SiteContainer& sites, const SiteStatistics& statistics)
+{
+  for (size_t j = 0; j < sites.getNumberOfSites(); j++)
+  {
+    map<int, size_t> counts;
+    SymbolListTools::getCounts(sites.getSite(j), counts);
+    for (size_t k = 0; k < statistics.getNumberOfStates(); k++)
+    {
+      if (statistics.getCount(j, static_cast<int>(k)) != counts[static_cast<int>(k)])
+        return false;
+    }
+    if (statistics.getGapCounts()[j] != counts[-1])
+      return false;
+  }
+  return true;
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * The SiteTools and SymbolListTools classes compute statistics site by site, from Site objects,
+     * and count states in maps. Before a phylogenetic analysis, they are typically called on every site
+     * of the alignment, to remove the sites with too many gaps for instance.
+     * The SiteStatistics class computes the main statistics for all sites at once, reading the data where
+     * the container stores them, and returns them as flat arrays:
+     */
+    Fasta fasReader;
+    unique_ptr<OrderedSequenceContainer> sequences(fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET));
+    VectorSiteContainer sites(*sequences);
+    SiteStatistics statistics(sites);
+    cout << "Statistics computed with " << SimdSupport::getName(statistics.getSimdLevel()) << " instructions." << endl;
+    for (size_t j = 0; j < 10; j++)
+    {
+      cout << "Site " << (j + 1) << ": " << sites.getSite(j).toString() << " A=" << statistics.getCount(j, 0)
+           << " C=" << statistics.getCount(j, 1) << " G=" << statistics.getCount(j, 2) << " T=" << statistics.getCount(j, 3)
+           << " gaps=" << statistics.getGapFraction(j) << " entropy=" << statistics.getEntropy(j)
+           << (statistics.isConstant(j) ? " constant" : "") << endl;
+    }
+    cout << "Same counts as SymbolListTools? " << (checkCounts(sites, statistics) ? "yes" : "no") << endl;
+
+    /*
+     * The statistics can then be used to select sites. Here, we keep the variable sites with at most 10% of gaps:
+     */
+    vector<size_t> selection = statistics.selectSites(0.1, 1., false);
+    cout << selection.size() << " sites out of " << sites.getNumberOfSites() << " are variable with at most 10% of gaps." << endl;
+
+    /*
+     * Let's compare the speed of both approaches, on a larger synthetic alignment.
+     * SiteStatistics reads the sequences of an AlignedSequenceContainer, the sites of a VectorSiteContainer,
+     * and the packed sites of a PackedAlignment (see ExPackedSequence):
+     */
+    unique_ptr<VectorSequenceContainer> synthetic(SyntheticAlignment::generate(500, 20000, &AlphabetTools::DNA_ALPHABET)); /* WATCHOUT!!! reduce these numbers if this is too slow on your computer! */
+    AlignedSequenceContainer align(*synthetic);
+    VectorSiteContainer vsc(*synthetic);
+    PackedAlignment packed(*synthetic);
+
+    ApplicationTools::startTimer();
+    vector<double> gapFractions(vsc.getNumberOfSites());
+    for (size_t j = 0; j < vsc.getNumberOfSites(); j++)
+    {
+      map<int, size_t> counts;
+      const Site& site = vsc.getSite(j);
+      SymbolListTools::getCounts(site, counts);
+      gapFractions[j] = static_cast<double>(counts[-1]) / static_cast<double>(site.size());
+      SiteTools::variabilityShannon(site, false);
+    }
+    ApplicationTools::displayTime("Time used site by site, with SiteTools:");
+
+    ApplicationTools::startTimer();
+    SiteStatistics alignStatistics(align);
+    ApplicationTools::displayTime("Time used with SiteStatistics on an AlignedSequenceContainer:");
+
+    ApplicationTools::startTimer();
+    SiteStatistics vscStatistics(vsc);
+    ApplicationTools::displayTime("Time used with SiteStatistics on a VectorSiteContainer:");
+
+    ApplicationTools::startTimer();
+    SiteStatistics packedStatistics(packed);
+    ApplicationTools::displayTime("Time used with SiteStatistics on a PackedAlignment:");
+
+    ApplicationTools::startTimer();
+    SiteStatistics scalarStatistics(align, 1, SIMD_SCALAR);
+    ApplicationTools::displayTime("Time used with SiteStatistics on an AlignedSequenceContainer, without SIMD nor threads:");
+
+    cout << "Same results? " << (alignStatistics.getCounts() == vscStatistics.getCounts()
+        && alignStatistics.getCounts() == packedStatistics.getCounts()
+        && alignStatistics.getCounts() == scalarStatistics.getCounts()
+        && alignStatistics.getGapFractions() == gapFractions ? "yes" : "no") << endl;
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
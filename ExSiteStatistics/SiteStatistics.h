@@ -0,0 +1,447 @@
+/*
+ * File: SiteStatistics.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 03:40 2026
+ *
+ * State counts, gap and unknown fractions, entropy and constancy of all the sites of an alignment at once.
+ */
+
+#ifndef _SITESTATISTICS_H_
+#define _SITESTATISTICS_H_
+
+#include "SimdSupport.h" /* from ExAlignment */
+#include "ThreadPool.h" /* from ExParallelFasta */
+#include "PackedSequence.h" /* from ExPackedSequence */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/SiteContainer.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Statistics on all the sites of an alignment, computed in one pass over the data.
+   *
+   * For each site, this class computes:
+   * - the number of occurrences of each resolved state (0 to alphabet->getSize() - 1),
+   * - the number of gaps, and of unresolved or unknown states, and their fractions,
+   * - the Shannon entropy of the resolved states (natural logarithm), gaps and unresolved states being ignored,
+   * - whether the site is constant, that is has a single resolved state, gaps and unresolved states being ignored.
+   * Sites without any resolved state have an entropy of 0 and are not constant.
+   *
+   * All results are stored in flat arrays indexed by the site, and the counts in an array where the count of
+   * state k at site j is at j * getNumberOfStates() + k.
+   *
+   * The data are read where they are stored, without creating any Site object:
+   * - from the sequences of an AlignedSequenceContainer (or any alignment derived from VectorSequenceContainer),
+   *   by blocks of consecutive sites: states of each sequence are compared to all states with
+   *   SIMD instructions, and the results are added to one counter per state and site;
+   * - from the sites of a VectorSiteContainer (or any other SiteContainer), each site being counted with the same
+   *   SIMD comparisons;
+   * - from a PackedAlignment, by counting the matching bits of 64 bits words.
+   * Blocks of sites are processed in parallel.
+   *
+   * Comparisons cost one instruction per state, for 4 or 8 positions at once: alphabets with more than 20 states,
+   * as codons, are counted with a lookup table instead.
+   */
+  class SiteStatistics
+  {
+  private:
+    const Alphabet* alphabet_;
+    size_t nbSequences_;
+    size_t nbSites_;
+    size_t nbStates_;
+    std::vector<uint32_t> counts_;
+    std::vector<uint32_t> gaps_;
+    std::vector<uint32_t> unknowns_;
+    std::vector<double> gapFractions_;
+    std::vector<double> unknownFractions_;
+    std::vector<double> entropies_;
+    std::vector<unsigned char> constant_;
+    SimdLevel level_;
+
+    enum { BLOCK_SIZE = 256, MAX_COMPARED_STATES = 20 };
+
+  public:
+    /**
+     * @param sites     The alignment.
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     * @param level     The instruction set to use.
+     */
+    SiteStatistics(const SiteContainer& sites, unsigned int nbThreads = 0, SimdLevel level = SimdSupport::getBestLevel()) :
+      alphabet_(sites.getAlphabet()),
+      nbSequences_(sites.getNumberOfSequences()),
+      nbSites_(sites.getNumberOfSequences() > 0 ? sites.getNumberOfSites() : 0),
+      nbStates_(sites.getAlphabet()->getSize()),
+      counts_(), gaps_(), unknowns_(), gapFractions_(), unknownFractions_(), entropies_(), constant_(),
+      level_(SimdSupport::getSupportedLevel(level))
+    {
+      allocate_();
+      ThreadPool pool(nbSequences_ * nbSites_ < 1000000 ? 1 : nbThreads);
+      const VectorSequenceContainer* sequences = dynamic_cast<const VectorSequenceContainer*>(&sites);
+      if (sequences)
+      {
+        std::vector<const int*> rows(nbSequences_);
+        for (size_t i = 0; i < nbSequences_; ++i)
+          rows[i] = (nbSites_ > 0 ? &sequences->getSequence(i).getContent()[0] : 0);
+        countRows_(pool, rows);
+      }
+      else
+      {
+        //Site objects are requested sequentially, as some containers build them on demand:
+        std::vector<const int*> columns(nbSites_);
+        for (size_t j = 0; j < nbSites_; ++j)
+          columns[j] = &sites.getSite(j).getContent()[0];
+        countColumns_(pool, columns);
+      }
+      finish_(pool);
+    }
+
+    /**
+     * @param sites     The packed alignment.
+     * @param nbThreads The number of threads to use. 0 means as many as hardware threads.
+     * @param level     The instruction set to use. Words are counted with the popcnt instruction if AVX2 is supported.
+     */
+    SiteStatistics(const PackedAlignment& sites, unsigned int nbThreads = 0, SimdLevel level = SimdSupport::getBestLevel()) :
+      alphabet_(sites.getAlphabet()),
+      nbSequences_(sites.getNumberOfSequences()),
+      nbSites_(sites.getNumberOfSites()),
+      nbStates_(4),
+      counts_(), gaps_(), unknowns_(), gapFractions_(), unknownFractions_(), entropies_(), constant_(),
+      level_(SimdSupport::getSupportedLevel(level))
+    {
+      allocate_();
+      ThreadPool pool(nbSequences_ * nbSites_ < 1000000 ? 1 : nbThreads);
+      countPacked_(pool, sites);
+      finish_(pool);
+    }
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t getNumberOfSequences() const { return nbSequences_; }
+    size_t getNumberOfSites() const { return nbSites_; }
+    size_t getNumberOfStates() const { return nbStates_; }
+    SimdLevel getSimdLevel() const { return level_; }
+
+    /**
+     * @return The counts of all states at all sites: the count of state k at site j is at j * getNumberOfStates() + k.
+     */
+    const std::vector<uint32_t>& getCounts() const { return counts_; }
+    const std::vector<uint32_t>& getGapCounts() const { return gaps_; }
+    const std::vector<uint32_t>& getUnknownCounts() const { return unknowns_; }
+    const std::vector<double>& getGapFractions() const { return gapFractions_; }
+    const std::vector<double>& getUnknownFractions() const { return unknownFractions_; }
+    const std::vector<double>& getEntropies() const { return entropies_; }
+    const std::vector<unsigned char>& getConstantSites() const { return constant_; }
+
+    uint32_t getCount(size_t siteIndex, int state) const { return counts_[siteIndex * nbStates_ + static_cast<size_t>(state)]; }
+    double getGapFraction(size_t siteIndex) const { return gapFractions_[siteIndex]; }
+    double getUnknownFraction(size_t siteIndex) const { return unknownFractions_[siteIndex]; }
+    double getEntropy(size_t siteIndex) const { return entropies_[siteIndex]; }
+    bool isConstant(size_t siteIndex) const { return constant_[siteIndex] != 0; }
+
+    /**
+     * @brief Select sites, as is usually done before a phylogenetic analysis.
+     *
+     * @param maxGapFraction     The maximum fraction of gaps of the selected sites.
+     * @param maxUnknownFraction The maximum fraction of unresolved and unknown states of the selected sites.
+     * @param keepConstant       If false, constant sites are not selected.
+     * @return The positions of the selected sites, starting at 0.
+     */
+    std::vector<size_t> selectSites(double maxGapFraction, double maxUnknownFraction = 1., bool keepConstant = true) const
+    {
+      std::vector<size_t> selection;
+      for (size_t j = 0; j < nbSites_; ++j)
+      {
+        if (gapFractions_[j] <= maxGapFraction && unknownFractions_[j] <= maxUnknownFraction && (keepConstant || !constant_[j]))
+          selection.push_back(j);
+      }
+      return selection;
+    }
+
+  private:
+    void allocate_()
+    {
+      counts_.assign(nbSites_ * nbStates_, 0);
+      gaps_.assign(nbSites_, 0);
+      unknowns_.assign(nbSites_, 0);
+      gapFractions_.assign(nbSites_, 0.);
+      unknownFractions_.assign(nbSites_, 0.);
+      entropies_.assign(nbSites_, 0.);
+      constant_.assign(nbSites_, 0);
+    }
+
+    /*
+     * Counters are stored by state: counters[s * stride + b] counts the occurrences of state s at position b
+     * of a block. Slots 0 to nbStates_ - 1 are the resolved states, slot nbStates_ is the gap, and, for alphabets
+     * counted with a lookup table, slot nbStates_ + 1 receives all other states, and is not used afterwards.
+     */
+    size_t getNumberOfSlots_() const { return nbStates_ + (nbStates_ <= static_cast<size_t>(MAX_COMPARED_STATES) ? 1 : 2); }
+
+    void getSlotValues_(std::vector<int>& values) const
+    {
+      values.resize(nbStates_ + 1);
+      for (size_t s = 0; s < nbStates_; ++s)
+        values[s] = static_cast<int>(s);
+      values[nbStates_] = alphabet_->getGapCharacterCode();
+    }
+
+    /*
+     * The lookup table gives the slot of state x at index x + 1.
+     */
+    void getSlotTable_(std::vector<uint32_t>& table) const
+    {
+      std::vector<int> codes = alphabet_->getSupportedInts();
+      int maxCode = static_cast<int>(nbStates_);
+      for (size_t i = 0; i < codes.size(); ++i)
+        maxCode = std::max(maxCode, codes[i]);
+      table.assign(static_cast<size_t>(maxCode) + 2, static_cast<uint32_t>(nbStates_ + 1));
+      for (size_t s = 0; s < nbStates_; ++s)
+        table[s + 1] = static_cast<uint32_t>(s);
+      table[static_cast<size_t>(alphabet_->getGapCharacterCode() + 1)] = static_cast<uint32_t>(nbStates_);
+    }
+
+    /*
+     * Add the states of [states, states + count) to the counters, with stride between the counters of two slots.
+     */
+    void accumulate_(const int* states, size_t count, const std::vector<int>& values, const std::vector<uint32_t>& table,
+        uint32_t* counters, size_t stride) const
+    {
+      if (nbStates_ > static_cast<size_t>(MAX_COMPARED_STATES))
+      {
+        size_t tableSize = table.size();
+        uint32_t other = static_cast<uint32_t>(nbStates_ + 1);
+        for (size_t b = 0; b < count; ++b)
+        {
+          size_t x = static_cast<size_t>(states[b] + 1);
+          counters[(x < tableSize ? table[x] : other) * stride + b]++;
+        }
+        return;
+      }
+#ifdef BPP_SIMD_X86
+      if (level_ == SIMD_AVX2)
+        return compareAvx2_(states, count, &values[0], values.size(), counters, stride);
+      if (level_ == SIMD_SSE41)
+        return compareSse41_(states, count, &values[0], values.size(), counters, stride);
+#endif
+      compareScalar_(states, count, &values[0], values.size(), counters, stride);
+    }
+
+    static void compareScalar_(const int* states, size_t count, const int* values, size_t nbValues, uint32_t* counters, size_t stride)
+    {
+      for (size_t s = 0; s < nbValues; ++s)
+      {
+        uint32_t* c = counters + s * stride;
+        int v = values[s];
+        for (size_t b = 0; b < count; ++b)
+          c[b] += (states[b] == v ? 1 : 0);
+      }
+    }
+
+#ifdef BPP_SIMD_X86
+    /*
+     * Comparisons give -1 in the matching lanes, which are hence subtracted from the counters.
+     */
+    BPP_TARGET_SSE41
+    static void compareSse41_(const int* states, size_t count, const int* values, size_t nbValues, uint32_t* counters, size_t stride)
+    {
+      size_t b = 0;
+      for ( ; b + 4 <= count; b += 4)
+      {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(states + b));
+        for (size_t s = 0; s < nbValues; ++s)
+        {
+          __m128i* c = reinterpret_cast<__m128i*>(counters + s * stride + b);
+          _mm_storeu_si128(c, _mm_sub_epi32(_mm_loadu_si128(c), _mm_cmpeq_epi32(x, _mm_set1_epi32(values[s]))));
+        }
+      }
+      compareScalar_(states + b, count - b, values, nbValues, counters + b, stride);
+    }
+
+    BPP_TARGET_AVX2
+    static void compareAvx2_(const int* states, size_t count, const int* values, size_t nbValues, uint32_t* counters, size_t stride)
+    {
+      size_t b = 0;
+      for ( ; b + 8 <= count; b += 8)
+      {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(states + b));
+        for (size_t s = 0; s < nbValues; ++s)
+        {
+          __m256i* c = reinterpret_cast<__m256i*>(counters + s * stride + b);
+          _mm256_storeu_si256(c, _mm256_sub_epi32(_mm256_loadu_si256(c), _mm256_cmpeq_epi32(x, _mm256_set1_epi32(values[s]))));
+        }
+      }
+      compareScalar_(states + b, count - b, values, nbValues, counters + b, stride);
+    }
+#endif
+
+    /*
+     * Sites are counted by blocks of BLOCK_SIZE consecutive sites, reading the block in each sequence in turn.
+     */
+    void countRows_(ThreadPool& pool, const std::vector<const int*>& rows)
+    {
+      size_t nbBlocks = (nbSites_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+      pool.parallelFor(nbBlocks, [&](size_t firstBlock, size_t lastBlock) {
+        std::vector<int> values;
+        std::vector<uint32_t> table;
+        getSlotValues_(values);
+        getSlotTable_(table);
+        size_t nbSlots = getNumberOfSlots_();
+        size_t blockSize = BLOCK_SIZE;
+        std::vector<uint32_t> counters(nbSlots * blockSize);
+        for (size_t block = firstBlock; block < lastBlock; ++block)
+        {
+          size_t j0 = block * blockSize;
+          size_t width = std::min(blockSize, nbSites_ - j0);
+          std::fill(counters.begin(), counters.end(), 0);
+          for (size_t i = 0; i < nbSequences_; ++i)
+            accumulate_(rows[i] + j0, width, values, table, &counters[0], blockSize);
+          for (size_t b = 0; b < width; ++b)
+          {
+            for (size_t s = 0; s < nbStates_; ++s)
+              counts_[(j0 + b) * nbStates_ + s] = counters[s * blockSize + b];
+            gaps_[j0 + b] = counters[nbStates_ * blockSize + b];
+          }
+        }
+      });
+    }
+
+    /*
+     * Each site is counted by chunks of at most BLOCK_SIZE states, into BLOCK_SIZE counters per slot, which are summed at the end.
+     */
+    void countColumns_(ThreadPool& pool, const std::vector<const int*>& columns)
+    {
+      pool.parallelFor(nbSites_, [&](size_t begin, size_t end) {
+        std::vector<int> values;
+        std::vector<uint32_t> table;
+        getSlotValues_(values);
+        getSlotTable_(table);
+        size_t nbSlots = getNumberOfSlots_();
+        size_t width = std::min(static_cast<size_t>(BLOCK_SIZE), nbSequences_);
+        std::vector<uint32_t> counters(nbSlots * width);
+        for (size_t j = begin; j < end; ++j)
+        {
+          std::fill(counters.begin(), counters.end(), 0);
+          for (size_t i0 = 0; i0 < nbSequences_; i0 += width)
+            accumulate_(columns[j] + i0, std::min(width, nbSequences_ - i0), values, table, &counters[0], width);
+          for (size_t s = 0; s <= nbStates_; ++s)
+          {
+            uint32_t total = 0;
+            for (size_t b = 0; b < width; ++b)
+              total += counters[s * width + b];
+            if (s < nbStates_)
+              counts_[j * nbStates_ + s] = total;
+            else
+              gaps_[j] = total;
+          }
+        }
+      }, 64);
+    }
+
+    /*
+     * In a word of packed states, the lanes equal to a given state are found by xoring the word with the state
+     * repeated in all lanes: matching lanes are then 0, and the bits of each lane are folded with shifts to find them.
+     * With 2 bits, states are 0 to 3 and there are no gaps. With 4 bits, state c is stored as c + 1, and the gap as 0.
+     */
+    static inline void countWords_(const uint64_t* words, size_t nbWords, unsigned int bits, uint64_t lastMask, uint32_t* counts, size_t nbSlots)
+    {
+      uint64_t low = (bits == 2 ? 0x5555555555555555ULL : 0x1111111111111111ULL);
+      for (size_t s = 0; s < nbSlots; ++s)
+      {
+        //Slot s is state s, and the last slot is the gap with 4 bits:
+        uint64_t code = (bits == 2 ? s : (s < 4 ? s + 1 : 0));
+        uint64_t pattern = code * low;
+        uint32_t total = 0;
+        for (size_t w = 0; w < nbWords; ++w)
+        {
+          uint64_t x = words[w] ^ pattern;
+          x |= (x >> 1);
+          if (bits == 4)
+            x |= (x >> 2);
+          uint64_t matches = ~x & low;
+          if (w + 1 == nbWords)
+            matches &= lastMask;
+          total += static_cast<uint32_t>(__builtin_popcountll(matches));
+        }
+        counts[s] = total;
+      }
+    }
+
+#ifdef BPP_SIMD_X86
+    BPP_TARGET_AVX2
+    static void countWordsAvx2_(const uint64_t* words, size_t nbWords, unsigned int bits, uint64_t lastMask, uint32_t* counts, size_t nbSlots)
+    {
+      countWords_(words, nbWords, bits, lastMask, counts, nbSlots);
+    }
+#endif
+
+    void countPacked_(ThreadPool& pool, const PackedAlignment& sites)
+    {
+      if (nbSequences_ == 0)
+        return;
+      unsigned int bits = sites.getNumberOfBitsPerState();
+      size_t perWord = 64 / bits;
+      size_t wordsPerSite = sites.getNumberOfWordsPerSite();
+      size_t lastLanes = nbSequences_ - (wordsPerSite - 1) * perWord;
+      uint64_t lastMask = (lastLanes * bits == 64 ? ~0ULL : (1ULL << (lastLanes * bits)) - 1);
+      size_t nbSlots = (bits == 2 ? 4 : 5);
+      const uint64_t* words = &sites.getWords()[0];
+      pool.parallelFor(nbSites_, [&](size_t begin, size_t end) {
+        uint32_t counts[5] = { 0, 0, 0, 0, 0 };
+        for (size_t j = begin; j < end; ++j)
+        {
+#ifdef BPP_SIMD_X86
+          if (level_ == SIMD_AVX2)
+            countWordsAvx2_(words + j * wordsPerSite, wordsPerSite, bits, lastMask, counts, nbSlots);
+          else
+#endif
+          countWords_(words + j * wordsPerSite, wordsPerSite, bits, lastMask, counts, nbSlots);
+          std::copy(counts, counts + 4, counts_.begin() + static_cast<ptrdiff_t>(j * 4));
+          gaps_[j] = counts[4];
+        }
+      }, BLOCK_SIZE);
+    }
+
+    /*
+     * Derive all other statistics from the counts. The entropy of a site with R resolved states, c_k of them being k, is
+     * -sum_k c_k / R log(c_k / R) = log(R) - sum_k c_k log(c_k) / R, with c log(c) taken in a precomputed table.
+     */
+    void finish_(ThreadPool& pool)
+    {
+      std::vector<double> cLogC(nbSequences_ + 1, 0.);
+      for (size_t c = 2; c <= nbSequences_; ++c)
+        cLogC[c] = static_cast<double>(c) * std::log(static_cast<double>(c));
+      double n = static_cast<double>(nbSequences_);
+      pool.parallelFor(nbSites_, [&](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; ++j)
+        {
+          const uint32_t* c = &counts_[j * nbStates_];
+          uint32_t resolved = 0, distinct = 0;
+          double sum = 0.;
+          for (size_t s = 0; s < nbStates_; ++s)
+          {
+            resolved += c[s];
+            distinct += (c[s] > 0 ? 1 : 0);
+            sum += cLogC[c[s]];
+          }
+          unknowns_[j] = static_cast<uint32_t>(nbSequences_) - resolved - gaps_[j];
+          gapFractions_[j] = static_cast<double>(gaps_[j]) / n;
+          unknownFractions_[j] = static_cast<double>(unknowns_[j]) / n;
+          //Rounding errors can give tiny negative values for constant sites:
+          entropies_[j] = (resolved > 0 ? std::max(0., std::log(static_cast<double>(resolved)) - sum / static_cast<double>(resolved)) : 0.);
+          constant_[j] = (distinct == 1 ? 1 : 0);
+        }
+      }, 4096);
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_SITESTATISTICS_H_
@@ -0,0 +1,169 @@
+/*
+ * File: ExSiteStream.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 11:30 2026
+ *
+ * Computing site-wise statistics without loading the whole alignment in memory.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ * - The alignment to read can be given as an argument, by default the alignment from ExContainer is used.
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <map>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * To measure the memory used by the program:
+ */
+#include <sys/resource.h>
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+#include <Bpp/Seq/SymbolListTools.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * And the site stream, in this directory:
+ */
+#include "FastaSiteStream.h"
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * The peak resident memory of the program so far, in kilobytes.
+ */
+long getPeakRSS()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/*
+ * The statistics we compute for each site: nucleotide frequencies (ignoring gaps and unknown characters)
+ * and the proportion of gaps. Their sum over all sites is used to check that both methods agree.
+ */
+void addSiteStatistics(const Site& site, vector<double>& sums)
+{
+  map<int, double> freqs;
+  SymbolListTools::getFrequencies(site, freqs);
+  double resolved = 0;
+  for (int state = 0; state < 4; state++)
+    resolved += freqs[state];
+  for (int state = 0; state < 4; state++)
+    sums[static_cast<size_t>(state)] += (resolved > 0 ? freqs[state] / resolved : 0);
+  sums[4] += freqs[-1];
+}
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    string path = (args > 1 ? argv[1] : "../ExContainer/TIMnuc.aln.fasta");
+    long initialRSS = getPeakRSS();
+
+    /*
+     * A FastaSiteStream reads an aligned Fasta file by blocks of sites.
+     * It only keeps the names of the sequences and their position in the file,
+     * so that at most one block of sites is in memory at any time:
+     */
+    FastaSiteStream stream(path, &AlphabetTools::DNA_ALPHABET, 100);
+    cout << "This alignment has " << stream.getNumberOfSequences() << " sequences and " << stream.getNumberOfSites() << " sites." << endl;
+
+    vector<double> streamSums(5, 0.);
+    while (stream.hasMoreSites())
+    {
+      const vector<const Site*>& block = stream.nextBlock();
+      for (size_t i = 0; i < block.size(); i++)
+      {
+        addSiteStatistics(*block[i], streamSums);
+        if (block[i]->getPosition() <= 3)
+        {
+          map<int, double> freqs;
+          SymbolListTools::getFrequencies(*block[i], freqs);
+          cout << "Site " << block[i]->getPosition() << ": A=" << freqs[0] << " C=" << freqs[1] << " G=" << freqs[2] << " T=" << freqs[3] << " gap=" << freqs[-1] << endl;
+        }
+      }
+    }
+    long streamRSS = getPeakRSS();
+
+    /*
+     * The same statistics, computed the usual way, by loading all sequences
+     * and converting them to a VectorSiteContainer:
+     * (the peak memory can only increase, so we do this second)
+     */
+    Fasta fasReader;
+    OrderedSequenceContainer* sequences = fasReader.readSequences(path, &AlphabetTools::DNA_ALPHABET);
+    SiteContainer* sites = new VectorSiteContainer(*sequences);
+    vector<double> vscSums(5, 0.);
+    for (size_t i = 0; i < sites->getNumberOfSites(); i++)
+      addSiteStatistics(sites->getSite(i), vscSums);
+    long vscRSS = getPeakRSS();
+    delete sequences;
+    delete sites;
+
+    bool identical = true;
+    for (size_t k = 0; k < 5; k++)
+      identical = identical && (streamSums[k] == vscSums[k]);
+    cout << "Do both methods give the same frequencies? " << (identical ? "yes" : "no") << endl;
+    cout << "Mean gap proportion per site: " << streamSums[4] / static_cast<double>(stream.getNumberOfSites()) << endl;
+
+    ApplicationTools::displayResult("Peak RSS at start (kB)", initialRSS);
+    ApplicationTools::displayResult("Peak RSS with FastaSiteStream (kB)", streamRSS);
+    ApplicationTools::displayResult("Peak RSS with VectorSiteContainer (kB)", vscRSS);
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
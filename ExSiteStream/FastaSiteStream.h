@@ -0,0 +1,230 @@
+/*
+ * File: FastaSiteStream.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 11:30 2026
+ *
+ * Reading an aligned Fasta file site by site, with bounded memory.
+ */
+
+#ifndef _FASTASITESTREAM_H_
+#define _FASTASITESTREAM_H_
+
+#include "MappedFasta.h" /* from ExContainer, for the CharacterTable class */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Site.h>
+
+#include <cctype>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Read the sites of an aligned Fasta file by blocks of consecutive columns.
+   *
+   * When the stream is opened, the file is scanned once to record the names of the sequences
+   * and the file offset where each of them starts. Blocks of sites are then built by reading,
+   * for each sequence, the next few characters from its current offset.
+   * Only one block of sites is ever in memory, so that memory usage is proportional to
+   * the number of sequences times the block size, whatever the length of the alignment.
+   *
+   * Example:
+   * @code
+   * FastaSiteStream stream("align.fasta", &AlphabetTools::DNA_ALPHABET, 1000);
+   * while (stream.hasMoreSites())
+   * {
+   *   const std::vector<const Site*>& block = stream.nextBlock();
+   *   for (size_t i = 0; i < block.size(); ++i)
+   *     ...
+   * }
+   * @endcode
+   */
+  class FastaSiteStream
+  {
+  private:
+    const Alphabet* alphabet_;
+    size_t blockSize_;
+    std::ifstream input_;
+    std::vector<std::string> names_;
+    std::vector<std::streamoff> cursors_;
+    size_t nbSites_;
+    size_t position_;
+    CharacterTable table_;
+    std::vector<int> rows_; //the current block, row-major
+    std::vector<char> buffer_;
+    std::vector<Site*> sites_;
+    std::vector<const Site*> block_;
+
+  public:
+    /**
+     * @param path      The aligned Fasta file to read.
+     * @param alphabet  The alphabet to use. Must have one character per state.
+     * @param blockSize The number of sites per block.
+     * @throw IOException If the file can't be read.
+     * @throw Exception If the alphabet has more than one character per state.
+     */
+    FastaSiteStream(const std::string& path, const Alphabet* alphabet, size_t blockSize = 1000) :
+      alphabet_(alphabet),
+      blockSize_(blockSize > 0 ? blockSize : 1),
+      input_(path.c_str(), std::ios::in | std::ios::binary),
+      names_(),
+      cursors_(),
+      nbSites_(0),
+      position_(0),
+      table_(alphabet),
+      rows_(),
+      buffer_(),
+      sites_(),
+      block_()
+    {
+      if (!input_)
+        throw IOException("FastaSiteStream: can't open file " + path);
+      index_();
+    }
+
+    ~FastaSiteStream() { clearBlock_(); }
+
+  private:
+    FastaSiteStream(const FastaSiteStream&);
+    FastaSiteStream& operator=(const FastaSiteStream&);
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t getNumberOfSequences() const { return names_.size(); }
+    const std::vector<std::string>& getSequencesNames() const { return names_; }
+
+    /**
+     * @return The number of sites in the alignment, that is, the length of the first sequence.
+     */
+    size_t getNumberOfSites() const { return nbSites_; }
+
+    /**
+     * @return The index of the first site of the next block.
+     */
+    size_t getPosition() const { return position_; }
+
+    bool hasMoreSites() const { return position_ < nbSites_; }
+
+    /**
+     * @brief Read the next block of sites.
+     *
+     * @return The sites of the block. They are owned by the stream and remain valid until the next call.
+     * Sites positions start at 1, as in the containers.
+     * @throw Exception If the sequences are not aligned, or contain characters not in the alphabet.
+     */
+    const std::vector<const Site*>& nextBlock()
+    {
+      clearBlock_();
+      size_t nbSeq = names_.size();
+      size_t width = std::min(blockSize_, nbSites_ - position_);
+      rows_.resize(nbSeq * width);
+      for (size_t i = 0; i < nbSeq; ++i)
+        readRow_(i, width, &rows_[i * width]);
+
+      std::vector<int> column(nbSeq);
+      for (size_t j = 0; j < width; ++j)
+      {
+        for (size_t i = 0; i < nbSeq; ++i)
+          column[i] = rows_[i * width + j];
+        sites_.push_back(new Site(column, alphabet_, static_cast<int>(position_ + j + 1)));
+        block_.push_back(sites_.back());
+      }
+      position_ += width;
+      if (!hasMoreSites())
+        checkEnd_();
+      return block_;
+    }
+
+  private:
+    void clearBlock_()
+    {
+      for (size_t i = 0; i < sites_.size(); ++i)
+        delete sites_[i];
+      sites_.clear();
+      block_.clear();
+    }
+
+    /*
+     * Read 'width' states of sequence i from its cursor, and advance the cursor.
+     */
+    void readRow_(size_t i, size_t width, int* row)
+    {
+      size_t n = 0;
+      input_.clear();
+      input_.seekg(cursors_[i]);
+      while (n < width)
+      {
+        //Residues are at most as many as bytes, so never read more than needed + a few line breaks:
+        buffer_.resize(width - n + 64);
+        input_.read(&buffer_[0], static_cast<std::streamsize>(buffer_.size()));
+        size_t nread = static_cast<size_t>(input_.gcount());
+        if (nread == 0)
+          throw Exception("FastaSiteStream::nextBlock. Sequence " + names_[i] + " is shorter than the first one.");
+        size_t k = 0;
+        for ( ; k < nread && n < width; ++k)
+        {
+          unsigned char c = static_cast<unsigned char>(buffer_[k]);
+          int code = table_[c];
+          if (code != CharacterTable::UNDEFINED)
+            row[n++] = code;
+          else if (c == '>')
+            throw Exception("FastaSiteStream::nextBlock. Sequence " + names_[i] + " is shorter than the first one.");
+          else if (!isspace(c))
+            throw BadCharException(std::string(1, static_cast<char>(c)), "FastaSiteStream::nextBlock. In sequence " + names_[i], alphabet_);
+        }
+        cursors_[i] += static_cast<std::streamoff>(k);
+      }
+    }
+
+    /*
+     * After the last block, check that no sequence has remaining states.
+     */
+    void checkEnd_()
+    {
+      for (size_t i = 0; i < names_.size(); ++i)
+      {
+        input_.clear();
+        input_.seekg(cursors_[i]);
+        char c;
+        while (input_.get(c) && c != '>')
+        {
+          if (!isspace(static_cast<unsigned char>(c)))
+            throw Exception("FastaSiteStream::nextBlock. Sequence " + names_[i] + " is longer than the first one.");
+        }
+      }
+    }
+
+    /*
+     * One pass over the file, to get the sequence names and starting offsets,
+     * and the length of the first sequence.
+     */
+    void index_()
+    {
+      std::string line;
+      std::streamoff offset = 0;
+      while (std::getline(input_, line))
+      {
+        std::streamoff next = offset + static_cast<std::streamoff>(line.size()) + 1;
+        if (!line.empty() && line[0] == '>')
+        {
+          size_t end = line.find_last_not_of(" \t\r");
+          names_.push_back(line.substr(1, end == std::string::npos ? 0 : end));
+          cursors_.push_back(next);
+        }
+        else if (names_.size() == 1)
+        {
+          for (size_t k = 0; k < line.size(); ++k)
+            if (!isspace(static_cast<unsigned char>(line[k])))
+              ++nbSites_;
+        }
+        offset = next;
+      }
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_FASTASITESTREAM_H_
@@ -0,0 +1,179 @@
+/*
+ * File: ExSymbolView.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 02:30 2026
+ *
+ * Looking at parts of sequences and alignments without copying them.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <string>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/SequenceTools.h>
+#include <Bpp/Seq/SiteTools.h>
+#include <Bpp/Seq/SymbolListTools.h>
+#include <Bpp/Seq/Container/AlignedSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+#include <Bpp/Seq/Io/Fasta.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * The views and their statistics, in this directory, and the allocation counters and
+ * synthetic alignments of ExBenchmark:
+ */
+#include "SymbolView.h"
+#include "ViewTools.h"
+#include "AllocationCounter.h" /* from ExBenchmark */
+#include "SyntheticAlignment.h" /* from ExBenchmark */
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * SequenceTools::subseq creates a new sequence, with a copy of the selected positions.
+     * A SymbolView points to the positions instead, in the original sequence.
+     * Note that the end position of a view is excluded, while the one of subseq is included:
+     */
+    BasicSequence sequence("My first sequence", "GATTACAATGATTACATGGT", &AlphabetTools::DNA_ALPHABET);
+    Sequence* subSequence = SequenceTools::subseq(sequence, 6, 8);
+    SymbolView view(sequence, 6, 9);
+    cout << "SubSeq: " << subSequence->toString() << ", view: " << view.toString() << endl;
+    delete subSequence;
+
+    /*
+     * Views have the read methods of sequences and sites (size, getValue, operator[], getChar, toString),
+     * and the ViewTools class has the statistics of the SymbolListTools, SiteTools and SequenceTools classes.
+     * They take views, but also sequences and sites:
+     */
+    cout << "GC content of the view: " << ViewTools::getGCContent(view) << endl;
+    cout << "GC content of the sequence: " << ViewTools::getGCContent(sequence) << endl;
+
+    /*
+     * Unresolved nucleotides can be counted too: each of them then counts as G or C
+     * in proportion of the nucleotides it stands for (S is G or C, N is any).
+     */
+    BasicSequence ambiguous("Ambiguous", "GCNNSAT", &AlphabetTools::DNA_ALPHABET);
+    cout << "GC content with unresolved nucleotides: " << ViewTools::getGCContent(ambiguous, false) << endl;
+    cout << "Same as SymbolListTools? " << (ViewTools::getGCContent(ambiguous, false) == SymbolListTools::getGCContent(ambiguous, false) ? "yes" : "no") << endl;
+
+    /*
+     * Containers give views too, through a SequenceViews or SiteViews object created once for the container.
+     * In an AlignedSequenceContainer, sequences are viewed in place, and sites are columns across them.
+     * In a VectorSiteContainer, this is the other way round.
+     */
+    Fasta fasReader;
+    OrderedSequenceContainer* sequences = fasReader.readSequences("../ExContainer/TIMnuc.aln.fasta", &AlphabetTools::DNA_ALPHABET);
+    AlignedSequenceContainer align(*sequences);
+    VectorSiteContainer sites(*sequences);
+    delete sequences;
+    SequenceViews alignViews(align);
+    SiteViews siteViews(sites);
+
+    size_t withGaps = 0, withGapsFromViews = 0, withGapsFromSiteViews = 0;
+    for (size_t j = 0; j < sites.getNumberOfSites(); j++)
+    {
+      if (SiteTools::hasGap(sites.getSite(j))) withGaps++;
+      if (ViewTools::hasGap(alignViews.getSite(j))) withGapsFromViews++;
+      if (ViewTools::hasGap(siteViews.getSite(j))) withGapsFromSiteViews++;
+    }
+    cout << "Number of sites with gaps: " << withGaps << " (SiteTools), " << withGapsFromViews << " (views on sequences), "
+         << withGapsFromSiteViews << " (views on sites)" << endl;
+    cout << "Identity between the first two sequences: "
+         << ViewTools::getPercentIdentity(siteViews.getSequence(0), siteViews.getSequence(1), true) << "%" << endl;
+
+    /*
+     * Views are especially useful for sliding windows: each window is a new view,
+     * which costs nothing, where subseq copies the window into a new sequence.
+     * Let's compute the GC content of all windows of 100 positions, in a synthetic alignment:
+     */
+    size_t windowSize = 100;
+    VectorSequenceContainer* synthetic = SyntheticAlignment::generate(20, 50000, &AlphabetTools::DNA_ALPHABET); /* WATCHOUT!!! reduce these numbers if this is too slow on your computer! */
+    size_t nbSites = synthetic->getSequence(0).size();
+
+    double sum1 = 0;
+    AllocationSnapshot before = AllocationCounter::getSnapshot();
+    ApplicationTools::startTimer();
+    for (size_t i = 0; i < synthetic->getNumberOfSequences(); i++)
+    {
+      for (size_t j = 0; j + windowSize <= nbSites; j++)
+      {
+        Sequence* window = SequenceTools::subseq(synthetic->getSequence(i), j, j + windowSize - 1);
+        sum1 += SymbolListTools::getGCContent(*window);
+        delete window;
+      }
+    }
+    ApplicationTools::displayTime("Time used with subseq:");
+    ApplicationTools::displayResult("Number of allocations", AllocationCounter::getDifference(before).numberOfAllocations);
+
+    double sum2 = 0;
+    before = AllocationCounter::getSnapshot();
+    ApplicationTools::startTimer();
+    SequenceViews views(*synthetic);
+    for (size_t i = 0; i < views.getNumberOfSequences(); i++)
+    {
+      for (size_t j = 0; j + windowSize <= nbSites; j++)
+        sum2 += ViewTools::getGCContent(views.getSequence(i, j, j + windowSize));
+    }
+    ApplicationTools::displayTime("Time used with views:");
+    ApplicationTools::displayResult("Number of allocations", AllocationCounter::getDifference(before).numberOfAllocations);
+    cout << "Same results? " << (sum1 == sum2 ? "yes" : "no") << endl;
+    delete synthetic;
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
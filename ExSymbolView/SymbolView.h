@@ -0,0 +1,296 @@
+/*
+ * File: SymbolView.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 02:30 2026
+ *
+ * Read-only views on the states stored in sequences, sites and containers, without copies.
+ */
+
+#ifndef _SYMBOLVIEW_H_
+#define _SYMBOLVIEW_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/SymbolList.h>
+#include <Bpp/Seq/SequenceExceptions.h>
+#include <Bpp/Seq/Container/VectorSequenceContainer.h>
+#include <Bpp/Seq/Container/VectorSiteContainer.h>
+
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A read-only view on states stored at regular intervals in memory.
+   *
+   * With a stride of 1, this is a slice of a sequence or of a site, pointing into its content.
+   * With a stride of n, this is a column of a row-major matrix with n columns.
+   *
+   * As PackedSequence, this class mirrors the read methods of the SymbolList interface
+   * (size, getValue, operator[], getChar, toString, getAlphabet) instead of implementing it:
+   * the interface returns its content as a vector, which would require a copy.
+   * A view is only valid as long as the storage it points to is not modified.
+   */
+  class SymbolView
+  {
+  private:
+    const int* data_;
+    size_t size_;
+    size_t stride_;
+    const Alphabet* alphabet_;
+
+  public:
+    SymbolView(const int* data, size_t size, const Alphabet* alphabet, size_t stride = 1) :
+      data_(data), size_(size), stride_(stride), alphabet_(alphabet)
+    {}
+
+    /**
+     * @brief View on a whole sequence or site.
+     */
+    explicit SymbolView(const SymbolList& list) :
+      data_(list.size() > 0 ? &list.getContent()[0] : 0), size_(list.size()), stride_(1), alphabet_(list.getAlphabet())
+    {}
+
+    /**
+     * @brief View on positions [begin, end) of a sequence or site.
+     *
+     * @throw IndexOutOfBoundsException If the positions are not in the list.
+     */
+    SymbolView(const SymbolList& list, size_t begin, size_t end) :
+      data_(0), size_(0), stride_(1), alphabet_(list.getAlphabet())
+    {
+      if (begin > end || end > list.size())
+        throw IndexOutOfBoundsException("SymbolView. Bad slice.", end, begin, list.size());
+      data_ = (end > begin ? &list.getContent()[begin] : 0);
+      size_ = end - begin;
+    }
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t size() const { return size_; }
+    size_t getStride() const { return stride_; }
+    int operator[](size_t i) const { return data_[i * stride_]; }
+
+    int getValue(size_t i) const
+    {
+      if (i >= size_)
+        throw IndexOutOfBoundsException("SymbolView::getValue.", i, 0, size_ - 1);
+      return data_[i * stride_];
+    }
+
+    std::string getChar(size_t i) const { return alphabet_->intToChar(getValue(i)); }
+
+    std::string toString() const
+    {
+      std::string s;
+      for (size_t i = 0; i < size_; ++i)
+        s += alphabet_->intToChar(data_[i * stride_]);
+      return s;
+    }
+
+    /**
+     * @return A view on positions [begin, end) of this view.
+     */
+    SymbolView getSlice(size_t begin, size_t end) const
+    {
+      if (begin > end || end > size_)
+        throw IndexOutOfBoundsException("SymbolView::getSlice.", end, begin, size_);
+      return SymbolView(data_ + begin * stride_, end - begin, alphabet_, stride_);
+    }
+  };
+
+  /**
+   * @brief A read-only view on the states found at the same position in a set of lists.
+   *
+   * This is a site of a container storing sequences, or a sequence of a container storing sites:
+   * state i is position 'column' of the ith list. The table of pointers to the lists is shared,
+   * and owned by the object which created the view (see SequenceViews and SiteViews).
+   */
+  class ColumnView
+  {
+  private:
+    const int* const* lists_;
+    size_t size_;
+    size_t column_;
+    const Alphabet* alphabet_;
+
+  public:
+    ColumnView(const int* const* lists, size_t size, size_t column, const Alphabet* alphabet) :
+      lists_(lists), size_(size), column_(column), alphabet_(alphabet)
+    {}
+
+  public:
+    const Alphabet* getAlphabet() const { return alphabet_; }
+    size_t size() const { return size_; }
+    size_t getColumn() const { return column_; }
+    int operator[](size_t i) const { return lists_[i][column_]; }
+
+    int getValue(size_t i) const
+    {
+      if (i >= size_)
+        throw IndexOutOfBoundsException("ColumnView::getValue.", i, 0, size_ - 1);
+      return lists_[i][column_];
+    }
+
+    std::string getChar(size_t i) const { return alphabet_->intToChar(getValue(i)); }
+
+    std::string toString() const
+    {
+      std::string s;
+      for (size_t i = 0; i < size_; ++i)
+        s += alphabet_->intToChar(lists_[i][column_]);
+      return s;
+    }
+
+    /**
+     * @return A view on lists [begin, end) of this view.
+     */
+    ColumnView getSlice(size_t begin, size_t end) const
+    {
+      if (begin > end || end > size_)
+        throw IndexOutOfBoundsException("ColumnView::getSlice.", end, begin, size_);
+      return ColumnView(lists_ + begin, end - begin, column_, alphabet_);
+    }
+  };
+
+  /**
+   * @brief View accessors for the containers storing sequences: VectorSequenceContainer and AlignedSequenceContainer.
+   *
+   * Sequences are viewed in place, and sites as columns across the sequences.
+   * The table of pointers to the sequences is built once, when this object is created:
+   * views are then returned without any allocation. They are valid as long as the container is not modified.
+   */
+  class SequenceViews
+  {
+  private:
+    const Alphabet* alphabet_;
+    std::vector<const int*> rows_;
+    std::vector<size_t> lengths_;
+    size_t nbSites_;
+    bool aligned_;
+
+  public:
+    SequenceViews(const VectorSequenceContainer& sequences) :
+      alphabet_(sequences.getAlphabet()), rows_(sequences.getNumberOfSequences()), lengths_(sequences.getNumberOfSequences()),
+      nbSites_(0), aligned_(true)
+    {
+      for (size_t i = 0; i < rows_.size(); ++i)
+      {
+        const Sequence& sequence = sequences.getSequence(i);
+        rows_[i] = sequence.size() > 0 ? &sequence.getContent()[0] : 0;
+        lengths_[i] = sequence.size();
+        if (i == 0)
+          nbSites_ = sequence.size();
+        else if (sequence.size() != nbSites_)
+          aligned_ = false;
+      }
+    }
+
+  public:
+    size_t getNumberOfSequences() const { return rows_.size(); }
+
+    /**
+     * @return The number of sites, if sequences all have the same length.
+     * @throw SequenceNotAlignedException If they do not.
+     */
+    size_t getNumberOfSites() const
+    {
+      checkAligned_();
+      return nbSites_;
+    }
+
+    SymbolView getSequence(size_t i) const
+    {
+      checkSequence_(i);
+      return SymbolView(rows_[i], lengths_[i], alphabet_);
+    }
+
+    /**
+     * @return A view on positions [begin, end) of the ith sequence.
+     */
+    SymbolView getSequence(size_t i, size_t begin, size_t end) const
+    {
+      return getSequence(i).getSlice(begin, end);
+    }
+
+    /**
+     * @throw SequenceNotAlignedException If sequences do not all have the same length.
+     */
+    ColumnView getSite(size_t j) const
+    {
+      checkAligned_();
+      if (j >= nbSites_)
+        throw IndexOutOfBoundsException("SequenceViews::getSite.", j, 0, nbSites_ - 1);
+      return ColumnView(rows_.empty() ? 0 : &rows_[0], rows_.size(), j, alphabet_);
+    }
+
+  private:
+    void checkSequence_(size_t i) const
+    {
+      if (i >= rows_.size())
+        throw IndexOutOfBoundsException("SequenceViews::getSequence.", i, 0, rows_.size() - 1);
+    }
+
+    void checkAligned_() const
+    {
+      if (!aligned_)
+        throw SequenceNotAlignedException("SequenceViews. Sequences do not all have the same length.", 0);
+    }
+  };
+
+  /**
+   * @brief View accessors for VectorSiteContainer.
+   *
+   * Sites are viewed in place, and sequences as columns across the sites.
+   * As for SequenceViews, views are returned without any allocation, and are valid as long as
+   * the container is not modified.
+   */
+  class SiteViews
+  {
+  private:
+    const Alphabet* alphabet_;
+    std::vector<const int*> columns_;
+    size_t nbSequences_;
+
+  public:
+    SiteViews(const VectorSiteContainer& sites) :
+      alphabet_(sites.getAlphabet()), columns_(sites.getNumberOfSites()), nbSequences_(sites.getNumberOfSequences())
+    {
+      for (size_t j = 0; j < columns_.size(); ++j)
+        columns_[j] = nbSequences_ > 0 ? &sites.getSite(j).getContent()[0] : 0;
+    }
+
+  public:
+    size_t getNumberOfSequences() const { return nbSequences_; }
+    size_t getNumberOfSites() const { return columns_.size(); }
+
+    SymbolView getSite(size_t j) const
+    {
+      if (j >= columns_.size())
+        throw IndexOutOfBoundsException("SiteViews::getSite.", j, 0, columns_.size() - 1);
+      return SymbolView(columns_[j], nbSequences_, alphabet_);
+    }
+
+    /**
+     * @return A view on the ith sequence, across all sites.
+     */
+    ColumnView getSequence(size_t i) const
+    {
+      if (i >= nbSequences_)
+        throw IndexOutOfBoundsException("SiteViews::getSequence.", i, 0, nbSequences_ - 1);
+      return ColumnView(columns_.empty() ? 0 : &columns_[0], columns_.size(), i, alphabet_);
+    }
+
+    /**
+     * @return A view on sites [begin, end) of the ith sequence.
+     */
+    ColumnView getSequence(size_t i, size_t begin, size_t end) const
+    {
+      return getSequence(i).getSlice(begin, end);
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_SYMBOLVIEW_H_
@@ -0,0 +1,251 @@
+/*
+ * File: ViewTools.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Sat 17 02:30 2026
+ *
+ * Statistics on sequences, sites and views, without allocation.
+ */
+
+#ifndef _VIEWTOOLS_H_
+#define _VIEWTOOLS_H_
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Alphabet/Alphabet.h>
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief Statistics functions of SymbolListTools, SiteTools and SequenceTools, for any list of states.
+   *
+   * The functions are templates: they accept SymbolView and ColumnView objects, but also
+   * Sequence and Site objects, and PackedSequence. Any class with size(), operator[] and getAlphabet() will do.
+   * None of them allocates memory, except the ones filling a map, so that they can be called
+   * on millions of windows.
+   */
+  class ViewTools
+  {
+  public:
+    /**
+     * @brief Count the states of a list, adding them to a map as SymbolListTools::getCounts does.
+     */
+    template<class List, class count_type>
+    static void getCounts(const List& list, std::map<int, count_type>& counts)
+    {
+      for (size_t i = 0; i < list.size(); ++i)
+        counts[list[i]]++;
+    }
+
+    /**
+     * @brief Count the states of a list.
+     *
+     * @param list   The list.
+     * @param counts [out] The counts, indexed by state + 1 (the gap is at index 0). Previous values are reset.
+     * The vector is enlarged if needed, but never shrunk: reusing the same vector does not allocate.
+     */
+    template<class List>
+    static void getCounts(const List& list, std::vector<size_t>& counts)
+    {
+      std::fill(counts.begin(), counts.end(), 0);
+      for (size_t i = 0; i < list.size(); ++i)
+      {
+        size_t k = static_cast<size_t>(list[i] + 1);
+        if (k >= counts.size())
+          counts.resize(k + 1, 0);
+        counts[k]++;
+      }
+    }
+
+    /**
+     * @return The proportion of G and C among the nucleotides of a list.
+     *
+     * @param list             The list, with a DNA or RNA alphabet.
+     * @param ignoreUnresolved If false, unresolved nucleotides are counted in the total, and each of them
+     *                         adds the proportion of G and C among the nucleotides it stands for,
+     *                         as given by Alphabet::getAlias (1 for S, 0.5 for N).
+     * @param ignoreGap        If false, gaps are counted in the total, as non-GC.
+     * @throw AlphabetException If the list is not a nucleotide list.
+     */
+    template<class List>
+    static double getGCContent(const List& list, bool ignoreUnresolved = true, bool ignoreGap = true)
+    {
+      const Alphabet* alphabet = list.getAlphabet();
+      if (!AlphabetTools::isNucleicAlphabet(alphabet))
+        throw AlphabetException("ViewTools::getGCContent. Method only works on nucleotides.", alphabet);
+      size_t gc = 0, resolved = 0, gaps = 0;
+      //Unresolved states are counted by state, and their aliases are only looked up once per state:
+      std::vector<size_t> unresolved;
+      for (size_t i = 0; i < list.size(); ++i)
+      {
+        int state = list[i];
+        if (state == 1 || state == 2)
+          ++gc;
+        if (state >= 0 && state <= 3)
+          ++resolved;
+        else if (state == -1)
+          ++gaps;
+        else if (!ignoreUnresolved)
+        {
+          size_t k = static_cast<size_t>(state);
+          if (k >= unresolved.size())
+            unresolved.resize(k + 1, 0);
+          unresolved[k]++;
+        }
+      }
+      double total = static_cast<double>(resolved + (ignoreGap ? 0 : gaps));
+      double gcWeight = static_cast<double>(gc);
+      for (size_t k = 0; k < unresolved.size(); ++k)
+      {
+        if (unresolved[k] == 0)
+          continue;
+        std::vector<int> alias = alphabet->getAlias(static_cast<int>(k));
+        size_t nbGC = 0;
+        for (size_t a = 0; a < alias.size(); ++a)
+        {
+          if (alias[a] == 1 || alias[a] == 2)
+            ++nbGC;
+        }
+        total += static_cast<double>(unresolved[k]);
+        if (!alias.empty())
+          gcWeight += static_cast<double>(unresolved[k]) * static_cast<double>(nbGC) / static_cast<double>(alias.size());
+      }
+      return total > 0 ? gcWeight / total : 0.;
+    }
+
+    /**
+     * @return The number of positions where two lists have different states.
+     * @throw BadSizeException If the lists do not have the same size.
+     */
+    template<class List1, class List2>
+    static size_t getNumberOfDistinctPositions(const List1& l1, const List2& l2)
+    {
+      checkSizes_(l1, l2, "ViewTools::getNumberOfDistinctPositions");
+      size_t n = 0;
+      for (size_t i = 0; i < l1.size(); ++i)
+        if (l1[i] != l2[i])
+          ++n;
+      return n;
+    }
+
+    /**
+     * @return The number of positions where neither of two lists has a gap.
+     * @throw BadSizeException If the lists do not have the same size.
+     */
+    template<class List1, class List2>
+    static size_t getNumberOfPositionsWithoutGap(const List1& l1, const List2& l2)
+    {
+      checkSizes_(l1, l2, "ViewTools::getNumberOfPositionsWithoutGap");
+      size_t n = 0;
+      for (size_t i = 0; i < l1.size(); ++i)
+        if (l1[i] != -1 && l2[i] != -1)
+          ++n;
+      return n;
+    }
+
+    /**
+     * @return The percentage of identical positions between two lists.
+     *
+     * @param l1         The first list.
+     * @param l2         The second list.
+     * @param ignoreGaps If true, positions with a gap in either list are not counted.
+     * @throw BadSizeException If the lists do not have the same size.
+     */
+    template<class List1, class List2>
+    static double getPercentIdentity(const List1& l1, const List2& l2, bool ignoreGaps = false)
+    {
+      checkSizes_(l1, l2, "ViewTools::getPercentIdentity");
+      size_t identical = 0, total = 0;
+      for (size_t i = 0; i < l1.size(); ++i)
+      {
+        int x = l1[i], y = l2[i];
+        if (ignoreGaps && (x == -1 || y == -1))
+          continue;
+        ++total;
+        if (x == y)
+          ++identical;
+      }
+      return total > 0 ? 100. * static_cast<double>(identical) / static_cast<double>(total) : 0.;
+    }
+
+    /**
+     * @return True if the list contains at least one gap.
+     */
+    template<class List>
+    static bool hasGap(const List& list)
+    {
+      for (size_t i = 0; i < list.size(); ++i)
+        if (list[i] == -1)
+          return true;
+      return false;
+    }
+
+    /**
+     * @return True if the list only contains gaps.
+     */
+    template<class List>
+    static bool isGapOnly(const List& list)
+    {
+      for (size_t i = 0; i < list.size(); ++i)
+        if (list[i] != -1)
+          return false;
+      return true;
+    }
+
+    /**
+     * @return True if the list has neither gaps nor unresolved states.
+     */
+    template<class List>
+    static bool isComplete(const List& list)
+    {
+      const Alphabet* alphabet = list.getAlphabet();
+      for (size_t i = 0; i < list.size(); ++i)
+        if (list[i] == -1 || alphabet->isUnresolved(list[i]))
+          return false;
+      return true;
+    }
+
+    /**
+     * @return True if all states of the list are identical.
+     *
+     * @param list          The list.
+     * @param ignoreUnknown If true, gaps and unknown states are not considered.
+     * @throw Exception If the list is empty, or only has gaps and unknown states when they are ignored.
+     */
+    template<class List>
+    static bool isConstant(const List& list, bool ignoreUnknown = false)
+    {
+      int unknown = list.getAlphabet()->getUnknownCharacterCode();
+      size_t i = 0;
+      if (ignoreUnknown)
+        while (i < list.size() && (list[i] == -1 || list[i] == unknown))
+          ++i;
+      if (i == list.size())
+        throw Exception("ViewTools::isConstant. Empty list.");
+      int first = list[i];
+      for ( ; i < list.size(); ++i)
+      {
+        int state = list[i];
+        if (state != first && !(ignoreUnknown && (state == -1 || state == unknown)))
+          return false;
+      }
+      return true;
+    }
+
+  private:
+    template<class List1, class List2>
+    static void checkSizes_(const List1& l1, const List2& l2, const char* method)
+    {
+      if (l1.size() != l2.size())
+        throw BadSizeException(std::string(method) + ". Lists must have the same size.", l2.size(), l1.size());
+    }
+  };
+
+} //end of namespace bpp.
+
+#endif //_VIEWTOOLS_H_
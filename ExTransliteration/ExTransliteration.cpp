@@ -0,0 +1,214 @@
+/*
+ * File: ExTransliteration.cpp
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 16:05 2026
+ *
+ * Fast transliteration of whole sequences with lookup tables.
+ *
+ * HOW TO USE THAT FILE:
+ * - General comments are written using the * * syntax.
+ * - Code lines are switched off using '//'. To activate those lines, just remove the '//' characters!
+ * - You're welcome to extensively modify that file!
+ */
+
+/*----------------------------------------------------------------------------------------------------*/
+
+/*
+ * We start by including what we'll need, and sort the inclusions a bit:
+ */
+
+/*
+ * From the STL:
+ */
+#include <iostream> /* to be able to output stuff in the terminal. */
+#include <chrono> /* for timings below the second. */
+#include <random> /* to simulate reads. */
+#include <algorithm>
+#include <vector>
+
+/*
+ * We'll use the standard template library namespace:
+ */
+using namespace std;
+
+/*
+ * From bpp-seq:
+ */
+#include <Bpp/Seq/Alphabet/AlphabetTools.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/SequenceTools.h>
+#include <Bpp/Seq/DNAToRNA.h>
+#include <Bpp/Seq/NucleicAcidsReplication.h>
+
+/*
+ * We'll need a few tools from the Bio++ core library:
+ */
+#include <Bpp/App/ApplicationTools.h>
+
+/*
+ * And the lookup tables, in this directory:
+ */
+#include "TransliterationTable.h"
+
+/*
+ * All Bio++ functions are also in a namespace, so we'll use it:
+ */
+using namespace bpp;
+
+/*----------------------------------------------------------------------------------------------------*/
+/*
+ * Now starts the real stuff...
+ */
+
+
+int main(int args, char ** argv)
+{
+  /*
+   * We surround our code with a try-catch block, in case some error occurs:
+   */
+  try
+  {
+    /*
+     * In ExSequence, we used transliterators on a small sequence:
+     */
+    BasicSequence sequence("My first sequence", "GATTACAATGATTACATGGT", &AlphabetTools::DNA_ALPHABET);
+    DNAToRNA dna2rna;
+    Sequence* trSequence = dna2rna.translate(sequence);
+    cout << "Original  : " << sequence.toString() << endl;
+    cout << "Translated: " << trSequence->toString() << endl;
+
+    /*
+     * Each position is translated through a virtual call to the transliterator.
+     * A TransliterationTable calls the transliterator only once for each state, and stores the results:
+     */
+    TransliterationTable dna2rnaTable(dna2rna);
+    Sequence* fastSequence = dna2rnaTable.translate(sequence);
+    cout << "Table     : " << fastSequence->toString() << " (" << dna2rnaTable.getNumberOfStates() << " states, vectorized: "
+         << (dna2rnaTable.isVectorized() ? "yes" : "no") << ")" << endl;
+    delete fastSequence;
+
+    /*
+     * Any simple transliterator can be compiled, for instance the complement:
+     */
+    NucleicAcidsReplication replication(&AlphabetTools::DNA_ALPHABET, &AlphabetTools::DNA_ALPHABET);
+    TransliterationTable complement(replication);
+    fastSequence = complement.translate(sequence);
+    cout << "Complement: " << fastSequence->toString() << endl;
+    delete fastSequence;
+
+    /*
+     * The translation can be combined with a reversal of the sequence.
+     * SequenceTools::reverseTranscript only complements the states, from RNA to DNA,
+     * so that the reverse complement takes a second call to SequenceTools::invert:
+     */
+    Sequence* complementSequence = SequenceTools::reverseTranscript(*trSequence);
+    Sequence* reverseSequence = SequenceTools::invert(*complementSequence);
+    delete complementSequence;
+    cout << "RevSeq    : " << reverseSequence->toString() << endl;
+    NucleicAcidsReplication rna2dna(&AlphabetTools::RNA_ALPHABET, &AlphabetTools::DNA_ALPHABET);
+    TransliterationTable reverseTranscription(rna2dna);
+    fastSequence = reverseTranscription.translateAndReverse(*trSequence);
+    cout << "Table     : " << fastSequence->toString() << endl;
+    delete fastSequence;
+    delete reverseSequence;
+    delete trSequence;
+
+    /*
+     * The real gain comes when many sequences are processed. The methods working on vectors of states
+     * translate in place, or into a buffer which is only allocated once.
+     * We simulate a set of short reads, and compute their reverse complement:
+     */
+    unsigned int nreads = 100000; /* WATCHOUT!!! reduce this number if this is too slow on your computer! */
+    size_t readLength = 150;
+    mt19937 rng(42);
+    uniform_int_distribution<int> nucleotide(0, 3);
+    vector<Sequence*> reads(nreads);
+    for (size_t i = 0; i < nreads; i++)
+    {
+      vector<int> content(readLength);
+      for (size_t j = 0; j < readLength; j++)
+        content[j] = nucleotide(rng);
+      reads[i] = new BasicSequence("Read" + TextTools::toString(i), content, &AlphabetTools::RNA_ALPHABET);
+    }
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector< vector<int> > reference(nreads);
+    for (size_t i = 0; i < nreads; i++)
+    {
+      Sequence* complementRead = SequenceTools::reverseTranscript(*reads[i]);
+      Sequence* rc = SequenceTools::invert(*complementRead);
+      reference[i] = rc->getContent();
+      delete rc;
+      delete complementRead;
+    }
+    double referenceTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ApplicationTools::displayResult("SequenceTools::reverseTranscript + invert", TextTools::toString(referenceTime * 1000., 4) + " ms");
+
+    /*
+     * Here all reads are written into a single preallocated buffer:
+     */
+    vector<int> buffer(nreads * readLength);
+    for (int level = SIMD_SCALAR; level <= SimdSupport::getBestLevel(); level++)
+    {
+      start = chrono::steady_clock::now();
+      for (size_t i = 0; i < nreads; i++)
+        reverseTranscription.translateAndReverse(&reads[i]->getContent()[0], readLength, &buffer[i * readLength], static_cast<SimdLevel>(level));
+      double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      bool identical = true;
+      for (size_t i = 0; i < nreads; i++)
+        identical = identical && equal(reference[i].begin(), reference[i].end(), buffer.begin() + static_cast<ptrdiff_t>(i * readLength));
+      ApplicationTools::displayResult("TransliterationTable::translateAndReverse (" + SimdSupport::getName(static_cast<SimdLevel>(level)) + ")",
+          TextTools::toString(t * 1000., 4) + " ms, speedup x" + TextTools::toString(referenceTime / t, 3) + ", same result: " + (identical ? "yes" : "no"));
+    }
+    for (size_t i = 0; i < nreads; i++)
+      delete reads[i];
+
+    /*
+     * On a whole chromosome, the states can be translated in place, without any allocation:
+     */
+    vector<int> chromosome(10000000); /* WATCHOUT!!! this takes 40 MB. */
+    for (size_t j = 0; j < chromosome.size(); j++)
+      chromosome[j] = nucleotide(rng);
+    vector<int> copy = chromosome;
+    Transliterator* transliterator = &replication;
+    start = chrono::steady_clock::now();
+    for (size_t j = 0; j < copy.size(); j++)
+      copy[j] = transliterator->translate(copy[j]);
+    double virtualTime = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    ApplicationTools::displayResult("Transliterator::translate, 10 Mb", TextTools::toString(virtualTime * 1000., 4) + " ms");
+    for (int level = SIMD_SCALAR; level <= SimdSupport::getBestLevel(); level++)
+    {
+      vector<int> inPlace = chromosome;
+      start = chrono::steady_clock::now();
+      complement.translate(inPlace, static_cast<SimdLevel>(level));
+      double t = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      ApplicationTools::displayResult("TransliterationTable::translate (" + SimdSupport::getName(static_cast<SimdLevel>(level)) + ")",
+          TextTools::toString(t * 1000., 4) + " ms, speedup x" + TextTools::toString(virtualTime / t, 3) + ", same result: " + (inPlace == copy ? "yes" : "no"));
+    }
+
+    /*
+     * Unsupported states are reported as with the transliterator:
+     */
+    vector<int> wrong(100, 0);
+    wrong[42] = 20;
+    try {
+      complement.translate(wrong);
+    } catch (Exception& ex) {
+      cout << "As expected: " << ex.what() << endl;
+    }
+  }
+  catch (Exception& e)
+  {
+    cout << "Bio++ exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+  catch (exception& e)
+  {
+    cout << "Any other exception:" << endl;
+    cout << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,378 @@
+/*
+ * File: TransliterationTable.h
+ * Created by: Bio++ Development Team
+ * Created on: Oct Fri 16 16:05 2026
+ *
+ * Transliterators compiled into lookup tables, applied with SIMD shuffles.
+ */
+
+#ifndef _TRANSLITERATIONTABLE_H_
+#define _TRANSLITERATIONTABLE_H_
+
+#include "SimdSupport.h" /* from ExAlignment */
+
+#include <Bpp/Exceptions.h>
+#include <Bpp/Seq/Sequence.h>
+#include <Bpp/Seq/Transliterator.h>
+#include <Bpp/Seq/Alphabet/AlphabetExceptions.h>
+
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+namespace bpp
+{
+  /**
+   * @brief A state-to-state Transliterator, compiled into a lookup table.
+   *
+   * The transliterator is called once for each state of its source alphabet (including the gap),
+   * and the results are stored in a table indexed by state + 1. Whole buffers of states are then
+   * translated without any virtual call, in place or into a preallocated buffer.
+   *
+   * When there are at most 16 source states, which is the case of the nucleic alphabets,
+   * the table fits in a single vector register, and is applied with byte shuffles (SSE4.1)
+   * or permutations (AVX2) on 16 or 8 states at a time.
+   *
+   * The translation can be fused with a reversal of the sequence: with a NucleicAcidsReplication,
+   * this computes the reverse complement in a single pass.
+   */
+  class TransliterationTable
+  {
+  private:
+    enum { INVALID = -128, MAX_SIMD_STATES = 16 };
+    const Alphabet* source_;
+    const Alphabet* target_;
+    std::vector<int> table_;
+    bool simd_;
+    int8_t bytes_[MAX_SIMD_STATES];
+    int32_t words_[MAX_SIMD_STATES];
+
+  public:
+    /**
+     * @param transliterator The transliterator to compile.
+     * @throw Exception If the transliterator has too many states, or returns states that do not fit in a byte.
+     */
+    explicit TransliterationTable(const Transliterator& transliterator) :
+      source_(transliterator.getSourceAlphabet()),
+      target_(transliterator.getTargetAlphabet()),
+      table_(),
+      simd_(false),
+      bytes_(),
+      words_()
+    {
+      for (int state = -1; state < 127 && source_->isIntInAlphabet(state); ++state)
+      {
+        int t = INVALID;
+        try
+        {
+          t = transliterator.translate(state);
+        }
+        catch (Exception&)
+        {
+          //State not supported by the transliterator: an exception will be thrown if it is met.
+        }
+        if (t != INVALID && (t < -127 || t > 127))
+          throw Exception("TransliterationTable. Only transliterators to small states can be compiled.");
+        table_.push_back(t);
+      }
+      if (table_.empty())
+        throw Exception("TransliterationTable. Source alphabet has no state.");
+      simd_ = (table_.size() <= MAX_SIMD_STATES);
+      for (size_t i = 0; i < MAX_SIMD_STATES; ++i)
+      {
+        int t = (i < table_.size() ? table_[i] : INVALID);
+        bytes_[i] = static_cast<int8_t>(t);
+        words_[i] = t;
+      }
+    }
+
+  public:
+    const Alphabet* getSourceAlphabet() const { return source_; }
+    const Alphabet* getTargetAlphabet() const { return target_; }
+
+    /**
+     * @return The number of source states in the table, including the gap.
+     */
+    size_t getNumberOfStates() const { return table_.size(); }
+
+    /**
+     * @return True if the table is applied with vector instructions.
+     */
+    bool isVectorized() const { return simd_; }
+
+    /**
+     * @brief Translate a single state.
+     *
+     * @throw BadIntException If the state is not supported.
+     */
+    int translate(int state) const
+    {
+      size_t i = static_cast<size_t>(static_cast<unsigned int>(state + 1));
+      if (i >= table_.size() || table_[i] == INVALID)
+        throw BadIntException(state, "TransliterationTable::translate. Unsupported state.", source_);
+      return table_[i];
+    }
+
+    /**
+     * @brief Translate a buffer of states.
+     *
+     * @param states The states to translate.
+     * @param n      The number of states.
+     * @param out    [out] The translated states. It may be the same buffer as states.
+     * @param level  The instruction set to use. The best available one is used by default.
+     * @throw BadIntException If a state is not supported. The output is then only partially filled.
+     */
+    void translate(const int* states, size_t n, int* out, SimdLevel level = SimdSupport::getBestLevel()) const
+    {
+      level = simd_ ? SimdSupport::getSupportedLevel(level) : SIMD_SCALAR;
+#ifdef BPP_SIMD_X86
+      if (level == SIMD_AVX2)
+        return translateAvx2_(states, n, out);
+      if (level == SIMD_SSE41)
+        return translateSse41_(states, n, out);
+#endif
+      translateScalar_(states, n, out);
+    }
+
+    /**
+     * @brief Translate a vector of states in place.
+     */
+    void translate(std::vector<int>& states, SimdLevel level = SimdSupport::getBestLevel()) const
+    {
+      translate(states.data(), states.size(), states.data(), level);
+    }
+
+    /**
+     * @brief Translate a vector of states into another one, which is resized if needed.
+     */
+    void translate(const std::vector<int>& states, std::vector<int>& out, SimdLevel level = SimdSupport::getBestLevel()) const
+    {
+      out.resize(states.size());
+      translate(states.data(), states.size(), out.data(), level);
+    }
+
+    /**
+     * @brief Translate a sequence, as Transliterator::translate does.
+     *
+     * @return A new sequence, with the target alphabet.
+     */
+    Sequence* translate(const Sequence& sequence) const
+    {
+      checkAlphabet_(sequence);
+      std::vector<int> content;
+      translate(sequence.getContent(), content);
+      return new BasicSequence(sequence.getName(), content, target_);
+    }
+
+    /**
+     * @brief Translate a buffer of states and reverse it, in a single pass: out[k] = translate(states[n - 1 - k]).
+     *
+     * @param states The states to translate.
+     * @param n      The number of states.
+     * @param out    [out] The translated states. It may be the same buffer as states.
+     * @param level  The instruction set to use. The best available one is used by default.
+     * @throw BadIntException If a state is not supported. The output is then only partially filled.
+     */
+    void translateAndReverse(const int* states, size_t n, int* out, SimdLevel level = SimdSupport::getBestLevel()) const
+    {
+      level = simd_ ? SimdSupport::getSupportedLevel(level) : SIMD_SCALAR;
+#ifdef BPP_SIMD_X86
+      if (level == SIMD_AVX2)
+        return translateAndReverseAvx2_(states, n, out);
+      if (level == SIMD_SSE41)
+        return translateAndReverseSse41_(states, n, out);
+#endif
+      translateAndReverseScalar_(states, 0, n, out);
+    }
+
+    /**
+     * @brief Translate and reverse a vector of states in place.
+     */
+    void translateAndReverse(std::vector<int>& states, SimdLevel level = SimdSupport::getBestLevel()) const
+    {
+      translateAndReverse(states.data(), states.size(), states.data(), level);
+    }
+
+    /**
+     * @brief Translate and reverse a vector of states into another one, which is resized if needed.
+     */
+    void translateAndReverse(const std::vector<int>& states, std::vector<int>& out, SimdLevel level = SimdSupport::getBestLevel()) const
+    {
+      out.resize(states.size());
+      translateAndReverse(states.data(), states.size(), out.data(), level);
+    }
+
+    /**
+     * @brief Translate and reverse a sequence.
+     *
+     * With a NucleicAcidsReplication from RNA to DNA, this gives the reverse complement: the same result
+     * as SequenceTools::invert applied to the output of SequenceTools::reverseTranscript, which only complements.
+     *
+     * @return A new sequence, with the target alphabet.
+     */
+    Sequence* translateAndReverse(const Sequence& sequence) const
+    {
+      checkAlphabet_(sequence);
+      std::vector<int> content;
+      translateAndReverse(sequence.getContent(), content);
+      return new BasicSequence(sequence.getName(), content, target_);
+    }
+
+  private:
+    void checkAlphabet_(const Sequence& sequence) const
+    {
+      if (sequence.getAlphabet()->getAlphabetType() != source_->getAlphabetType())
+        throw AlphabetMismatchException("TransliterationTable::translate", source_, sequence.getAlphabet());
+    }
+
+    void translateScalar_(const int* states, size_t n, int* out) const
+    {
+      for (size_t k = 0; k < n; ++k)
+        out[k] = translate(states[k]);
+    }
+
+    /*
+     * Translate and reverse the range [lo, hi) of a buffer of size n, from both ends at the same time,
+     * so that this also works in place.
+     */
+    void translateAndReverseScalar_(const int* states, size_t lo, size_t hi, int* out) const
+    {
+      while (lo < hi)
+      {
+        int first = states[lo];
+        int last = states[hi - 1];
+        out[lo++] = translate(last);
+        out[--hi] = translate(first);
+      }
+    }
+
+#ifdef BPP_SIMD_X86
+    /*
+     * Translate 16 states with byte shuffles. Returns false if a state is not supported.
+     */
+    BPP_TARGET_SSE41
+    bool lookupSse41_(const int* states, bool reverse, __m128i& r0, __m128i& r1, __m128i& r2, __m128i& r3) const
+    {
+      const __m128i one = _mm_set1_epi32(1);
+      __m128i v0 = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(states)), one);
+      __m128i v1 = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(states + 4)), one);
+      __m128i v2 = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(states + 8)), one);
+      __m128i v3 = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(states + 12)), one);
+      //Saturating packs keep out-of-range indices out of range:
+      __m128i idx = _mm_packs_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+      if (reverse)
+        idx = _mm_shuffle_epi8(idx, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+      __m128i outOfRange = _mm_andnot_si128(_mm_cmpeq_epi8(_mm_and_si128(idx, _mm_set1_epi8(static_cast<char>(0xF0))), _mm_setzero_si128()), _mm_set1_epi8(-1));
+      __m128i r = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes_)), idx);
+      __m128i invalid = _mm_or_si128(outOfRange, _mm_cmpeq_epi8(r, _mm_set1_epi8(static_cast<char>(INVALID))));
+      if (_mm_movemask_epi8(invalid) != 0)
+        return false;
+      r0 = _mm_cvtepi8_epi32(r);
+      r1 = _mm_cvtepi8_epi32(_mm_srli_si128(r, 4));
+      r2 = _mm_cvtepi8_epi32(_mm_srli_si128(r, 8));
+      r3 = _mm_cvtepi8_epi32(_mm_srli_si128(r, 12));
+      return true;
+    }
+
+    BPP_TARGET_SSE41
+    static void store16Sse41_(int* out, const __m128i& r0, const __m128i& r1, const __m128i& r2, const __m128i& r3)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out), r0);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), r1);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), r2);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), r3);
+    }
+
+    BPP_TARGET_SSE41
+    void translateSse41_(const int* states, size_t n, int* out) const
+    {
+      size_t k = 0;
+      __m128i r0, r1, r2, r3;
+      for ( ; k + 16 <= n; k += 16)
+      {
+        if (!lookupSse41_(states + k, false, r0, r1, r2, r3))
+        {
+          translateScalar_(states + k, 16, out + k); //Throws the appropriate exception.
+          continue;
+        }
+        store16Sse41_(out + k, r0, r1, r2, r3);
+      }
+      translateScalar_(states + k, n - k, out + k);
+    }
+
+    BPP_TARGET_SSE41
+    void translateAndReverseSse41_(const int* states, size_t n, int* out) const
+    {
+      size_t lo = 0, hi = n;
+      __m128i a0, a1, a2, a3, b0, b1, b2, b3;
+      for ( ; hi - lo >= 32; lo += 16, hi -= 16)
+      {
+        //Both blocks are read before they are written, so that this works in place:
+        if (!lookupSse41_(states + lo, true, a0, a1, a2, a3) || !lookupSse41_(states + hi - 16, true, b0, b1, b2, b3))
+        {
+          translateAndReverseScalar_(states, lo, hi, out); //Throws the appropriate exception.
+          return;
+        }
+        store16Sse41_(out + lo, b0, b1, b2, b3);
+        store16Sse41_(out + hi - 16, a0, a1, a2, a3);
+      }
+      translateAndReverseScalar_(states, lo, hi, out);
+    }
+
+    /*
+     * Translate 8 states with two permutations, one for each half of the table. Returns false if a state is not supported.
+     */
+    BPP_TARGET_AVX2
+    bool lookupAvx2_(const int* states, bool reverse, __m256i& r) const
+    {
+      __m256i idx = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(states)), _mm256_set1_epi32(1));
+      if (reverse)
+        idx = _mm256_permutevar8x32_epi32(idx, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+      __m256i low = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words_)), idx);
+      __m256i high = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words_ + 8)), idx);
+      r = _mm256_blendv_epi8(low, high, _mm256_cmpgt_epi32(idx, _mm256_set1_epi32(7)));
+      __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi32(idx, _mm256_set1_epi32(-1)), _mm256_cmpgt_epi32(_mm256_set1_epi32(MAX_SIMD_STATES), idx));
+      __m256i valid = _mm256_andnot_si256(_mm256_cmpeq_epi32(r, _mm256_set1_epi32(INVALID)), inRange);
+      return _mm256_movemask_epi8(valid) == -1;
+    }
+
+    BPP_TARGET_AVX2
+    void translateAvx2_(const int* states, size_t n, int* out) const
+    {
+      size_t k = 0;
+      __m256i r;
+      for ( ; k + 8 <= n; k += 8)
+      {
+        if (!lookupAvx2_(states + k, false, r))
+        {
+          translateScalar_(states + k, 8, out + k); //Throws the appropriate exception.
+          continue;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k), r);
+      }
+      translateScalar_(states + k, n - k, out + k);
+    }
+
+    BPP_TARGET_AVX2
+    void translateAndReverseAvx2_(const int* states, size_t n, int* out) const
+    {
+      size_t lo = 0, hi = n;
+      __m256i a, b;
+      for ( ; hi - lo >= 16; lo += 8, hi -= 8)
+      {
+        if (!lookupAvx2_(states + lo, true, a) || !lookupAvx2_(states + hi - 8, true, b))
+        {
+          translateAndReverseScalar_(states, lo, hi, out); //Throws the appropriate exception.
+          return;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + lo), b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + hi - 8), a);
+      }
+      translateAndReverseScalar_(states, lo, hi, out);
+    }
+#endif
+  };
+
+} //end of namespace bpp.
+
+#endif //_TRANSLITERATIONTABLE_H_